@@ -5,16 +5,39 @@
 #include "uiManager.hpp"
 #include "updateContext.hpp"
 #include "me.hpp"
+#include "visitor.hpp"
 
 class Object;
+class AttackManager;
+
+/**
+ * @brief Every attack controller class; one controller of each kind may exist per owner.
+ */
+enum class AttackKind
+{
+    BasicTile,
+    MeleePush,
+    Dash,
+    BambooBomb,
+    BambooBuff,
+    DragonClaw,
+    ArcaneOrb,
+    FanShot,
+    SeismicSlam,
+    GravityWell,
+    ChainLightning,
+    OrbitalShield,
+    Count
+};
 
 /**
  * @brief Abstract base for attack controllers that spawn and manage projectiles.
  *
  * Each AttackController is owned/managed by `AttackManager` and is bound to a
- * spawning `Entity` (stored in `spawnedBy`). Implement `update()` to advance
- * the controller and `getEntities()` to return any Entities (projectiles)
- * the controller manages.
+ * spawning `Entity` (stored in `spawnedBy`). Every subclass names its
+ * `attackKind`. Implement `update()` to advance the controller, override
+ * `visitEntities()` / `visitObjects()` to expose what it manages, and
+ * override `isIdle()` so the manager can stop updating it between uses.
  */
 class AttackController
 {
@@ -26,7 +49,28 @@ public:
     virtual ~AttackController() {} // ensure proper polymorphic destruction and allow vtable emission
     Entity *const spawnedBy;
     virtual void update(UpdateContext &uc) = 0;
-    virtual std::vector<Entity *> getEntities() = 0;
+    /**
+     * @brief Call `visit` with every live projectile Entity; controllers without any keep the no-op.
+     */
+    virtual void visitEntities(Visitor<Entity>) {}
+    /**
+     * @brief Call `visit` with every Object to draw; controllers without any keep the no-op.
+     */
+    virtual void visitObjects(Visitor<Object>) {}
+    /**
+     * @brief True when update() would change nothing until the controller is used again.
+     *
+     * Idle controllers are dropped from AttackManager's update list and
+     * return to it the next time they are fetched. Controllers that cannot
+     * tell keep the default and are updated every tick.
+     */
+    virtual bool isIdle() const { return false; }
+
+private:
+    friend class AttackManager;
+    AttackKind kind = AttackKind::Count;
+    EntityHandle ownerHandle; // Handle of `spawnedBy` when created; null for the player
+    bool scheduled = false;   // On AttackManager's update list
 };
 
 /**
@@ -38,7 +82,7 @@ public:
 class BambooBasicAttack : public AttackController
 {
 private:
-    std::vector<Projectile> projectiles;
+    ProjectileKindId projectileKind = NO_PROJECTILE_KIND; // Registered on the first shot
     float cooldownRemaining = 0.0f;
     float activeCooldownModifier = 1.0f; // 1.0 = normal, 0.4 = 40% of normal (faster shooting)
 
@@ -52,28 +96,17 @@ private:
     static constexpr float horizontalSpinSpeed = 450.0f; // How fast tile spins horizontally (tweakable)
     static constexpr float trailWidth = 0.3f;            // Width of wind trail (tweakable)
     static constexpr float trailLength = 2.0f;           // Length of trail behind tile (tweakable)
+    static constexpr float projectileLifetime = 5.0f;    // Far beyond any room; tiles normally hit a wall first
 
 public:
+    static constexpr AttackKind attackKind = AttackKind::BasicTile;
     BambooBasicAttack(Entity *_spawnedBy) : AttackController(_spawnedBy) {}
     bool canShoot() const { return this->cooldownRemaining <= 0.0f; }
     void setCooldownModifier(float modifier) { this->activeCooldownModifier = modifier; }
     void resetCooldownModifier() { this->activeCooldownModifier = 1.0f; }
     void update(UpdateContext &uc) override;
     void spawnProjectile(UpdateContext &uc);
-    std::vector<Object *> obj()
-    {
-        std::vector<Object *> ret;
-        for (auto &p : this->projectiles)
-            ret.push_back(&p.obj());
-        return ret;
-    }
-    std::vector<Entity *> getEntities() override
-    {
-        std::vector<Entity *> ret;
-        for (auto &p : this->projectiles)
-            ret.push_back(&p);
-        return ret;
-    }
+    bool isIdle() const override { return this->cooldownRemaining <= 0.0f; }
 };
 
 /**
@@ -82,11 +115,11 @@ public:
 class MeleePushAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::MeleePush;
     explicit MeleePushAttack(Entity *_spawnedBy) : AttackController(_spawnedBy) {}
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
-    std::vector<Object *> obj() const;
+    void visitObjects(Visitor<Object> visit) override;
 
     void trigger(UpdateContext &uc);
     float getCooldownPercent() const;
@@ -138,6 +171,7 @@ private:
     static constexpr float indicatorEndOpacity = 0.5f;
 
     std::vector<EffectVolume> effectVolumes;
+    std::vector<Enemy *> targets; // Enemy query results, reused every call
 
     Vector3 getForwardVector() const;
     struct ViewBasis
@@ -165,12 +199,13 @@ private:
 class DashAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::Dash;
     explicit DashAttack(Entity *_spawnedBy) : AttackController(_spawnedBy) {}
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
     void trigger(UpdateContext &uc);
     float getCooldownPercent() const;
+    bool isIdle() const override { return this->cooldownRemaining <= 0.0f && this->activeRemaining <= 0.0f; }
 
 private:
     float cooldownRemaining = 0.0f;
@@ -199,13 +234,14 @@ private:
 class BambooBasicBuffAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::BambooBuff;
     explicit BambooBasicBuffAttack(Entity *_spawnedBy) : AttackController(_spawnedBy) {}
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
     void trigger(UpdateContext &uc);
     float getCooldownPercent() const;
     bool isActive() const { return this->effectRemaining > 0.0f; }
+    bool isIdle() const override { return this->cooldownRemaining <= 0.0f && this->effectRemaining <= 0.0f; }
     float getReducedCooldown() const;
 
 private:
@@ -224,12 +260,13 @@ private:
 class BambooBombAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::BambooBomb;
     explicit BambooBombAttack(Entity *_spawnedBy);
     ~BambooBombAttack() override;
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override;
-    std::vector<Object *> obj();
+    void visitEntities(Visitor<Entity> visit) override;
+    void visitObjects(Visitor<Object> visit) override;
     bool trigger(UpdateContext &uc, TileType tile);
     float getCooldownPercent() const;
 
@@ -249,6 +286,7 @@ private:
     };
 
     std::vector<Bomb> bombs;
+    std::vector<Enemy *> targets; // Enemy query results, reused every call
 
     static constexpr float projectileSpeed = 50.0f;
     static constexpr float projectileLift = 6.0f;
@@ -293,16 +331,16 @@ private:
 class FanShotAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::FanShot;
     explicit FanShotAttack(Entity *_spawnedBy) : AttackController(_spawnedBy) {}
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override;
-    std::vector<Object *> obj();
     bool trigger(UpdateContext &uc);
     float getCooldownPercent() const;
+    bool isIdle() const override { return this->cooldownRemaining <= 0.0f && !this->recoilActive; }
 
 private:
-    std::vector<Projectile> projectiles;
+    ProjectileKindId projectileKind = NO_PROJECTILE_KIND; // Registered on the first trigger
     float cooldownRemaining = 0.0f;
 
     // Camera recoil state
@@ -315,6 +353,7 @@ private:
     static constexpr float projectileSpeed = 65.0f; // Fast shotgun pellets
     static constexpr float projectileDamage = 8.0f; // Lower damage per pellet
     static constexpr float projectileSize = 0.022f; // Slightly smaller than normal
+    static constexpr float projectileLifetime = 5.0f;
     static constexpr float muzzleHeight = 1.6f;
     static constexpr float cooldownDuration = 8.0f;    // Longer cooldown for shotgun
     static constexpr float recoilPitchKick = 0.3f;     // Camera pitch recoil
@@ -355,6 +394,7 @@ private:
     };
 
     std::vector<SlashEffect> activeSlashes;
+    std::vector<Enemy *> targets; // Enemy query results, reused every call
     std::vector<Object> debugArcPoints;
     std::array<ArcCurve, 3> arcCurves;
     std::array<ArcCurve, 3> defaultArcCurves;
@@ -407,11 +447,11 @@ private:
     static int tweakSelectedCombo;
 
 public:
+    static constexpr AttackKind attackKind = AttackKind::DragonClaw;
     DragonClawAttack(Entity *_spawnedBy);
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
-    std::vector<Object *> obj();
+    void visitObjects(Visitor<Object> visit) override;
     void spawnSlash(UpdateContext &uc);
     bool canAttack() const { return cooldownRemaining <= 0.0f; }
     float getCooldownPercent() const { return cooldownRemaining / attackCooldown; }
@@ -456,63 +496,47 @@ public:
 class ArcaneOrbAttack : public AttackController
 {
 private:
-    struct OrbProjectile
-    {
-        Vector3 position;
-        Vector3 lastDirection; // Direction from previous frame
-        Vector3 targetPos;
-        Entity *targetEnemy = nullptr;
-        float lifetime = 0.0f;
-        float sineWavePhase = 0.0f;
-        Object orbObj;
-        bool active = true;
-
-        static constexpr float maxLifetime = 8.0f;
-        static constexpr float baseSpeed = 10.0f;        // Base movement speed (tweakable)
-        static constexpr float sineWaveAmplitude = 1.5f; // Vertical sine motion amplitude
-        static constexpr float sineWaveFrequency = 2.0f; // Speed of sine wave oscillation
-        static constexpr float trackingBlend = 0.25f;    // 0.0 = pure last direction, 1.0 = pure target tracking
-        static constexpr float damage = 12.0f;
-        static constexpr float orbRadius = 0.4f;
-        static constexpr float searchRadius = 35.0f; // Max distance to search for enemies
-    };
-
-    std::vector<OrbProjectile> activeOrbs;
+    ProjectileKindId orbKind = NO_PROJECTILE_KIND; // Registered on the first shot
     float cooldownRemaining = 0.0f;
 
+    static constexpr float maxLifetime = 8.0f;
+    static constexpr float baseSpeed = 10.0f;        // Base movement speed (tweakable)
+    static constexpr float sineWaveAmplitude = 1.5f; // Peak vertical sine speed
+    static constexpr float sineWaveFrequency = 2.0f; // Speed of sine wave oscillation
+    static constexpr float trackingBlend = 0.25f;    // 0.0 = pure last direction, 1.0 = pure target tracking
+    static constexpr float damage = 12.0f;
+    static constexpr float knockbackSpeed = 15.0f;
+    static constexpr float knockbackDuration = 0.2f;
+    static constexpr float searchRadius = 35.0f; // Max distance to search for enemies
+
     // Tweakable animation parameters
-    static constexpr float orbSize = 0.5f;          // Size of the orb visual
-    static constexpr float orbSpinSpeed = 3.0f;     // How fast the orb rotates on itself
+    static constexpr float orbSize = 0.5f;          // Radius of the orb
     static constexpr float muzzleHeight = 1.6f;     // Height to spawn orb from
     static constexpr float cooldownDuration = 2.0f; // Time between shots
 
 public:
+    static constexpr AttackKind attackKind = AttackKind::ArcaneOrb;
     ArcaneOrbAttack(Entity *_spawnedBy) : AttackController(_spawnedBy) {}
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
-    std::vector<Object *> obj();
     void spawnOrb(UpdateContext &uc);
     bool canShoot() const { return cooldownRemaining <= 0.0f; }
     float getCooldownPercent() const { return cooldownRemaining / cooldownDuration; }
-
-private:
-    Entity *findNearestEnemy(UpdateContext &uc, const Vector3 &position, float searchRadius) const;
-    void updateOrbMovement(OrbProjectile &orb, UpdateContext &uc, float deltaSeconds);
-    void checkOrbHits(OrbProjectile &orb, UpdateContext &uc);
+    bool isIdle() const override { return this->cooldownRemaining <= 0.0f; }
 };
 
 /** @brief Gravity Well - stationary singularity that pulls and suppresses enemies. */
 class GravityWellAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::GravityWell;
     explicit GravityWellAttack(Entity *_spawnedBy) : AttackController(_spawnedBy) {}
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
-    std::vector<Object *> obj();
+    void visitObjects(Visitor<Object> visit) override;
     bool trigger(UpdateContext &uc);
     float getCooldownPercent() const;
+    bool isIdle() const override { return this->cooldownRemaining <= 0.0f && !this->seedInFlight && !this->activeWell.active; }
 
 private:
     struct WellField
@@ -529,19 +553,11 @@ private:
         bool collapsing = false;
     };
 
-    struct WellProjectile
-    {
-        bool active = false;
-        Vector3 position{0.0f, 0.0f, 0.0f};
-        Vector3 velocity{0.0f, 0.0f, 0.0f};
-        Vector3 wiggleAxis{1.0f, 0.0f, 0.0f};
-        float sinePhase = 0.0f;
-        Object visual;
-    };
-
     WellField activeWell{};
-    WellProjectile projectile{};
+    ProjectileKindId seedKind = NO_PROJECTILE_KIND; // Registered on the first trigger
+    bool seedInFlight = false;
     float cooldownRemaining = 0.0f;
+    std::vector<Enemy *> targets; // Enemy query results, reused every call
 
     static constexpr float cooldownDuration = 20.0f;
     static constexpr float flightSpeed = 18.0f;
@@ -550,6 +566,7 @@ private:
     static constexpr float flightSineAmplitude = 1.2f;
     static constexpr float flightSineFrequency = 3.2f;
     static constexpr float projectileRadius = 0.6f;
+    static constexpr float projectileLifetime = 30.0f; // Safety net; the seed lands long before
     static constexpr float openingDuration = 0.45f;
     static constexpr float collapseDuration = 0.35f;
     static constexpr float wellDuration = 10.0f;
@@ -560,17 +577,20 @@ private:
     static constexpr float suppressStunDuration = 0.2f;
     static constexpr float horizonHeight = 0.35f;
     static constexpr float coreRadius = 2.2f;
+
+    static void OnSeedGone(void *user, const ProjectileImpact &impact, UpdateContext &uc);
+    void openWell(const Vector3 &center, UpdateContext &uc);
 };
 
 /** @brief Chain Lightning - instant hitscan that jumps across nearby enemies. */
 class ChainLightningAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::ChainLightning;
     explicit ChainLightningAttack(Entity *_spawnedBy) : AttackController(_spawnedBy) {}
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
-    std::vector<Object *> obj();
+    void visitObjects(Visitor<Object> visit) override;
     bool trigger(UpdateContext &uc);
     float getCooldownPercent() const;
 
@@ -585,11 +605,14 @@ private:
     };
 
     std::vector<Bolt> activeBolts;
+    std::vector<Enemy *> targets; // Enemy query results, reused every call
     float cooldownRemaining = 0.0f;
 
     static constexpr float cooldownDuration = 10.0f;
     static constexpr float maxRange = 32.0f;
     static constexpr float chainRadius = 25.0f;
+    static constexpr float aimRadius = 2.2f; // Max distance of the primary target from the view ray
+    static constexpr size_t maxSecondaryTargets = 3;
     static constexpr float boltLifetime = 0.28f;
     static constexpr int minSegments = 6;
     static constexpr int maxSegments = 18;
@@ -600,8 +623,8 @@ private:
     static constexpr float secondaryDamage = 18.0f;
     static constexpr float stunDuration = 1.5f;
 
-    Entity *findPrimaryTarget(UpdateContext &uc, Vector3 camPos, Vector3 camForward) const;
-    std::vector<Entity *> findSecondaryTargets(UpdateContext &uc, Entity *primary) const;
+    Entity *findPrimaryTarget(UpdateContext &uc, Vector3 camPos, Vector3 camForward);
+    const std::vector<Enemy *> &findSecondaryTargets(UpdateContext &uc, Entity *primary);
     void applyDamageAndStun(Entity *target, float damage, UpdateContext &uc);
     void rebuildBoltGeometry(Bolt &bolt);
 };
@@ -610,12 +633,12 @@ private:
 class OrbitalShieldAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::OrbitalShield;
     explicit OrbitalShieldAttack(Entity *_spawnedBy);
     ~OrbitalShieldAttack();
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
-    std::vector<Object *> obj();
+    void visitObjects(Visitor<Object> visit) override;
     bool trigger(UpdateContext &uc);
     float getCooldownPercent() const;
 
@@ -631,6 +654,7 @@ private:
     };
 
     std::vector<Orb> orbs;
+    std::vector<Enemy *> targets; // Enemy query results, reused every call
     float baseAngle = 0.0f;
     float cooldownRemaining = 0.0f;
 
@@ -657,11 +681,11 @@ bool TryConsumeOrbitalShield(Me *player, DamageResult &dResult);
 class SeismicSlamAttack : public AttackController
 {
 public:
+    static constexpr AttackKind attackKind = AttackKind::SeismicSlam;
     explicit SeismicSlamAttack(Entity *_spawnedBy);
 
     void update(UpdateContext &uc) override;
-    std::vector<Entity *> getEntities() override { return {}; }
-    std::vector<Object *> obj();
+    void visitObjects(Visitor<Object> visit) override;
     bool trigger(UpdateContext &uc);
     float getCooldownPercent() const;
 
@@ -704,6 +728,7 @@ private:
     bool shockwaveActive = false;
     float shockwaveTimer = 0.0f;
     std::vector<Object> debugArcPoints;
+    std::vector<Enemy *> targets; // Enemy query results, reused every call
 
     ArcCurve arcCurve;
     ArcCurve defaultArcCurve;
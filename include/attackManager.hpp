@@ -1,7 +1,11 @@
 #pragma once
 #include "attack.hpp"
+#include <array>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 #include "object.hpp"
+#include "tileCombo.hpp"
 #include "uiManager.hpp"
 #include "updateContext.hpp"
 
@@ -10,53 +14,89 @@
  *
  * AttackManager owns per-spawner `ThousandTileAttack` instances and records
  * recent thrown tiles to detect combo activations (thousand/triplet).
+ *
+ * Controllers live in one registry keyed by owner, holding one slot per
+ * AttackKind, so fetching a controller is a hash lookup plus an index. Only
+ * controllers that were fetched since they last went idle sit on the
+ * contiguous `active` list that update() walks; idle ones cost nothing per
+ * tick. Controllers of enemies are keyed by the enemy's handle as well and
+ * are released once that handle stops resolving.
  */
 class AttackManager
 {
 private:
-    enum class SlotAttackKind
+    // Classification of one slot, redone only when UIManager bumps the slot's revision
+    struct SlotComboCache
     {
-        None,
-        DefaultThrow,
-        DotBomb,
-        Melee,
-        Dash,
-        BambooTriple,
-        FanShot,
-        SeismicSlam,
-        GravityWell,
-        ChainLightning,
-        OrbitalShield
+        unsigned int revision = 0;
+        bool known = false;
+        TileCombo combo = TileCombo::None;
     };
+
     //std::vector<ThousandAttack *> thousandAttack; // List of ThousandAttack instances
     //std::vector<TripletAttack *> tripletAttack;
-    std::vector<BambooBasicAttack *> basicTileAttacks;
-    std::vector<MeleePushAttack *> meleeAttacks;
-    std::vector<DashAttack *> dashAttacks;
-    std::vector<BambooBombAttack *> bambooBombAttacks;
-    std::vector<BambooBasicBuffAttack *> bambooTripleAttacks;
-    std::vector<DragonClawAttack *> dragonClawAttacks;
-    std::vector<ArcaneOrbAttack *> arcaneOrbAttacks;
-    std::vector<FanShotAttack *> fanShotAttacks;
-    std::vector<SeismicSlamAttack *> seismicSlamAttacks;
-    std::vector<GravityWellAttack *> gravityWellAttacks;
-    std::vector<ChainLightningAttack *> chainLightningAttacks;
-    std::vector<OrbitalShieldAttack *> orbitalShieldAttacks;
+
+    // Owner pointer plus its handle, so a pooled enemy reusing the pointer gets fresh controllers
+    struct OwnerKey
+    {
+        const Entity *owner;
+        EntityHandle handle;
+
+        bool operator==(const OwnerKey &other) const { return this->owner == other.owner && this->handle == other.handle; }
+    };
+    struct OwnerKeyHash
+    {
+        size_t operator()(const OwnerKey &key) const
+        {
+            return std::hash<const Entity *>()(key.owner) ^ (std::hash<unsigned int>()(key.handle.generation) << 1);
+        }
+    };
+    using ControllerSlots = std::array<AttackController *, (size_t)AttackKind::Count>;
+
+    std::unordered_map<OwnerKey, ControllerSlots, OwnerKeyHash> controllers;
+    std::vector<AttackController *> active; // Controllers updated each tick, in the order they woke
+    int sweepCounter = 0;
+    static constexpr int sweepInterval = 60; // Ticks between scans of idle controllers for dead owners
     std::vector<std::pair<TileType, Rectangle>> thrownTiles; // History of thrown tiles and their texture rects
     AttackController *attackLockOwner = nullptr;
 
-    SlotAttackKind classifySlotAttack(const std::vector<SlotTileEntry> &slotEntries) const;
+    std::array<SlotComboCache, UIManager::slotCount> slotCombos{};
+
+    TileCombo slotCombo(int slotIndex, const UIManager &ui);
     float computeSlotCooldownPercent(int slotIndex, UpdateContext &uc);
 
-public:
     /**
-     * @brief Classify attack type from tile combination and return as string.
-     * @param tiles Vector of tiles in the slot (order-independent for sequences).
-     * @return String name of attack type, or "NA" if no valid attack.
+     * @brief Return the `T` controller of `spawnedBy`, creating it on first use, without scheduling it.
      */
-    static std::string classifyAttackType(const std::vector<SlotTileEntry> &tiles);
+    template <typename T>
+    T *findOrCreate(Entity *spawnedBy)
+    {
+        EntityHandle handle = spawnedBy ? spawnedBy->getHandle() : EntityHandle{};
+        ControllerSlots &slots = this->controllers.try_emplace(OwnerKey{spawnedBy, handle}).first->second;
+        AttackController *&slot = slots[(size_t)T::attackKind];
+        if (!slot)
+        {
+            slot = new T(spawnedBy);
+            slot->kind = T::attackKind;
+            slot->ownerHandle = handle;
+        }
+        return static_cast<T *>(slot);
+    }
 
-private:
+    /**
+     * @brief Return the `T` controller of `spawnedBy` and put it on the update list.
+     */
+    template <typename T>
+    T *getAttack(Entity *spawnedBy)
+    {
+        T *attack = this->findOrCreate<T>(spawnedBy);
+        this->schedule(attack);
+        return attack;
+    }
+
+    void schedule(AttackController *controller);
+    void releaseDeadOwners(UpdateContext &uc);
+    void releaseOwner(const OwnerKey &key);
 
 public:
     ~AttackManager(); // Destructor to clean up dynamically allocated attacks
@@ -68,34 +108,45 @@ public:
 
     /**
      * @brief Retrieve or create a `BambooBasicAttack` bound to `spawnedBy`.
+     *
+     * Like every getter below, this also schedules the controller for
+     * update() until it reports idle again.
      */
-    BambooBasicAttack *getBasicTileAttack(Entity *spawnedBy);
+    BambooBasicAttack *getBasicTileAttack(Entity *spawnedBy) { return this->getAttack<BambooBasicAttack>(spawnedBy); }
 
     /**
      * @brief Retrieve or create a melee push attack controller for `spawnedBy`.
      */
-    MeleePushAttack *getMeleePushAttack(Entity *spawnedBy);
-    DashAttack *getDashAttack(Entity *spawnedBy);
-    BambooBombAttack *getBambooBombAttack(Entity *spawnedBy);
-    BambooBasicBuffAttack *getBambooTripleAttack(Entity *spawnedBy);
-    DragonClawAttack *getDragonClawAttack(Entity *spawnedBy);
-    ArcaneOrbAttack *getArcaneOrbAttack(Entity *spawnedBy);
-    FanShotAttack *getFanShotAttack(Entity *spawnedBy);
-    SeismicSlamAttack *getSeismicSlamAttack(Entity *spawnedBy);
-    GravityWellAttack *getGravityWellAttack(Entity *spawnedBy);
-    ChainLightningAttack *getChainLightningAttack(Entity *spawnedBy);
-    OrbitalShieldAttack *getOrbitalShieldAttack(Entity *spawnedBy);
+    MeleePushAttack *getMeleePushAttack(Entity *spawnedBy) { return this->getAttack<MeleePushAttack>(spawnedBy); }
+    DashAttack *getDashAttack(Entity *spawnedBy) { return this->getAttack<DashAttack>(spawnedBy); }
+    BambooBombAttack *getBambooBombAttack(Entity *spawnedBy) { return this->getAttack<BambooBombAttack>(spawnedBy); }
+    BambooBasicBuffAttack *getBambooTripleAttack(Entity *spawnedBy) { return this->getAttack<BambooBasicBuffAttack>(spawnedBy); }
+    DragonClawAttack *getDragonClawAttack(Entity *spawnedBy) { return this->getAttack<DragonClawAttack>(spawnedBy); }
+    ArcaneOrbAttack *getArcaneOrbAttack(Entity *spawnedBy) { return this->getAttack<ArcaneOrbAttack>(spawnedBy); }
+    FanShotAttack *getFanShotAttack(Entity *spawnedBy) { return this->getAttack<FanShotAttack>(spawnedBy); }
+    SeismicSlamAttack *getSeismicSlamAttack(Entity *spawnedBy) { return this->getAttack<SeismicSlamAttack>(spawnedBy); }
+    GravityWellAttack *getGravityWellAttack(Entity *spawnedBy) { return this->getAttack<GravityWellAttack>(spawnedBy); }
+    ChainLightningAttack *getChainLightningAttack(Entity *spawnedBy) { return this->getAttack<ChainLightningAttack>(spawnedBy); }
+    OrbitalShieldAttack *getOrbitalShieldAttack(Entity *spawnedBy) { return this->getAttack<OrbitalShieldAttack>(spawnedBy); }
     bool triggerSlotAttack(int slotIndex, UpdateContext &uc);
 
     /**
-     * @brief Get all entity pointers managed by attacks (projectiles).
+     * @brief Delete every controller bound to `owner`, e.g. right before the entity is destroyed.
+     *
+     * Controllers of enemies whose handle no longer resolves are released by
+     * update() on its own; this only makes it immediate.
+     */
+    void releaseAttacks(const Entity *owner);
+
+    /**
+     * @brief Call `visit` with every entity managed by attacks (projectiles).
      */
-    std::vector<Entity *> getEntities(EntityCategory cat = ENTITY_PROJECTILE);
+    void visitEntities(EntityCategory cat, Visitor<Entity> visit);
 
     /**
-     * @brief Get objects representing all projectiles/connectors for rendering/collision.
+     * @brief Call `visit` with the objects of all projectiles/connectors for rendering/collision.
      */
-    std::vector< Object *> getObjects() const;
+    void visitObjects(Visitor<Object> visit) const;
 
     bool isAttackLockedByOther(const AttackController *controller) const;
     bool tryLockAttack(AttackController *controller);
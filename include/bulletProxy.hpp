@@ -0,0 +1,113 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <btBulletCollisionCommon.h>
+#include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#include "object.hpp"
+
+class BulletProxyPool;
+
+/**
+ * @brief Persistent ghost object that mirrors one Object in the Bullet broadphase.
+ *
+ * Owned by the Object's BulletProxySlot and registered with a BulletProxyPool.
+ * When the Object dies the proxy is parked in its pool, shape and broadphase
+ * handle intact, and handed to the next Object that binds. The ghost caches the broadphase pairs it overlaps, so contact queries only
+ * run the narrowphase against decorations whose bounds it already touches
+ * instead of allocating a shape and traversing the world every call.
+ */
+class BulletProxy
+{
+public:
+    /**
+     * @brief Give up a proxy owned by a dying slot: park it in its pool, or delete it if detached.
+     */
+    static void Retire(BulletProxy *proxy);
+
+    /**
+     * @brief Whether the current shape and filter still match the Object.
+     */
+    bool MatchesShape(const Object &obj) const;
+
+    /**
+     * @brief Replace the collision shape (takes ownership) and take the Object's layer and mask.
+     */
+    void SetShape(btCollisionShape *shape, const Object &obj);
+
+    /**
+     * @brief Move the ghost, inserting it into the broadphase on first use.
+     */
+    void SetTransform(const btTransform &transform);
+
+    /**
+     * @brief Append penetrating contacts from the cached pairs to `out`.
+     *
+     * Normals point away from the decoration, matching
+     * Scene::AppendDecorationCollisions().
+     */
+    void AppendContacts(std::vector<CollisionResult> &out);
+
+private:
+    friend class BulletProxyPool;
+    explicit BulletProxy(BulletProxyPool *pool) : pool(pool) {}
+
+    BulletProxyPool *pool;
+    size_t poolIndex = 0;
+    bool inWorld = false;
+    btPairCachingGhostObject ghost;
+    std::unique_ptr<btCollisionShape> shape;
+    ObjectShape shapeKind = ObjectShape::Box;
+    Vector3 shapeSize = {0.0f, 0.0f, 0.0f};
+    int filterGroup = 0;
+    int filterMask = 0;
+    btManifoldArray manifolds;
+};
+
+/**
+ * @brief Tracks every BulletProxy attached to one collision world.
+ *
+ * Entity ghosts use their Object's collision layer as filter group and mask
+ * only the decoration layer, so they never pair with each other.
+ */
+class BulletProxyPool
+{
+public:
+    BulletProxyPool() = default;
+    BulletProxyPool(const BulletProxyPool &) = delete;
+    BulletProxyPool &operator=(const BulletProxyPool &) = delete;
+    ~BulletProxyPool();
+
+    /**
+     * @brief Bind to a world and install the ghost pair callback on its broadphase.
+     */
+    void Attach(btCollisionWorld *world);
+
+    /**
+     * @brief Pull every ghost out of the world; proxies outlive the pool harmlessly.
+     */
+    void Detach();
+
+    /**
+     * @brief Return the proxy of `obj` for this pool, creating it if needed.
+     *
+     * Parked proxies are reused first, preferring one whose shape already
+     * matches, so pooled enemies respawn without touching the heap.
+     * Returns nullptr when the pool is detached or the Object did not opt in.
+     */
+    BulletProxy *Bind(const Object &obj);
+
+    /**
+     * @brief Let the broadphase drop pairs that stopped overlapping. Call once per frame.
+     */
+    void PrunePairs();
+
+private:
+    friend class BulletProxy;
+    void Park(BulletProxy *proxy);
+    void SetHandleFilter(BulletProxy *proxy, int group, int mask);
+
+    btCollisionWorld *world = nullptr;
+    std::unique_ptr<btGhostPairCallback> ghostPairCallback;
+    std::vector<BulletProxy *> live;
+    std::vector<BulletProxy *> parked; // Owned by the pool; still in the world with an empty mask
+};
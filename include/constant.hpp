@@ -11,12 +11,18 @@
 // Increasing air drag, increases strafing speed
 #define AIR_DRAG 0.98f
 #define PROJECTILE_AIR_DRAG 0.99f
+// FRICTION and the drag factors above are per step at this rate
+#define PHYSICS_REFERENCE_HZ 60.0f
 // Responsiveness for turning movement direction to looked direction
 #define CONTROL 15.0f
 #define CROUCH_HEIGHT 0.0f
 #define STAND_HEIGHT 1.0f
 #define BOTTOM_HEIGHT 0.5f
 
+// Fixed simulation clock
+#define SIMULATION_HZ 120.0f
+#define MAX_SIMULATION_SUBSTEPS 8
+
 #define MAX_HEALTH_ME 300
 #define MAX_HEALTH_ENEMY 250
 
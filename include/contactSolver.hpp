@@ -0,0 +1,76 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <raylib.h>
+#include "entityRegistry.hpp"
+#include "obb.hpp"
+
+class Entity;
+class Enemy;
+class Scene;
+
+/**
+ * @brief Scene-wide overlap solver that runs once per simulation tick.
+ *
+ * Entities flag themselves through `Entity::ApplyPhysics()` instead of
+ * resolving their own overlaps. `Solve()` then gathers every penetrating
+ * contact in one pass (static geometry and projectiles per body, plus
+ * body-vs-body pairs from the enemy grid), groups bodies joined by contacts
+ * into islands and relaxes each island with a few projected Gauss-Seidel
+ * iterations. Both bodies of a pair move, so the result no longer depends
+ * on which of them updated first.
+ *
+ * The accumulated push of every contact is remembered for the next tick and
+ * used as its starting guess (warm starting), so resting stacks converge in
+ * the first iteration instead of re-solving from zero.
+ *
+ * Lookups use sorted vectors that keep their capacity between ticks, so a
+ * steady fight solves without heap allocations.
+ */
+class ContactSolver
+{
+public:
+    /**
+     * @brief Resolve overlaps of every flagged body in `player` and `enemies`.
+     */
+    void Solve(Scene &scene, Entity *player, const EntityView<Enemy> &enemies);
+
+private:
+    struct Contact
+    {
+        int a;            // body pushed along +normal
+        int b;            // body pushed along -normal; -1 when the other side is immovable
+        Vector3 normal;
+        float penetration;
+        float lambda;     // accumulated push along the normal
+        unsigned long long key;
+    };
+
+    struct WarmStart
+    {
+        unsigned long long key;
+        float lambda;
+    };
+
+    static constexpr int MAX_ITERATIONS = 4;
+    static constexpr float WARM_START_FACTOR = 0.8f;
+    static constexpr float LINEAR_SLOP = 0.001f;
+
+    std::vector<Entity *> bodies;
+    std::vector<Vector3> displacement;
+    std::vector<int> islandParent;
+    std::vector<Contact> contacts;
+    std::vector<int> contactOrder;
+    std::vector<int> contactIsland;
+    std::vector<std::pair<const Entity *, int>> bodyIndex; // Sorted by entity
+    std::vector<WarmStart> warmStart;                      // Sorted by key, one entry per key
+    std::vector<WarmStart> nextWarmStart;
+    std::vector<CollisionResult> staticHits;               // Scratch for one body's static query
+
+    void GatherContacts(Scene &scene, Entity *player);
+    int BodyIndexOf(const Entity *e) const;
+    void AddContact(int a, int b, Vector3 normal, float penetration, const Entity *other);
+    int FindIsland(int body);
+    void SolveContact(Contact &c, float *error);
+    void WriteBack();
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include <raylib.h>
+#include <cstddef>
+#include <vector>
 
 class DialogBox
 {
@@ -16,6 +18,14 @@ public:
     void setFillPercent(float percent);
     void setVisible(bool v) { this->visible = v; }
     bool Draw(const Camera &camera) const;
+    /**
+     * @brief Restore the default look and state, keeping the render texture.
+     */
+    void Reset();
+    /**
+     * @brief Create the render texture now instead of on the first Draw().
+     */
+    bool Prepare() const { return this->ensureTexture(); }
 
     void setBarSize(float width, float height)
     {
@@ -43,3 +53,30 @@ private:
 
     mutable RenderTexture2D barTexture{};
 };
+
+/**
+ * @brief Free list of DialogBoxes that keeps their render textures alive.
+ *
+ * Acquire() hands out a released box after Reset(), or a new one when none
+ * is free, so once the pool is warm a new health bar costs no heap or GPU
+ * allocation.
+ */
+class DialogBoxPool
+{
+public:
+    DialogBoxPool() = default;
+    ~DialogBoxPool();
+    DialogBoxPool(const DialogBoxPool &) = delete;
+    DialogBoxPool &operator=(const DialogBoxPool &) = delete;
+
+    DialogBox *Acquire();
+    void Release(DialogBox *box);
+    /**
+     * @brief Make sure at least `count` boxes, textures included, are free.
+     */
+    void Reserve(size_t count);
+
+private:
+    std::vector<DialogBox *> freeBoxes;
+    size_t liveCount = 0;
+};
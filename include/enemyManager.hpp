@@ -1,23 +1,182 @@
 #pragma once
 #include <vector>
+#include <array>
+#include <tuple>
 #include "updateContext.hpp"
 #include "me.hpp"
 #include "object.hpp"
+#include "spatialGrid.hpp"
+#include "kinematicsStore.hpp"
+#include "entityRegistry.hpp"
+#include "visitor.hpp"
+#include "objectPool.hpp"
+#include "dialogBox.hpp"
 class Enemy;
 class Object;
 struct DamageResult;
 class EnemyManager
 {
 private:
-    std::vector<Enemy *> enemies;
+    EntityRegistry<Enemy> enemies; // Owning; slots are addressed by EntityHandle
+    std::array<EntityRegistry<Enemy>, ENEMY_TYPE_COUNT> enemiesByType; // Same enemies, one list per EnemyType
+    SpatialGrid grid; // Broadphase over enemy OBBs, rebuilt once per update
+    int iterationDepth = 0; // Live EnemyRange count; removals are deferred while > 0
+    std::vector<Enemy *> thinking; // Scratch list for the think phase, reused every update
+    std::vector<Enemy *> binned; // Scratch list of awake enemies for the grid rebuild
+    KinematicsStore bodies; // Physics state of enemies with batched movement; dormant ones are integrated but ignored
+    std::vector<Enemy *> staged; // Enemies whose body waits in `bodies` for this type's Integrate()
+    bool stagingBodies = false; // Inside the apply phase, where StageBody() is accepted
+    std::tuple<ObjectPool<MinionEnemy>, ObjectPool<ChargingEnemy>, ObjectPool<ShooterEnemy>,
+               ObjectPool<SummonerEnemy>, ObjectPool<SupportEnemy>, ObjectPool<VanguardEnemy>>
+        enemyPools; // Storage of removed enemies, reused by createEnemy()
+    DialogBoxPool dialogPool; // Health bars of removed enemies, textures kept
+
+    void DeleteRemovedEnemies();
+    // Move `e`'s room binding when it has crossed into another room
+    void TrackRoom(Enemy *e, UpdateContext &uc);
+    // Bookkeeping after an enemy has moved this tick
+    void FinishUpdate(Enemy *e, UpdateContext &uc);
+    // Integrate the staged bodies and let their enemies finish their update
+    void FinishStagedBodies(UpdateContext &uc);
+    void DestroyEnemy(Enemy *e);
+    template <typename T>
+    void ReleaseToPool(Enemy *e) { std::get<ObjectPool<T>>(this->enemyPools).Release(static_cast<T *>(e)); }
+
 public:
+    /**
+     * @brief Range over the live enemies that keeps removal safe while it exists.
+     *
+     * Enemies removed while any range is alive are skipped but stay allocated
+     * until the outermost range ends; enemies added meanwhile are not visited.
+     */
+    class EnemyRange : public EntityView<Enemy>
+    {
+    public:
+        EnemyRange(EnemyManager &owner, const EntityRegistry<Enemy> &list);
+        ~EnemyRange();
+        EnemyRange(const EnemyRange &) = delete;
+        EnemyRange &operator=(const EnemyRange &) = delete;
+
+    private:
+        EnemyManager &owner;
+    };
+
     ~EnemyManager();
 
-    void addEnemy(Enemy *e);
+    /**
+     * @brief Construct a `T` in pooled storage; hand it to addEnemy() next,
+     * or to Scene::events while enemies are updating.
+     *
+     * Every enemy must come from here, since removal returns it to the pool
+     * of its EnemyType.
+     */
+    template <typename T>
+    T *createEnemy() { return std::get<ObjectPool<T>>(this->enemyPools).Acquire(); }
+    /**
+     * @brief Warm the pool so `count` enemies of type `T` can spawn without allocating.
+     *
+     * Room is made in the KinematicsStore too, in case `T` batches its movement.
+     */
+    template <typename T>
+    void reserveEnemies(size_t count)
+    {
+        std::get<ObjectPool<T>>(this->enemyPools).Reserve(count);
+        this->bodies.Reserve(this->bodies.size() + count);
+    }
+    DialogBox *acquireHealthDialog() { return this->dialogPool.Acquire(); }
+    /**
+     * @brief Create `count` spare health dialogs (and their GPU textures) up front.
+     */
+    void reserveHealthDialogs(size_t count) { this->dialogPool.Reserve(count); }
+
+    /**
+     * @brief Take ownership of `e` and give it a handle.
+     */
+    EntityHandle addEnemy(Enemy *e);
     void RemoveEnemy(Enemy *e);
+    /**
+     * @brief Remove and delete the enemy named by `handle`; stale handles are ignored.
+     */
+    void RemoveEnemy(EntityHandle handle);
+    /**
+     * @brief The live enemy named by `handle`, or nullptr once it has been removed.
+     */
+    Enemy *Get(EntityHandle handle) const { return this->enemies.Get(handle); }
+    /**
+     * @brief Advance every enemy by one tick.
+     *
+     * First every enemy runs Think() on `uc.jobs` against the world as
+     * it was at the start of the tick, then UpdateBody() applies the
+     * resulting intents one enemy at a time on the calling thread.
+     */
     void update(UpdateContext &uc);
+    /**
+     * @brief Take over the physics step of `e` for this tick; see Enemy::FinishStagedMovement().
+     *
+     * Returns false outside update(), where the caller integrates the body itself.
+     */
+    bool StageBody(Enemy *e, const KinematicsStore::Body &body);
     void damage(Enemy *enemy, DamageResult &dResult, UpdateContext &uc);
-    std::vector<Object *> getObjects() const;
-    std::vector<Entity *> getEntities(EntityCategory cat = ENTITY_ENEMY) const;
+    /**
+     * @brief Iterate the live enemies; enemies may be damaged or removed meanwhile.
+     */
+    EnemyRange getEnemies() { return EnemyRange(*this, this->enemies); }
+    /**
+     * @brief Like getEnemies(), restricted to one EnemyType; no RTTI involved.
+     */
+    EnemyRange getEnemies(EnemyType type) { return EnemyRange(*this, this->enemiesByType[type]); }
+    /**
+     * @brief Read-only iteration for passes that never add or remove enemies.
+     */
+    EntityView<Enemy> viewEnemies() const { return this->enemies.View(); }
+    EntityView<Enemy> viewEnemies(EnemyType type) const { return this->enemiesByType[type].View(); }
+    /**
+     * @brief Call `visit` with every enemy body and the objects each enemy owns (bullets).
+     */
+    void visitObjects(Visitor<Object> visit) const;
+    /**
+     * @brief Visit enemies whose cell is at or next to the cells overlapping `bounds`.
+     *
+     * Candidates are conservative; run a narrowphase test on each one.
+     */
+    void QueryCandidates(const BoundingBox &bounds, Visitor<Entity> visit) const { this->grid.Query(bounds, visit); }
+
+    // Gameplay queries for attacks and targeting. Each one runs the
+    // narrowphase over the broadphase candidates, clears `out` and appends
+    // the matches, so a buffer kept by the caller stops allocating once it
+    // has grown. Enemies are tested by their center unless noted otherwise.
+    // Enemies of sleeping rooms are not in the broadphase and never match;
+    // rooms are not woken for a query. Player attacks cannot miss anyone
+    // this way: a room with living enemies keeps its doors shut and the
+    // player inside until it is cleared, so it is awake whenever the
+    // player can reach it.
+
+    /**
+     * @brief Enemies within `radius` of `center`.
+     */
+    void QuerySphere(const Vector3 &center, float radius, std::vector<Enemy *> &out) const;
+    /**
+     * @brief Enemies within `radius` of `center` on the XZ plane, at any height.
+     */
+    void QueryCylinder(const Vector3 &center, float radius, std::vector<Enemy *> &out) const;
+    /**
+     * @brief Enemies within `radius` of the segment from `start` to `end`.
+     */
+    void QueryCapsule(const Vector3 &start, const Vector3 &end, float radius, std::vector<Enemy *> &out) const;
+    /**
+     * @brief Enemies whose body collides with `volume` (Object::collided()).
+     */
+    void QueryOBB(Object &volume, std::vector<Enemy *> &out) const;
+    /**
+     * @brief The `k` enemies nearest to `center` within `radius`, nearest first; `exclude` is skipped.
+     */
+    void QueryNearest(const Vector3 &center, float radius, size_t k, std::vector<Enemy *> &out, const Entity *exclude = nullptr) const;
+    /**
+     * @brief The enemy nearest to `center` within `radius`, or nullptr.
+     */
+    Enemy *QueryNearest(const Vector3 &center, float radius, const Entity *exclude = nullptr) const;
+    /**
+     * @brief Delete every enemy; rooms are not told, since this runs at teardown.
+     */
     void clear();
 };
\ No newline at end of file
@@ -0,0 +1,232 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Weak reference to an entry of an EntityRegistry.
+ *
+ * A handle names a slot plus the generation the slot had when the entry was
+ * inserted. Removing the entry bumps the generation, so every handle still
+ * pointing at it resolves to nullptr instead of dangling.
+ */
+struct EntityHandle
+{
+    unsigned int index = 0;
+    unsigned int generation = 0; // 0 never names a live entry
+
+    bool isNull() const { return this->generation == 0; }
+    bool operator==(const EntityHandle &other) const { return this->index == other.index && this->generation == other.generation; }
+    bool operator!=(const EntityHandle &other) const { return !(*this == other); }
+};
+
+template <typename T>
+class EntityRegistry;
+
+/**
+ * @brief Non-allocating range over the live items of an EntityRegistry.
+ *
+ * The range covers the items present when it was created; items inserted
+ * while iterating are not visited and items marked for removal are skipped.
+ * Removing items outright while a view is being iterated reorders them, so
+ * owners that remove during iteration should defer with MarkForRemoval().
+ */
+template <typename T>
+class EntityView
+{
+public:
+    class iterator
+    {
+    public:
+        iterator(const EntityRegistry<T> *registry, size_t index, size_t end) : registry(registry), index(index), end(end) { this->SkipRemoved(); }
+        T *operator*() const { return this->registry->dense[this->index]; }
+        iterator &operator++()
+        {
+            ++this->index;
+            this->SkipRemoved();
+            return *this;
+        }
+        bool operator!=(const iterator &other) const { return this->index != other.index; }
+        bool operator==(const iterator &other) const { return this->index == other.index; }
+
+    private:
+        void SkipRemoved()
+        {
+            while (this->index < this->end &&
+                   (this->index >= this->registry->dense.size() || this->registry->IsMarkedAt(this->index)))
+                ++this->index;
+        }
+
+        const EntityRegistry<T> *registry;
+        size_t index;
+        size_t end;
+    };
+
+    explicit EntityView(const EntityRegistry<T> &registry) : registry(&registry), count(registry.dense.size()) {}
+    // Only the first `count` items (a size taken earlier) are visited.
+    EntityView(const EntityRegistry<T> &registry, size_t count) : registry(&registry), count(count) {}
+    iterator begin() const { return iterator(this->registry, 0, this->count); }
+    iterator end() const { return iterator(this->registry, this->count, this->count); }
+    bool empty() const { return !(this->begin() != this->end()); }
+
+private:
+    const EntityRegistry<T> *registry;
+    size_t count;
+};
+
+/**
+ * @brief Slot map of non-owning pointers addressed by generational handles.
+ *
+ * Items are kept densely packed for iteration. Insert, Get and Remove are
+ * O(1): removal moves the last item into the hole (swap-and-pop), so
+ * iteration order is not stable across removals. Freed slots are recycled
+ * through a free list with a bumped generation.
+ */
+template <typename T>
+class EntityRegistry
+{
+public:
+    EntityHandle Insert(T *item)
+    {
+        unsigned int slotIndex;
+        if (this->freeHead != NO_SLOT)
+        {
+            slotIndex = this->freeHead;
+            this->freeHead = this->slots[slotIndex].nextFree;
+        }
+        else
+        {
+            slotIndex = (unsigned int)this->slots.size();
+            this->slots.push_back(Slot{});
+        }
+
+        Slot &slot = this->slots[slotIndex];
+        slot.dense = (unsigned int)this->dense.size();
+        slot.nextFree = NO_SLOT;
+        this->dense.push_back(item);
+        this->denseToSlot.push_back(slotIndex);
+        return EntityHandle{slotIndex, slot.generation};
+    }
+
+    /**
+     * @brief The item named by `handle`, or nullptr if it was removed.
+     */
+    T *Get(EntityHandle handle) const
+    {
+        if (handle.index >= this->slots.size())
+            return nullptr;
+        const Slot &slot = this->slots[handle.index];
+        // Removal bumps the generation, so a free slot never matches a handle.
+        if (slot.generation != handle.generation || slot.markedForRemoval)
+            return nullptr;
+        return this->dense[slot.dense];
+    }
+
+    bool Contains(EntityHandle handle) const { return this->Get(handle) != nullptr; }
+
+    /**
+     * @brief Remove the item named by `handle` and return it (nullptr if stale).
+     */
+    T *Remove(EntityHandle handle)
+    {
+        T *item = this->Get(handle);
+        if (!item)
+            return nullptr;
+        this->RemoveSlot(handle.index);
+        return item;
+    }
+
+    /**
+     * @brief Hide the item from Get() and views without moving anything.
+     *
+     * Used while the registry is being iterated; RemoveMarked() finishes
+     * the removal once iteration is over.
+     */
+    bool MarkForRemoval(EntityHandle handle)
+    {
+        if (!this->Get(handle))
+            return false;
+        this->slots[handle.index].markedForRemoval = true;
+        ++this->markedCount;
+        return true;
+    }
+
+    /**
+     * @brief Remove every marked item, passing each one to `onRemoved`.
+     */
+    template <typename Fn>
+    void RemoveMarked(Fn &&onRemoved)
+    {
+        for (size_t i = this->dense.size(); i-- > 0 && this->markedCount > 0;)
+        {
+            if (!this->IsMarkedAt(i))
+                continue;
+            T *item = this->dense[i];
+            this->RemoveSlot(this->denseToSlot[i]);
+            --this->markedCount;
+            onRemoved(item);
+        }
+    }
+
+    EntityView<T> View() const { return EntityView<T>(*this); }
+
+    /**
+     * @brief Live items, densely packed in unspecified order (marked items included).
+     */
+    const std::vector<T *> &Items() const { return this->dense; }
+    size_t size() const { return this->dense.size(); }
+    bool empty() const { return this->dense.empty(); }
+
+    /**
+     * @brief Drop every item; all outstanding handles become stale.
+     */
+    void Clear()
+    {
+        while (!this->dense.empty())
+        {
+            this->RemoveSlot(this->denseToSlot.back());
+        }
+        this->markedCount = 0;
+    }
+
+private:
+    friend class EntityView<T>;
+    static constexpr unsigned int NO_SLOT = 0xFFFFFFFFu;
+
+    struct Slot
+    {
+        unsigned int generation = 1;
+        unsigned int dense = 0;
+        unsigned int nextFree = NO_SLOT;
+        bool markedForRemoval = false;
+    };
+
+    std::vector<T *> dense;
+    std::vector<unsigned int> denseToSlot;
+    std::vector<Slot> slots;
+    unsigned int freeHead = NO_SLOT;
+    size_t markedCount = 0;
+
+    bool IsMarkedAt(size_t denseIndex) const { return this->slots[this->denseToSlot[denseIndex]].markedForRemoval; }
+
+    void RemoveSlot(unsigned int slotIndex)
+    {
+        Slot &slot = this->slots[slotIndex];
+        unsigned int hole = slot.dense;
+        unsigned int last = (unsigned int)this->dense.size() - 1;
+        if (hole != last)
+        {
+            this->dense[hole] = this->dense[last];
+            this->denseToSlot[hole] = this->denseToSlot[last];
+            this->slots[this->denseToSlot[hole]].dense = hole;
+        }
+        this->dense.pop_back();
+        this->denseToSlot.pop_back();
+
+        // Skip generation 0 on wrap-around so it keeps meaning "null".
+        if (++slot.generation == 0)
+            slot.generation = 1;
+        slot.markedForRemoval = false;
+        slot.nextFree = this->freeHead;
+        this->freeHead = slotIndex;
+    }
+};
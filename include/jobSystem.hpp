@@ -0,0 +1,174 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class JobCounter;
+
+/**
+ * @brief Unit of work run by a JobSystem.
+ *
+ * `function(context, first, end)` is called once. `first`/`end` carry the
+ * index range of a ParallelFor chunk and are 0 for single jobs. `context`
+ * is not owned and must stay valid until the job has run.
+ */
+struct Job
+{
+    void (*function)(void *context, size_t first, size_t end) = nullptr;
+    void *context = nullptr;
+    size_t first = 0;
+    size_t end = 0;
+    const char *name = "job";      // Reported to the profiling hooks
+    JobCounter *counter = nullptr; // Decremented once the job has run
+};
+
+/**
+ * @brief Number of unfinished jobs in a group; used to wait and to chain work.
+ *
+ * Starting a job with a counter increments it and finishing the job
+ * decrements it. Jobs started with JobSystem::RunAfter() are held back until
+ * the counter they depend on reaches zero. A counter must outlive its jobs:
+ * call JobSystem::WaitFor() on it before it goes out of scope.
+ */
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter &) = delete;
+    JobCounter &operator=(const JobCounter &) = delete;
+
+    bool IsDone() const { return this->pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+    std::mutex mutex;                // Guards `continuations` and the final decrement
+    std::vector<Job> continuations; // Jobs waiting for `pending` to reach zero
+};
+
+/**
+ * @brief Work-stealing job scheduler shared by the per-frame systems.
+ *
+ * Create one at startup and reach it through `UpdateContext::jobs`. Every
+ * thread owns a queue: it pushes and pops its own jobs at the back, and idle
+ * threads steal the oldest jobs from the front of other queues. Threads
+ * that wait on a counter run queued jobs instead of blocking, so a job may
+ * start more jobs and wait for them.
+ *
+ * With zero workers every job runs on the thread that waits for it, in a
+ * fixed order, which makes results reproducible when chasing a bug.
+ */
+class JobSystem
+{
+public:
+    /**
+     * @brief Callbacks around every job, called on the thread that runs it.
+     *
+     * `worker` is 0 for the thread that created the JobSystem and 1..N for
+     * the pool threads. Either callback may be null.
+     */
+    struct ProfileHooks
+    {
+        void (*onJobBegin)(void *user, const char *name, unsigned int worker) = nullptr;
+        void (*onJobEnd)(void *user, const char *name, unsigned int worker) = nullptr;
+        void *user = nullptr;
+    };
+
+    /**
+     * @brief Start `workerCount` pool threads; negative picks one per hardware thread minus the caller.
+     */
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    unsigned int workerCount() const { return (unsigned int)this->threads.size(); }
+
+    /**
+     * @brief Install profiling callbacks; only call while no job is running.
+     */
+    void SetProfileHooks(const ProfileHooks &hooks) { this->hooks = hooks; }
+
+    void Run(const Job &job);
+    /**
+     * @brief Run `job` once `dependency` has reached zero.
+     */
+    void RunAfter(JobCounter &dependency, const Job &job);
+
+    /**
+     * @brief Run `fn()` as a job counted by `counter`.
+     *
+     * `fn` is referenced, not copied, so it must be a named callable that
+     * outlives the WaitFor() on `counter`.
+     */
+    template <typename Fn>
+    void Run(JobCounter &counter, const char *name, Fn &fn)
+    {
+        this->Run(MakeJob(counter, name, fn));
+    }
+
+    template <typename Fn>
+    void RunAfter(JobCounter &dependency, JobCounter &counter, const char *name, Fn &fn)
+    {
+        this->RunAfter(dependency, MakeJob(counter, name, fn));
+    }
+
+    /**
+     * @brief Call `fn(first, end)` over chunks of [0, count) and wait for all of them.
+     *
+     * Chunks hold at least `grain` indices and run concurrently in no
+     * particular order; the calling thread runs chunks too.
+     */
+    template <typename Fn>
+    void ParallelFor(const char *name, size_t count, size_t grain, Fn &&fn)
+    {
+        this->RunChunks(name, count, grain,
+                        [](void *ctx, size_t first, size_t end) { (*static_cast<std::remove_reference_t<Fn> *>(ctx))(first, end); },
+                        (void *)std::addressof(fn));
+    }
+
+    /**
+     * @brief Run queued jobs on this thread until `counter` reaches zero.
+     */
+    void WaitFor(JobCounter &counter);
+
+private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues; // [0] belongs to the creating thread
+    std::vector<std::thread> threads;
+    std::atomic<int> queuedJobs{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping = false; // Guarded by sleepMutex
+    ProfileHooks hooks;
+
+    template <typename Fn>
+    static Job MakeJob(JobCounter &counter, const char *name, Fn &fn)
+    {
+        Job job;
+        job.function = [](void *ctx, size_t, size_t) { (*static_cast<Fn *>(ctx))(); };
+        job.context = (void *)std::addressof(fn);
+        job.name = name;
+        job.counter = &counter;
+        return job;
+    }
+
+    void RunChunks(const char *name, size_t count, size_t grain, void (*fn)(void *, size_t, size_t), void *context);
+    unsigned int CurrentQueue() const;
+    void Submit(const Job &job);
+    bool TryRunOne(unsigned int self);
+    void Execute(const Job &job, unsigned int self);
+    void Finish(JobCounter *counter);
+    void WorkerMain(unsigned int index);
+};
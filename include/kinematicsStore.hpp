@@ -0,0 +1,128 @@
+#pragma once
+#include <vector>
+#include <raylib.h>
+#include "constant.hpp"
+#include "entityRegistry.hpp"
+
+/**
+ * @brief Structure-of-arrays store of kinematic bodies integrated in one pass.
+ *
+ * Batched alternative to calling `Entity::ApplyPhysics()` per entity, used by
+ * EnemyManager for enemies whose movement opts into it (see
+ * `Entity::ApplyBatchedPhysics()`). Every
+ * field lives in its own float array; `Integrate()` applies gravity,
+ * ground/air drag, the small-velocity cutoff, the max-accel clamp, position
+ * integration and the floor snap to four bodies per SSE register. It
+ * produces the same result as ApplyPhysics for the same parameters, because
+ * both use `IntegrateVelocity()` and `SnapToFloor()` (the scalar tail and
+ * non-SSE builds call them directly).
+ *
+ * The store has no scene knowledge. Swept collide-and-slide and contact
+ * resolution stay with the owner, so it suits many slow, crowd-like bodies.
+ * Behaviour code only writes directions (and impulses through
+ * SetVelocity); bodies are addressed by generational handles.
+ */
+class KinematicsStore
+{
+public:
+    static constexpr int LANES = 4;
+
+    /**
+     * @brief Initial state and tuning of one body (mirrors Entity::PhysicsParams).
+     */
+    struct Body
+    {
+        Vector3 position = {0.0f, 0.0f, 0.0f};
+        Vector3 velocity = {0.0f, 0.0f, 0.0f};
+        Vector3 direction = {0.0f, 0.0f, 0.0f}; // only x/z are used, as in ApplyPhysics
+        bool grounded = true;
+        bool useGravity = true;
+        float gravity = GRAVITY;
+        float decelGround = FRICTION;
+        float decelAir = AIR_DRAG;
+        float maxSpeed = MAX_SPEED;
+        float maxAccel = MAX_ACCEL;
+        float floorY = 0.0f;
+        float zeroThreshold = 0.0f; // if >0 used as is, else maxSpeed*0.01
+    };
+
+    EntityHandle Add(const Body &body);
+    /**
+     * @brief Overwrite the state and tuning of an existing body.
+     *
+     * Drag factors are only raised to the step again when they changed.
+     */
+    void Set(EntityHandle handle, const Body &body);
+    void Remove(EntityHandle handle);
+    bool Contains(EntityHandle handle) const;
+    void Clear();
+    /**
+     * @brief Grow every column so `count` bodies fit without allocating.
+     */
+    void Reserve(size_t count);
+    size_t size() const { return this->posX.size(); }
+
+    void SetDirection(EntityHandle handle, Vector3 direction);
+    void SetVelocity(EntityHandle handle, Vector3 velocity);
+    void SetFloorY(EntityHandle handle, float floorY);
+    Vector3 GetPosition(EntityHandle handle) const;
+    Vector3 GetVelocity(EntityHandle handle) const;
+    bool IsGrounded(EntityHandle handle) const;
+
+    /**
+     * @brief Advance every body by `delta` seconds.
+     */
+    void Integrate(float delta);
+
+    /**
+     * @brief Steps 1-4 of ApplyPhysics: gravity, drag, cutoff and acceleration along `direction`.
+     *
+     * `gravity` is 0 for bodies without gravity, `decel` is the drag factor
+     * already raised to this step, and `zeroThresholdSq` is the squared
+     * horizontal speed below which the body stops.
+     */
+    static void IntegrateVelocity(Vector3 &velocity, const Vector3 &direction, bool grounded, float gravity, float decel,
+                                  float zeroThresholdSq, float maxSpeed, float maxAccel, float delta);
+
+    /**
+     * @brief Clamp to `floorY` and update `grounded` exactly like ApplyPhysics.
+     */
+    static void SnapToFloor(Vector3 &position, Vector3 &velocity, bool &grounded, float floorY);
+
+    /**
+     * @brief Horizontal speed below which ApplyPhysics zeroes the velocity.
+     */
+    static float ResolveZeroThreshold(float zeroThreshold, float maxSpeed)
+    {
+        return (zeroThreshold > 0.0f) ? zeroThreshold : (maxSpeed > 0.0f ? maxSpeed * 0.01f : MAX_SPEED * 0.01f);
+    }
+
+private:
+    struct Slot
+    {
+        unsigned int generation = 1;
+        unsigned int dense = 0;
+        unsigned int nextFree = NO_SLOT;
+    };
+    static constexpr unsigned int NO_SLOT = 0xFFFFFFFFu;
+
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> dirX, dirZ;
+    std::vector<float> grounded; // 1.0f or 0.0f so it can be loaded as a lane mask source
+    std::vector<float> gravity;  // 0 when the body has no gravity
+    std::vector<float> decelGround, decelAir;
+    std::vector<float> maxSpeed, maxAccel, floorY, zeroThresholdSq;
+    std::vector<float> decelGroundStep, decelAirStep; // drag factors raised to `stepDelta`
+    float stepDelta = -1.0f;
+
+    std::vector<unsigned int> denseToSlot;
+    std::vector<Slot> slots;
+    unsigned int freeHead = NO_SLOT;
+
+    template <typename Fn>
+    void ForEachColumn(Fn &&fn);
+    int DenseIndex(EntityHandle handle) const;
+    void UpdateStepFactors(size_t index);
+    void IntegrateRange(size_t first, size_t end, float delta);
+};
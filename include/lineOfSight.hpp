@@ -0,0 +1,136 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <raylib.h>
+
+/**
+ * @brief Memo of static sweep results keyed by the cells of their end points.
+ *
+ * Shooters ask the same question, "can I hit the player from here", every
+ * tick and for every reposition candidate, and the answer only changes when
+ * one of the two points crosses into another cell or a door adds or removes
+ * its collider. Entries sit in a fixed direct-mapped table: a new result
+ * simply replaces whatever hashed to the same slot, so the cache never grows
+ * or allocates after construction. Invalidate() bumps a generation instead
+ * of clearing the table.
+ *
+ * Points anywhere in the same cell share one answer, so results are exact
+ * only to within `cellSize`. Lookups are safe from several threads at once;
+ * the sweep itself runs outside the lock.
+ */
+class LineOfSightCache
+{
+public:
+    explicit LineOfSightCache(float cellSize = 1.0f, size_t capacity = 4096);
+
+    /**
+     * @brief Cached result of `sweep()` for a sphere of `radius` from `start` to `end`; true means blocked.
+     *
+     * `ignoreDistance` is part of the key, the same as the radius.
+     */
+    template <typename SweepFn>
+    bool IsBlocked(const Vector3 &start, const Vector3 &end, float radius, float ignoreDistance, SweepFn &&sweep)
+    {
+        Key key = this->MakeKey(start, end, radius, ignoreDistance);
+        bool blocked = false;
+        if (this->Lookup(key, blocked))
+            return blocked;
+
+        blocked = sweep();
+        this->Store(key, blocked);
+        return blocked;
+    }
+
+    /**
+     * @brief Forget every result; call when blocking geometry changes.
+     */
+    void Invalidate();
+
+    /**
+     * @brief Invalidate() when `revision` differs from the one seen last; cheap to call every tick.
+     */
+    void SyncRevision(unsigned int revision);
+
+private:
+    struct Key
+    {
+        uint64_t from = 0;
+        uint64_t to = 0;
+        float radius = 0.0f;
+        float ignoreDistance = 0.0f;
+    };
+
+    struct Entry
+    {
+        Key key;
+        unsigned int generation = 0; // 0 never matches, so fresh entries are empty
+        bool blocked = false;
+    };
+
+    float invCellSize;
+    size_t mask; // capacity - 1
+    std::vector<Entry> entries;
+    unsigned int generation = 1;
+    unsigned int revision = 0;
+    std::mutex mutex;
+
+    Key MakeKey(const Vector3 &start, const Vector3 &end, float radius, float ignoreDistance) const;
+    uint64_t CellKey(const Vector3 &p) const;
+    size_t SlotOf(const Key &key) const;
+    bool Lookup(const Key &key, bool &outBlocked);
+    void Store(const Key &key, bool blocked);
+};
+
+/**
+ * @brief Coarse cell-to-cell visibility over one room, computed once per level.
+ *
+ * The room's XZ footprint is cut into square cells, and Build() sweeps from
+ * every cell center to every other at one sample height, keeping one bit
+ * per pair. MayBeVisible() then answers in two lookups whether two points
+ * could see each other. It is a filter, not a verdict: a false answer means
+ * the cell centers were blocked, so the caller can skip an exact sweep that
+ * would most likely fail too, while a true answer still needs one. Points
+ * outside the field are always reported visible.
+ */
+class VisibilityField
+{
+public:
+    /**
+     * @brief Fill the field over `area`; `blocked(a, b)` sweeps between two sample points.
+     */
+    template <typename BlockedFn>
+    void Build(const BoundingBox &area, float cellSize, float sampleHeight, BlockedFn &&blocked)
+    {
+        this->BeginBuild(area, cellSize, sampleHeight);
+        const int count = this->columns * this->rows;
+        for (int a = 0; a < count; ++a)
+        {
+            for (int b = a + 1; b < count; ++b)
+            {
+                if (!blocked(this->CellCenter(a), this->CellCenter(b)))
+                    this->SetVisible(a, b);
+            }
+        }
+    }
+
+    bool MayBeVisible(const Vector3 &a, const Vector3 &b) const;
+    bool IsBuilt() const { return this->columns > 0; }
+    int CellCount() const { return this->columns * this->rows; }
+
+private:
+    float originX = 0.0f;
+    float originZ = 0.0f;
+    float cellSize = 1.0f;
+    float invCellSize = 1.0f;
+    float sampleHeight = 0.0f;
+    int columns = 0;
+    int rows = 0;
+    std::vector<uint64_t> bits; // CellCount() squared, symmetric; the diagonal is always set
+
+    void BeginBuild(const BoundingBox &area, float cellSize, float sampleHeight);
+    Vector3 CellCenter(int cell) const;
+    int CellOf(const Vector3 &p) const; // -1 outside
+    void SetVisible(int a, int b);
+    bool TestBit(size_t bit) const { return (this->bits[bit >> 6] >> (bit & 63)) & 1u; }
+};
@@ -3,7 +3,12 @@
 #include <constant.hpp>
 #include <vector>
 #include "object.hpp"
+#include "entityRegistry.hpp"
+#include "kinematicsStore.hpp"
+#include "projectileWorld.hpp"
+#include "visitor.hpp"
 class DialogBox;
+class Room;
 #include "Inventory.hpp"
 #include "mycamera.hpp"
 #include "uiManager.hpp"
@@ -20,6 +25,48 @@ enum EntityCategory
     ENTITY_PROJECTILE,
     ENTITY_ALL,
 };
+/**
+ * @brief Concrete enemy kind; indexes EnemyManager's per-type lists.
+ */
+enum EnemyType
+{
+    ENEMY_MINION,
+    ENEMY_CHARGING,
+    ENEMY_SHOOTER,
+    ENEMY_SUMMONER,
+    ENEMY_SUPPORT,
+    ENEMY_VANGUARD,
+    ENEMY_TYPE_COUNT,
+};
+/**
+ * @brief Per-enemy input of Enemy::Think(), which runs on a worker thread.
+ *
+ * The world is a frozen snapshot while enemies think: read the player, the
+ * scene and other enemies through `uc`, but write only the thinking enemy's
+ * own intent. GetRandomValue() is not thread-safe, so draw from Random(),
+ * whose seed is picked on the main thread and keeps results deterministic.
+ */
+struct ThinkContext
+{
+    UpdateContext &uc;
+    unsigned int randomState;
+
+    ThinkContext(UpdateContext &uc, unsigned int seed) : uc(uc), randomState(seed ? seed : 0x9E3779B9u) {}
+
+    /**
+     * @brief Random integer in [min, max], like GetRandomValue().
+     */
+    int Random(int min, int max)
+    {
+        // xorshift32
+        this->randomState ^= this->randomState << 13;
+        this->randomState ^= this->randomState >> 17;
+        this->randomState ^= this->randomState << 5;
+        if (max <= min)
+            return min;
+        return min + (int)(this->randomState % ((unsigned int)(max - min) + 1u));
+    }
+};
 /**
  * @brief Base class for all entities in the game (player, enemies, projectiles).
  *
@@ -38,6 +85,11 @@ protected:
     Vector3 velocity;  // Current velocity of the entity
     Vector3 direction; // Current movement direction of the entity
     bool grounded;     // Whether the entity is on the ground
+    Vector3 previousPosition = {0.0f, 0.0f, 0.0f}; // Position at the start of the latest tick (render interpolation)
+    bool hasPreviousPosition = false;
+    EntityHandle handle;         // Registry slot; null until a manager registers the entity
+    bool contactPending = false; // Overlaps left for the scene's ContactSolver this tick
+    float contactFloorY = 0.0f;  // Floor the solver must not push the entity below
     /**
      * @brief Parameters that control the shared physics integration.
      *
@@ -53,17 +105,16 @@ protected:
         float maxSpeed = MAX_SPEED; // desired max horizontal speed
         float maxAccel = MAX_ACCEL; // max acceleration (units/sec^2)
         float floorY = 0.0f;        // floor Y-level for ground collision
-        bool iterativeCollisionResolve = false; // whether to call resolveCollision
+        bool iterativeCollisionResolve = false; // whether the scene ContactSolver resolves overlaps this tick
         float zeroThreshold = 0.0f; // if >0 use as absolute threshold for zeroing hvel, else uses maxSpeed*0.01
     };
     
-    static void resolveCollision(Entity *e, UpdateContext &uc);
     /**
      * @brief Apply common physics integration to an entity.
      *
      * This helper performs gravity application, ground/air drag, optional
-     * acceleration along `entity->direction`, position integration,
-     * optional iterative collision resolution, and floor clamping.
+     * acceleration along `entity->direction`, position integration and floor
+     * clamping, and optionally flags the entity for the scene's contact solver.
      *
      * @param e Entity to update (modified in-place).
      * @param uc Frame update context (scene, player, input snapshot).
@@ -71,6 +122,24 @@ protected:
      */
     static void ApplyPhysics(Entity *e, UpdateContext &uc, const PhysicsParams &p);
 
+    /**
+     * @brief Finish a step whose integration ran in `bodies.Integrate()`.
+     *
+     * `body` must have been set from BodyFor() with the same `p` before the
+     * store integrated. Leaves `e` as ApplyPhysics() would; a step that could
+     * tunnel is redone from the integrated velocity with the scene sweep.
+     */
+    static void ApplyBatchedPhysics(Entity *e, UpdateContext &uc, const PhysicsParams &p, const KinematicsStore &bodies, EntityHandle body);
+
+    /**
+     * @brief The KinematicsStore body for this entity's current state under `p`.
+     */
+    KinematicsStore::Body BodyFor(const PhysicsParams &p) const;
+
+private:
+    // Steps 5-9 of ApplyPhysics: move by the integrated velocity, then snap to the floor
+    static void IntegratePosition(Entity *e, UpdateContext &uc, const PhysicsParams &p);
+
 public:
     // Default constructor initializes the entity with default values
     Entity()
@@ -79,6 +148,7 @@ public:
         velocity = {0};
         direction = {0};
         grounded = true;
+        o.bulletProxy.Enable();
     }
 
     // Parameterized constructor initializes the entity with specific values
@@ -88,6 +158,7 @@ public:
         velocity = vel;
         direction = d;
         grounded = g;
+        o.bulletProxy.Enable();
     }
 
     // Getters for entity properties
@@ -97,6 +168,8 @@ public:
     Object &obj() { return this->o; }
     const Object &obj() const { return this->o; }
     bool isGrounded() const { return this->grounded; }
+    EntityHandle getHandle() const { return this->handle; }
+    void setHandle(EntityHandle h) { this->handle = h; }
 
     // Setters for entity properties
     void setVelocity(const Vector3 &newVel) { this->velocity = newVel; }
@@ -108,6 +181,39 @@ public:
         this->o.UpdateOBB();
     }
 
+    /**
+     * @brief Whether ApplyPhysics() left overlaps for the scene's contact solver.
+     */
+    bool isContactPending() const { return this->contactPending; }
+
+    /**
+     * @brief Apply the contact solver's correction and clear the pending flag.
+     *
+     * Keeps the visual offset between `o.pos` and `position` and re-applies
+     * the floor clamp from ApplyPhysics().
+     */
+    void applyContactDisplacement(const Vector3 &displacement);
+
+    /**
+     * @brief Remember the current position as the start of the next tick.
+     */
+    void storePreviousPosition()
+    {
+        this->previousPosition = this->position;
+        this->hasPreviousPosition = true;
+    }
+
+    /**
+     * @brief Position blended between the last two simulation ticks.
+     *
+     * `alpha` is the fraction of a tick elapsed since the latest one. Entities
+     * spawned during the latest tick have no history and report `pos()`.
+     */
+    Vector3 interpolatedPos(float alpha) const
+    {
+        return this->hasPreviousPosition ? Vector3Lerp(this->previousPosition, this->position, alpha) : this->position;
+    }
+
     /**
      * @brief Per-frame body update.
      *
@@ -136,6 +242,9 @@ public:
 class Enemy : public Entity
 {
 private:
+    const EnemyType type;
+    EntityHandle typeHandle; // Slot in EnemyManager's list for `type`
+    Room *room = nullptr; // Room the enemy belongs to; it sleeps with the room
     int health; // Enemy's health
     int maxHealth = MAX_HEALTH_ENEMY; // Enemy's max health
     DialogBox *healthDialog = nullptr;
@@ -169,9 +278,35 @@ protected:
         float zeroThreshold = -1.0f;
         bool overrideHorizontalVelocity = false;
         Vector3 forcedHorizontalVelocity = {0.0f, 0.0f, 0.0f};
+        bool batchedPhysics = false; // Integrate in EnemyManager's KinematicsStore with the rest of the type
+    };
+
+    // What UpdateCommonBehavior() needs again once the physics step is done
+    struct Movement
+    {
+        PhysicsParams params;
+        MovementSettings settings;
+        Vector3 moveDir = {0.0f, 0.0f, 0.0f};
+        bool knockedBack = false;
+        float deltaSeconds = 0.0f;
     };
+    Movement movement;
+    bool movementStaged = false;
+    EntityHandle kinematicsBody; // Body in EnemyManager's KinematicsStore, null until first staged
 
+    /**
+     * @brief Move, turn and animate the enemy towards `desiredDirection`.
+     *
+     * With `settings.batchedPhysics` inside EnemyManager::update() the physics
+     * step is staged and the rest, FinishBody() included, runs once the
+     * manager has integrated the whole type.
+     */
     void UpdateCommonBehavior(UpdateContext &uc, const Vector3 &desiredDirection, float deltaSeconds, const MovementSettings &settings);
+    void FinishCommonBehavior(UpdateContext &uc);
+    /**
+     * @brief Per-tick work that needs the moved body; called at the end of UpdateCommonBehavior().
+     */
+    virtual void FinishBody(UpdateContext &uc) {}
     void UpdateDialog(UpdateContext &uc, float verticalOffset = 1.4f);
     bool isKnockbackActive() const { return this->knockbackTimer > 0.0f; }
     bool isStunned() const { return this->stunTimer > 0.0f; }
@@ -180,10 +315,17 @@ protected:
     bool updateStun(UpdateContext &uc);
     bool updateElectrocute(float deltaSeconds);
     void tickStatusTimers(float deltaSeconds);
+    // True when the next update, `deltaSeconds` long, will find the enemy stunned, unable to move or knocked back
+    bool isIncapacitatedNextUpdate(float deltaSeconds) const
+    {
+        return this->stunTimer > deltaSeconds || this->movementDisableTimer > deltaSeconds || this->knockbackTimer > 0.0f;
+    }
+    // Run Think() on the calling thread when EnemyManager did not (UpdateBody called directly)
+    void ThinkNow(UpdateContext &uc);
 
 public:
-    // Default constructor initializes the enemy with default values
-    Enemy()
+    // Initializes the enemy with default values
+    explicit Enemy(EnemyType type) : type(type)
     {
         position = {0};
         velocity = {0};
@@ -195,10 +337,11 @@ public:
         runTimer = 0.0f;
         runLerp = 0.0f;
         facingDirection = {0.0f, 0.0f, 1.0f}; // Default forward
+        o.collisionLayer = COLLISION_LAYER_ENEMY;
         // healthDialog will be created by enemy implementations (cpp) where type is complete
     }
     
-    Enemy(int customHealth)
+    Enemy(EnemyType type, int customHealth) : type(type)
     {
         position = {0};
         velocity = {0};
@@ -210,6 +353,7 @@ public:
         runTimer = 0.0f;
         runLerp = 0.0f;
         facingDirection = {0.0f, 0.0f, 1.0f};
+        o.collisionLayer = COLLISION_LAYER_ENEMY;
     }
 
     virtual ~Enemy();
@@ -222,8 +366,35 @@ public:
     float getStunTime() const { return this->stunTimer; }
     // Identify this entity as an enemy for filtered queries
     EntityCategory category() const override;
+    EnemyType getType() const { return this->type; }
+    EntityHandle getTypeHandle() const { return this->typeHandle; }
+    void setTypeHandle(EntityHandle handle) { this->typeHandle = handle; }
+    Room *getRoom() const { return this->room; }
+    // Bind to a room before EnemyManager::addEnemy(); the manager keeps the room's head count
+    void setRoom(Room *home) { this->room = home; }
+    // True while projectiles fired by this enemy are still in flight
+    virtual bool hasLiveProjectiles() const { return false; }
+    // Called by EnemyManager just before a killed enemy is removed
+    virtual void OnDeath(UpdateContext &) {}
+    // True between a batched UpdateCommonBehavior() and FinishStagedMovement()
+    bool isMovementStaged() const { return this->movementStaged; }
+    /**
+     * @brief Finish the movement staged in `bodies` once EnemyManager has integrated them.
+     */
+    void FinishStagedMovement(UpdateContext &uc, const KinematicsStore &bodies);
+    EntityHandle getKinematicsBody() const { return this->kinematicsBody; }
+    void setKinematicsBody(EntityHandle body) { this->kinematicsBody = body; }
+    /**
+     * @brief Read-only AI step that EnemyManager runs in parallel before UpdateBody().
+     *
+     * Expensive decisions (line-of-sight probes, target searches, random
+     * rolls) go here and are stored as an intent on the enemy; the serial
+     * UpdateBody() then applies it as movement, spawning and damage.
+     */
+    virtual void Think(ThinkContext &) {}
     Vector3 getFacingDirection() const { return this->facingDirection; }
-    virtual void gatherObjects(std::vector<Object *> &out) const;
+    // Visit the body and any other objects this enemy draws (e.g. bullets)
+    virtual void visitObjects(Visitor<Object> visit) const;
     int getHealth() const { return this->health; }
     int getMaxHealth() const { return this->maxHealth; }
     void setMaxHealth(int newMaxHealth) { this->maxHealth = newMaxHealth; }
@@ -251,6 +422,13 @@ public:
     }
 
     DialogBox *getHealthDialog() { return this->healthDialog; }
+    // Hand the health dialog back to its owner (EnemyManager's pool) before destruction
+    DialogBox *detachHealthDialog()
+    {
+        DialogBox *dialog = this->healthDialog;
+        this->healthDialog = nullptr;
+        return dialog;
+    }
     
     // Virtual draw method for custom enemy visuals
     virtual void Draw() const;
@@ -275,10 +453,14 @@ private:
     float launchUpwardVelocity = 10.0f;
     float attackDamage = 15.0f;
     bool appliedDamage = false;
+    EntityHandle summoner; // Summoner that spawned this minion, null for minions placed with the room
     
 public:
-    MinionEnemy() : Enemy(30) { this->setMaxHealth(30); this->setTileType(TileType::DOT_3); }
+    MinionEnemy() : Enemy(ENEMY_MINION, 30) { this->setMaxHealth(30); this->setTileType(TileType::DOT_3); }
     void UpdateBody(UpdateContext &uc) override;
+    void FinishBody(UpdateContext &uc) override;
+    void setSummoner(EntityHandle owner) { this->summoner = owner; }
+    EntityHandle getSummoner() const { return this->summoner; }
 };
 
 class ChargingEnemy : public Enemy
@@ -317,7 +499,7 @@ private:
     bool updatePoseTowards(float targetAngleDeg, float deltaSeconds);
 
 public:
-    ChargingEnemy() : Enemy(500) 
+    ChargingEnemy() : Enemy(ENEMY_CHARGING, 500) 
     { 
         this->setMaxHealth(500);  // Tank: 500 HP
         this->setTileType(TileType::CHARACTER_9); // Tank uses Character tiles
@@ -340,29 +522,21 @@ private:
         float speed = 0.0f;
     };
 
-    struct Bullet
-    {
-        Vector3 position;
-        Vector3 velocity;
-        float radius;
-        float remainingLife;
-        Object visual;
-    };
-
     struct BulletPattern
     {
         int bulletCount = 1;      // Number of bullets to fire
         float arcDegrees = 0.0f;  // Spread arc in degrees (0 = single direction)
     };
 
-    std::vector<Bullet> bullets;
+    static ProjectileKindId bulletKind; // Registered with the scene's ProjectileWorld
+    static constexpr float bulletRadius = 0.3f;
+    static constexpr float bulletLifetime = 6.0f;
+
+    int liveBullets = 0;          // Fired bullets still in the ProjectileWorld
     BulletPattern bulletPattern;  // Current bullet pattern configuration
-    Texture2D sunTexture{};       // Texture for bullets
     float fireCooldown = 0.0f;
     float fireInterval = 2.0f;
     float bulletSpeed = 25.0f;
-    float bulletRadius = 0.3f;
-    float bulletLifetime = 6.0f;
     float bulletDamage = 8.0f;
     float muzzleHeight = 3.0f;
     float maxFiringDistance = 45.0f;
@@ -380,21 +554,40 @@ private:
     float repositionCooldown = 0.0f;
     float repositionCooldownDuration = 0.7f;
 
+    // Written by Think(), consumed by the next UpdateBody()
+    struct Intent
+    {
+        bool valid = false;
+        bool incapacitated = false; // Nothing below was computed; UpdateBody() will not aim or move
+        bool hasLineOfSight = false;
+        Vector3 aimDir = {0.0f, 0.0f, 0.0f};
+        bool repositionSearched = false; // FindRepositionGoal() already ran for this tick
+        bool repositionFound = false;
+        Vector3 repositionGoal = {0.0f, 0.0f, 0.0f};
+    };
+    Intent intent;
+
     bool findShotDirection(UpdateContext &uc, Vector3 &outDir) const;
     bool hasLineOfFire(const Vector3 &start, const Vector3 &end, UpdateContext &uc, float probeRadius) const;
-    void spawnBullet(const Vector3 &origin, const Vector3 &dir);
-    void updateBullets(UpdateContext &uc, float deltaSeconds);
+    void spawnBullet(UpdateContext &uc, const Vector3 &origin, const Vector3 &dir);
+    static void OnBulletGone(void *user, const ProjectileImpact &impact, UpdateContext &uc);
     MovementCommand FindMovement(UpdateContext &uc, const Vector3 &toPlayer, float distance, bool hasLineOfSight, float deltaSeconds);
     bool isWithinPreferredRange(float distance) const;
-    void HandleShooting(float deltaSeconds, const Vector3 &muzzle, const Vector3 &aimDir, bool hasAim);
+    void HandleShooting(UpdateContext &uc, float deltaSeconds, const Vector3 &muzzle, const Vector3 &aimDir, bool hasAim);
     bool HasLineOfSightFromPosition(const Vector3 &origin, UpdateContext &uc) const;
+    bool FindRepositionGoal(UpdateContext &uc, const Vector3 &planarToPlayer, float distanceToPlayer, Vector3 &outGoal) const;
     bool SelectRepositionGoal(UpdateContext &uc, const Vector3 &planarToPlayer, float distanceToPlayer);
+    bool NeedsRepositionSearch(float distance, bool hasLineOfSight, float deltaSeconds) const;
 
 public:
     ShooterEnemy();  // Constructor sets 250 HP (Sniper)
-    ~ShooterEnemy();
+    /**
+     * @brief Register the bullet kind every shooter fires; call once when the scene is built.
+     */
+    static void RegisterBulletKind(ProjectileWorld &world, Texture2D *texture);
+    void Think(ThinkContext &tc) override;
     void UpdateBody(UpdateContext &uc) override;
-    void gatherObjects(std::vector<Object *> &out) const override;
+    bool hasLiveProjectiles() const override { return this->liveBullets > 0; }
     void setBulletPattern(int bulletCount, float arcDegrees)
     {
         this->bulletPattern.bulletCount = bulletCount;
@@ -454,6 +647,7 @@ public:
         this->o.setAsBox({this->colliderWidth, this->colliderHeight, this->colliderDepth});
         this->o.pos = this->position;
         this->o.visible = false;
+        this->o.collisionLayer = COLLISION_LAYER_PLAYER;
         this->o.UpdateOBB();
 
         camera = MyCamera(this->position, this->getColliderHalfHeight()); // Initialize the camera with the player's position
@@ -512,9 +706,8 @@ private:
     SummonState summonState = SummonState::Idle;
     float spawnTimer = 0.0f;
     float spawnInterval = 9.0f; // Seconds between summon cycles
-    int groupSize = 5; // Always spawn 5 minions
+    int groupSize = MINION_GROUP_SIZE; // Always spawn 5 minions
     float retreatDistance = 20.0f; // Retreat if player closer
-    std::vector<MinionEnemy*> ownedMinions; // Track spawned minions for cleanup
     
     // Animation timing
     float animationTimer = 0.0f;
@@ -531,7 +724,8 @@ private:
     float startAnimZ = 0.0f;            // Z position when animation starts
     
     // Visual effect counters
-    Texture2D spiralParticleTexture = {0};
+    // Texture is shared between all Summoner instances so pooled spawns never reload it
+    static Texture2D sharedSpiralParticleTexture;
     float particleEmitTimer = 0.0f;
     float particleEmitRate = 20.0f;    // Particle per frame during animation
     
@@ -541,10 +735,12 @@ private:
     void CleanupMinions(UpdateContext &uc);
 
 public:
-    SummonerEnemy() : Enemy(200) { this->setMaxHealth(200); this->setTileType(TileType::DOT_7); }
-    ~SummonerEnemy();
+    static constexpr int MINION_GROUP_SIZE = 5;
+    SummonerEnemy() : Enemy(ENEMY_SUMMONER, 200) { this->setMaxHealth(200); this->setTileType(TileType::DOT_7); }
+    static void LoadSharedResources();  // Load spiral particle texture once at game start
+    static void UnloadSharedResources(); // Cleanup on game end
     void UpdateBody(UpdateContext &uc) override;
-    void OnDeath(UpdateContext &uc);
+    void OnDeath(UpdateContext &uc) override;
     void Draw() const override;
 };
 
@@ -585,10 +781,20 @@ private:
     
     // Particle emission timers
     float chargeParticleTimer = 0.0f;
+
+    // Targets picked by Think(), consumed by the next UpdateBody()
+    struct Intent
+    {
+        bool valid = false;
+        Enemy* healTarget = nullptr;
+        Enemy* buffTarget = nullptr;
+        Enemy* hideAlly = nullptr;
+    };
+    Intent intent;
     
     // Helper methods
-    Enemy* FindAllyToHideBehind(UpdateContext &uc);
-    Enemy* FindBestTarget(UpdateContext &uc, bool forHealing);
+    Enemy* FindAllyToHideBehind(ThinkContext &tc) const;
+    Enemy* FindBestTarget(UpdateContext &uc, bool forHealing) const;
     Vector3 CalculateHidePosition(UpdateContext &uc, Enemy* allyToHideBehind);
     void UpdateNormalMode(UpdateContext &uc, const Vector3 &toPlayer);
     void UpdateBuffMode(UpdateContext &uc);
@@ -596,7 +802,8 @@ private:
     void DrawGlowEffect(const Vector3 &pos, Color color, float intensity) const;
 
 public:
-    SupportEnemy() : Enemy(250) { this->setMaxHealth(250); this->setTileType(TileType::CHARACTER_1); }
+    SupportEnemy() : Enemy(ENEMY_SUPPORT, 250) { this->setMaxHealth(250); this->setTileType(TileType::CHARACTER_1); }
+    void Think(ThinkContext &tc) override;
     void UpdateBody(UpdateContext &uc) override;
     void Draw() const override;
 };
@@ -702,18 +909,35 @@ private:
     float cachedCameraYawDeg = 0.0f;
     float cachedCameraPitchDeg = 0.0f;
 
+    enum class VanguardAction
+    {
+        Chase,       // Keep running at the player
+        GroundCombo, // Piston Thrust + Crescent Sweep
+        Dive         // Aerial dive
+    };
+
+    // Decision rolled by Think(), applied by the next UpdateBody()
+    struct Intent
+    {
+        bool valid = false;
+        VanguardAction action = VanguardAction::Chase;
+    };
+    Intent intent;
+
     // Helper methods
     Vector3 CalculateBackstabPosition(UpdateContext &uc);
     void HandleGroundCombo(UpdateContext &uc);  // Two-stage combo: Piston Thrust stab then Crescent Sweep slash
     void HandleAerialDive(UpdateContext &uc);   // Ascend -> Hover -> Dive with shockwave
     bool CheckStabHit(UpdateContext &uc);       // Collision check for stab attack
     bool CheckSlashHit(UpdateContext &uc);      // Collision check for slash attack
-    void DecideAction(UpdateContext &uc, float distanceToPlayer);  // AI decision making based on distance
+    VanguardAction ChooseAction(float distanceToPlayer, float roll, float diveCooldown) const;  // AI decision making based on distance
+    void DecideAction(UpdateContext &uc, VanguardAction action);
 
 public:
-    VanguardEnemy() : Enemy(180) { this->setMaxHealth(180); this->setTileType(TileType::DRAGON_RED); }
+    VanguardEnemy() : Enemy(ENEMY_VANGUARD, 180) { this->setMaxHealth(180); this->setTileType(TileType::DRAGON_RED); }
     static void LoadSharedResources();  // Load spear model once at game start
     static void UnloadSharedResources(); // Cleanup on game end
+    void Think(ThinkContext &tc) override;
     void UpdateBody(UpdateContext &uc) override;
     void Draw() const override;
 };
@@ -745,6 +969,7 @@ public:
         grounded = false;
         friction = PROJECTILE_FRICTION;
         airDrag = PROJECTILE_AIR_DRAG;
+        o.collisionLayer = COLLISION_LAYER_PROJECTILE;
     }
 
     // Parameterized constructor initializes the projectile with specific values
@@ -755,6 +980,7 @@ public:
         this->direction = d;
         this->grounded = g;
         this->o = o1;
+        this->o.collisionLayer = COLLISION_LAYER_PROJECTILE;
         this->friction = fric;
         this->airDrag = aird;
         this->type = _type;
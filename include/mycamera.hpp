@@ -65,6 +65,7 @@ public:
     /**
      * @brief Update internal camera transform from player state.
      *
+     * @param deltaSeconds time since the previous camera update
      * @param sideway -1/0/1 for strafing input
      * @param forward -1/0/1 for forward/back input
      * @param crouching true if player is holding crouch
@@ -72,7 +73,7 @@ public:
      * @param isGrounded whether player is currently grounded
      * @param swingAmount normalized melee swing influence [0,1]
      */
-    void UpdateCamera(char sideway, char forward, bool crouching, Vector3 playerCenter, float colliderHalfHeight, bool isGrounded, float swingAmount = 0.0f);
+    void UpdateCamera(float deltaSeconds, char sideway, char forward, bool crouching, Vector3 playerCenter, float colliderHalfHeight, bool isGrounded, float swingAmount = 0.0f);
 
     /**
      * @brief Apply a short camera shake.
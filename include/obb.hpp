@@ -6,19 +6,43 @@ class Entity;
 /**
  * @brief Oriented Bounding Box (OBB) representation for 3D collision tests.
  *
- * Stores a quaternion `rotation`, a world-space `center` and `halfExtents`.
- * The helper functions below project OBBs onto axes and implement SAT
- * collision tests used by the physics system.
+ * Stores a quaternion `rotation`, a world-space `center` and `halfExtents`,
+ * plus the world-space local axes derived from `rotation`. The axes are the
+ * columns of the rotation matrix, so dotting with them applies the inverse
+ * rotation; helpers use them instead of rebuilding matrices or inverting the
+ * quaternion per query. Change the rotation through `OBB_SetRotation()` so
+ * the cached axes stay in sync.
  */
 struct OBB
 {
-    Quaternion rotation; // The rotation of the box.
-    Vector3 center;      // The center of the box in world space.
-    Vector3 halfExtents; // The half-lengths of the box along its local x, y, and z axes.
+    Quaternion rotation = {0.0f, 0.0f, 0.0f, 1.0f}; // The rotation of the box.
+    Vector3 center = {0.0f, 0.0f, 0.0f};             // The center of the box in world space.
+    Vector3 halfExtents = {0.0f, 0.0f, 0.0f};        // The half-lengths of the box along its local x, y, and z axes.
+    Vector3 axes[3] = {{1.0f, 0.0f, 0.0f},            // Cached local x, y and z axes in world space.
+                       {0.0f, 1.0f, 0.0f},
+                       {0.0f, 0.0f, 1.0f}};
 };
 
 /**
- * @brief Extract orthonormal local axes from an OBB's quaternion.
+ * @brief Set the OBB rotation, refreshing the cached axes only when it changed.
+ */
+inline void OBB_SetRotation(OBB *obb, Quaternion rotation)
+{
+    if (rotation.x == obb->rotation.x && rotation.y == obb->rotation.y &&
+        rotation.z == obb->rotation.z && rotation.w == obb->rotation.w)
+    {
+        return;
+    }
+
+    obb->rotation = rotation;
+    Matrix rot = QuaternionToMatrix(rotation);
+    obb->axes[0] = (Vector3){rot.m0, rot.m1, rot.m2};  // First column
+    obb->axes[1] = (Vector3){rot.m4, rot.m5, rot.m6};  // Second column
+    obb->axes[2] = (Vector3){rot.m8, rot.m9, rot.m10}; // Third column
+}
+
+/**
+ * @brief Return the OBB's cached orthonormal local axes.
  *
  * @param obb Source OBB
  * @param right Out: local X axis
@@ -27,11 +51,30 @@ struct OBB
  */
 inline void OBB_GetAxes(const OBB *obb, Vector3 *right, Vector3 *up, Vector3 *forward)
 {
-    Matrix rot = QuaternionToMatrix(obb->rotation);
+    *right = obb->axes[0];
+    *up = obb->axes[1];
+    *forward = obb->axes[2];
+}
+
+/**
+ * @brief Express a world-space direction in the OBB's local frame.
+ */
+inline Vector3 OBB_ToLocal(const OBB *obb, Vector3 v)
+{
+    return (Vector3){
+        Vector3DotProduct(v, obb->axes[0]),
+        Vector3DotProduct(v, obb->axes[1]),
+        Vector3DotProduct(v, obb->axes[2])};
+}
 
-    *right = (Vector3){rot.m0, rot.m1, rot.m2};    // First column
-    *up = (Vector3){rot.m4, rot.m5, rot.m6};       // Second column
-    *forward = (Vector3){rot.m8, rot.m9, rot.m10}; // Third column
+/**
+ * @brief Express a local-frame direction in world space.
+ */
+inline Vector3 OBB_ToWorld(const OBB *obb, Vector3 v)
+{
+    return Vector3Add(Vector3Add(Vector3Scale(obb->axes[0], v.x),
+                                 Vector3Scale(obb->axes[1], v.y)),
+                      Vector3Scale(obb->axes[2], v.z));
 }
 
 /**
@@ -60,6 +103,22 @@ inline void OBB_GetCorners(const OBB *obb, Vector3 corners[8])
     corners[7] = Vector3Add(Vector3Add(Vector3Add(obb->center, right), Vector3Negate(up)), Vector3Negate(forward));
 }
 
+/**
+ * @brief Compute the tightest world-space AABB enclosing an OBB.
+ */
+inline BoundingBox OBB_GetBoundingBox(const OBB *obb)
+{
+    Vector3 right, up, forward;
+    OBB_GetAxes(obb, &right, &up, &forward);
+
+    Vector3 extent = {
+        fabsf(right.x) * obb->halfExtents.x + fabsf(up.x) * obb->halfExtents.y + fabsf(forward.x) * obb->halfExtents.z,
+        fabsf(right.y) * obb->halfExtents.x + fabsf(up.y) * obb->halfExtents.y + fabsf(forward.y) * obb->halfExtents.z,
+        fabsf(right.z) * obb->halfExtents.x + fabsf(up.z) * obb->halfExtents.y + fabsf(forward.z) * obb->halfExtents.z};
+
+    return (BoundingBox){Vector3Subtract(obb->center, extent), Vector3Add(obb->center, extent)};
+}
+
 /**
  * @brief Draw the OBB wireframe using `DrawLine3D` for debugging.
  */
@@ -89,10 +148,7 @@ inline void OBB_DrawWireframe(const OBB *obb, Color color)
  */
 inline bool OBB_ContainsPoint(const OBB *obb, Vector3 point)
 {
-    Vector3 local = Vector3Subtract(point, obb->center);
-
-    Quaternion inverseRot = QuaternionInvert(obb->rotation);
-    local = Vector3RotateByQuaternion(local, inverseRot);
+    Vector3 local = OBB_ToLocal(obb, Vector3Subtract(point, obb->center));
 
     return fabsf(local.x) <= obb->halfExtents.x &&
            fabsf(local.y) <= obb->halfExtents.y &&
@@ -135,15 +191,12 @@ inline void ProjectBoundingBoxOntoAxis(const BoundingBox *box, Vector3 axis, flo
  */
 inline void ProjectOBBOntoAxis(const OBB *obb, Vector3 axis, float *outMin, float *outMax)
 {
-    Vector3 right, up, forward;
-    OBB_GetAxes(obb, &right, &up, &forward);
-
     float centerProj = Vector3DotProduct(obb->center, axis);
 
     float r =
-        fabsf(Vector3DotProduct(right, axis)) * obb->halfExtents.x +
-        fabsf(Vector3DotProduct(up, axis)) * obb->halfExtents.y +
-        fabsf(Vector3DotProduct(forward, axis)) * obb->halfExtents.z;
+        fabsf(Vector3DotProduct(obb->axes[0], axis)) * obb->halfExtents.x +
+        fabsf(Vector3DotProduct(obb->axes[1], axis)) * obb->halfExtents.y +
+        fabsf(Vector3DotProduct(obb->axes[2], axis)) * obb->halfExtents.z;
 
     *outMin = centerProj - r;
     *outMax = centerProj + r;
@@ -228,9 +281,8 @@ inline CollisionResult GetCollisionOBBvsOBB(const OBB *a, const OBB *b)
 {
     CollisionResult result = {nullptr, true, INFINITY, {0, 0, 0}};
 
-    Vector3 axesA[3], axesB[3];
-    OBB_GetAxes(a, &axesA[0], &axesA[1], &axesA[2]);
-    OBB_GetAxes(b, &axesB[0], &axesB[1], &axesB[2]);
+    const Vector3 *axesA = a->axes;
+    const Vector3 *axesB = b->axes;
 
     Vector3 testAxes[15];
     int axisCount = 0;
@@ -292,10 +344,8 @@ inline RayCollision GetRayCollisionOBB(Ray ray, const OBB *obb)
     RayCollision result = {0};
     result.hit = false;
 
-    Vector3 localOrigin = Vector3Subtract(ray.position, obb->center);
-    Quaternion inverseRot = QuaternionInvert(obb->rotation);
-    Vector3 localRayOrigin = Vector3RotateByQuaternion(localOrigin, inverseRot);
-    Vector3 localRayDir = Vector3RotateByQuaternion(ray.direction, inverseRot);
+    Vector3 localRayOrigin = OBB_ToLocal(obb, Vector3Subtract(ray.position, obb->center));
+    Vector3 localRayDir = OBB_ToLocal(obb, ray.direction);
 
     Vector3 boxMin = Vector3Negate(obb->halfExtents);
     Vector3 boxMax = obb->halfExtents;
@@ -349,7 +399,7 @@ inline RayCollision GetRayCollisionOBB(Ray ray, const OBB *obb)
     result.distance = tmin;
 
     result.point = Vector3Add(ray.position, Vector3Scale(ray.direction, tmin));
-    result.normal = Vector3RotateByQuaternion(normal, obb->rotation);
+    result.normal = OBB_ToWorld(obb, normal);
 
     return result;
 }
@@ -359,16 +409,14 @@ inline RayCollision GetRayCollisionOBB(Ray ray, const OBB *obb)
  */
 inline bool CheckCollisionSphereVsOBB(Vector3 sphereCenter, float radius, const OBB *obb)
 {
-    Vector3 localCenter = Vector3Subtract(sphereCenter, obb->center);
-    Quaternion invRot = QuaternionInvert(obb->rotation);
-    localCenter = Vector3RotateByQuaternion(localCenter, invRot);
+    Vector3 localCenter = OBB_ToLocal(obb, Vector3Subtract(sphereCenter, obb->center));
 
     Vector3 clamped = {
         Clamp(localCenter.x, -obb->halfExtents.x, obb->halfExtents.x),
         Clamp(localCenter.y, -obb->halfExtents.y, obb->halfExtents.y),
         Clamp(localCenter.z, -obb->halfExtents.z, obb->halfExtents.z)};
 
-    Vector3 worldClamped = Vector3RotateByQuaternion(clamped, obb->rotation);
+    Vector3 worldClamped = OBB_ToWorld(obb, clamped);
     worldClamped = Vector3Add(worldClamped, obb->center);
 
     float distSq = Vector3DistanceSqr(sphereCenter, worldClamped);
@@ -403,3 +451,143 @@ inline bool CheckLineSegmentVsOBB(Vector3 start, Vector3 end, float radius, cons
 
     return false;
 }
+
+/**
+ * @brief Result of a swept (continuous) collision query.
+ *
+ * `fraction` is the time of impact along the motion in [0, 1] and `normal`
+ * is the surface normal at first contact. `with` is the entity that was hit,
+ * or nullptr for static geometry.
+ */
+typedef struct SweepHit
+{
+    Entity *with;
+    bool hit;
+    float fraction;
+    Vector3 normal;
+} SweepHit;
+
+/**
+ * @brief Half extents of `a` measured along each axis of `onto`.
+ */
+inline Vector3 OBB_ExtentsAlongAxes(const OBB *a, const OBB *onto)
+{
+    Vector3 extents;
+    for (int i = 0; i < 3; ++i)
+    {
+        (&extents.x)[i] = fabsf(Vector3DotProduct(onto->axes[i], a->axes[0])) * a->halfExtents.x +
+                          fabsf(Vector3DotProduct(onto->axes[i], a->axes[1])) * a->halfExtents.y +
+                          fabsf(Vector3DotProduct(onto->axes[i], a->axes[2])) * a->halfExtents.z;
+    }
+    return extents;
+}
+
+/**
+ * @brief Whether moving `obb` by `delta` in one step can skip over geometry.
+ *
+ * True once the step is longer than the box's smallest half extent, which
+ * is when discrete overlap tests at the end position start missing hits.
+ */
+inline bool OBB_MotionNeedsSweep(const OBB *obb, Vector3 delta)
+{
+    float minHalf = fminf(obb->halfExtents.x, fminf(obb->halfExtents.y, obb->halfExtents.z));
+    return Vector3LengthSqr(delta) > minHalf * minHalf;
+}
+
+/**
+ * @brief Time of impact of a shape moving by `delta` against a static OBB.
+ *
+ * The moving shape is reduced to its center plus `margin`, its extent along
+ * each of `obb`'s axes (the radius for spheres, OBB_ExtentsAlongAxes() for
+ * boxes), and the center is swept against `obb` grown by that margin. This
+ * is exact on faces and conservative near edges and corners.
+ *
+ * A shape that already overlaps at the start hits at fraction 0, with the
+ * normal of the face nearest to its center. With `allowSeparation` it is
+ * not reported while `delta` leaves through that face, so bodies pushed
+ * into a wall by discrete resolution can still move out of it.
+ */
+inline bool SweepCenterVsOBB(Vector3 start, Vector3 delta, Vector3 margin, const OBB *obb, float *outFraction, Vector3 *outNormal, bool allowSeparation = false)
+{
+    Vector3 localStart = OBB_ToLocal(obb, Vector3Subtract(start, obb->center));
+    Vector3 localDelta = OBB_ToLocal(obb, delta);
+
+    int nearestAxis = -1;
+    float nearestDepth = INFINITY;
+    for (int i = 0; i < 3; ++i)
+    {
+        float depth = (&obb->halfExtents.x)[i] + (&margin.x)[i] - fabsf((&localStart.x)[i]);
+        if (depth < 0.0f)
+        {
+            nearestAxis = -1;
+            break;
+        }
+        if (depth < nearestDepth)
+        {
+            nearestDepth = depth;
+            nearestAxis = i;
+        }
+    }
+    if (nearestAxis >= 0)
+    {
+        float sign = (&localStart.x)[nearestAxis] >= 0.0f ? 1.0f : -1.0f;
+        if (allowSeparation && (&localDelta.x)[nearestAxis] * sign >= 0.0f)
+            return false;
+        if (outFraction)
+            *outFraction = 0.0f;
+        if (outNormal)
+            *outNormal = Vector3Scale(obb->axes[nearestAxis], sign);
+        return true;
+    }
+
+    float tEnter = -INFINITY;
+    float tExit = INFINITY;
+    int enterAxis = -1;
+    float enterSign = 0.0f;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        float origin = (&localStart.x)[i];
+        float dir = (&localDelta.x)[i];
+        float half = (&obb->halfExtents.x)[i] + (&margin.x)[i];
+
+        if (fabsf(dir) < 1e-8f)
+        {
+            if (origin < -half || origin > half)
+                return false;
+            continue;
+        }
+
+        float ood = 1.0f / dir;
+        float t1 = (-half - origin) * ood;
+        float t2 = (half - origin) * ood;
+        float sign = -1.0f; // entering through the negative face
+        if (t1 > t2)
+        {
+            float temp = t1;
+            t1 = t2;
+            t2 = temp;
+            sign = 1.0f;
+        }
+
+        if (t1 > tEnter)
+        {
+            tEnter = t1;
+            enterAxis = i;
+            enterSign = sign;
+        }
+        if (t2 < tExit)
+            tExit = t2;
+        if (tEnter > tExit)
+            return false;
+    }
+
+    if (enterAxis < 0 || tEnter < 0.0f || tEnter > 1.0f)
+        return false;
+
+    if (outFraction)
+        *outFraction = tEnter;
+    if (outNormal)
+        *outNormal = Vector3Scale(obb->axes[enterAxis], enterSign);
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+#include "obb.hpp"
+
+/**
+ * @brief Structure-of-arrays block of OBBs for one-vs-many SAT queries.
+ *
+ * Each OBB component lives in its own float array so the batched kernel can
+ * load four boxes per SSE register. Arrays are padded to a multiple of the
+ * lane width with boxes that never collide; `size()` reports real entries.
+ */
+class OBBBatch
+{
+public:
+    static constexpr int LANES = 4;
+
+    void Clear();
+    void Add(const OBB &obb);
+    /**
+     * @brief Append never-colliding entries until the next Add() starts a new lane group.
+     */
+    void AlignToLanes();
+    size_t size() const { return this->count; }
+    bool empty() const { return this->count == 0; }
+
+    /**
+     * @brief Rebuild an OBB (center, extents and axes) from the given entry.
+     */
+    OBB Get(size_t index) const;
+
+private:
+    friend void GetCollisionOBBvsOBBBatch(const OBB *a, const OBBBatch &batch, size_t first, size_t count, CollisionResult *out);
+
+    void AppendEntry(const OBB &obb);
+    void AppendPadding();
+
+    size_t count = 0;
+    std::vector<float> center[3];
+    std::vector<float> halfExtents[3];
+    std::vector<float> axes[3][3]; // axes[axis][component]
+    std::vector<Quaternion> rotations; // Unpadded; only used by Get()
+};
+
+/**
+ * @brief Run the 15-axis SAT test of `a` against every OBB in `batch`.
+ *
+ * `out` is resized to `batch.size()`. For colliding entries, entry i matches
+ * `GetCollisionOBBvsOBB(a, batch.Get(i))`; separated entries report
+ * `collided == false` with zero penetration. Uses SSE lanes with an early-out
+ * once all four lanes found a separating axis, and falls back to the scalar
+ * path when SSE is unavailable.
+ */
+void GetCollisionOBBvsOBBBatch(const OBB *a, const OBBBatch &batch, std::vector<CollisionResult> &out);
+
+/**
+ * @brief Same as above for entries [first, first + count); writes `count` results to `out`.
+ *
+ * `first` must be a multiple of OBBBatch::LANES.
+ */
+void GetCollisionOBBvsOBBBatch(const OBB *a, const OBBBatch &batch, size_t first, size_t count, CollisionResult *out);
+
+/**
+ * @brief Scalar reference implementation of GetCollisionOBBvsOBBBatch().
+ */
+void GetCollisionOBBvsOBBBatchScalar(const OBB *a, const OBBBatch &batch, std::vector<CollisionResult> &out);
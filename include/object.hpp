@@ -5,6 +5,54 @@
 #include <vector>
 class Entity;
 class Scene;
+class BulletProxy;
+
+/**
+ * @brief Owning handle for an Object's persistent Bullet proxy.
+ *
+ * Copies inherit whether a proxy is wanted but never share one, and
+ * assignment leaves the destination's proxy alone so `o = Object(...)` in
+ * entity constructors keeps the entity's setting. The proxy itself is created
+ * lazily by the Scene on the first decoration query.
+ */
+class BulletProxySlot
+{
+public:
+    BulletProxySlot() = default;
+    BulletProxySlot(const BulletProxySlot &other) : enabled(other.enabled) {}
+    BulletProxySlot(BulletProxySlot &&other) noexcept : proxy(other.proxy), enabled(other.enabled) { other.proxy = nullptr; }
+    BulletProxySlot &operator=(const BulletProxySlot &) { return *this; }
+    BulletProxySlot &operator=(BulletProxySlot &&) noexcept { return *this; }
+    ~BulletProxySlot();
+
+    void Enable() { this->enabled = true; }
+    bool IsEnabled() const { return this->enabled; }
+    BulletProxy *get() const { return this->proxy; }
+    void reset(BulletProxy *newProxy);
+
+private:
+    BulletProxy *proxy = nullptr;
+    bool enabled = false;
+};
+
+/**
+ * @brief Collision layer bits.
+ *
+ * Every Object sits on one layer and collision queries only consider layers
+ * in their mask, so unwanted categories are skipped before any narrowphase.
+ * The values fit Bullet's filter groups and are used for them directly.
+ */
+enum CollisionLayer : unsigned int
+{
+    COLLISION_LAYER_WALL = 1u << 0,
+    COLLISION_LAYER_DECORATION = 1u << 1, // Bullet colliders: decorations and doors
+    COLLISION_LAYER_PLAYER = 1u << 2,
+    COLLISION_LAYER_ENEMY = 1u << 3,
+    COLLISION_LAYER_PROJECTILE = 1u << 4,
+    COLLISION_MASK_STATIC = COLLISION_LAYER_WALL | COLLISION_LAYER_DECORATION,
+    COLLISION_MASK_ALL = 0x7FFFu,
+};
+
 /**
  * @brief Simple axis-aligned/rotated 3D box Object used for physics and rendering.
  *
@@ -40,6 +88,12 @@ public:
      * `false` to hide the object while preserving its OBB/collision data.
      */
     bool visible = true;
+    /**
+     * @brief Persistent decoration-contact proxy; entities opt in, temporaries use one-off queries.
+     */
+    mutable BulletProxySlot bulletProxy;
+    unsigned int collisionLayer = COLLISION_LAYER_WALL; // Layer this Object is found on
+    unsigned int collisionMask = COLLISION_MASK_ALL;    // Layers its scene queries consider by default
 
     /**
      * @brief Test collision between two Objects and return a CollisionResult.
@@ -52,10 +106,22 @@ public:
     /**
      * @brief Test collision between this object and all static scene objects.
      *
-     * Returns a vector of CollisionResult entries (may be empty).
+     * Entities are narrowed through the scene broadphase first, so only those
+     * in the same or neighbouring grid cells are tested. Returns a vector of
+     * CollisionResult entries (may be empty). Uses `thiso.collisionMask`.
      */
     static std::vector<CollisionResult> collided(Object &thiso, Scene *scene);
 
+    /**
+     * @brief As above, but only against the CollisionLayer bits set in `mask`.
+     */
+    static std::vector<CollisionResult> collided(Object &thiso, Scene *scene, unsigned int mask);
+
+    /**
+     * @brief As above, but appends to `out` so per-tick callers can reuse its storage.
+     */
+    static void collided(Object &thiso, Scene *scene, unsigned int mask, std::vector<CollisionResult> &out);
+
     /**
      * @brief Recompute the object's OBB from `pos`, `size` and `rotation`.
      *
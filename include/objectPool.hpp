@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Free list of storage blocks for objects of type `T`.
+ *
+ * Acquire() constructs a fresh `T` in a recycled block, so every acquired
+ * object starts from its constructor's state; Release() destroys it and
+ * keeps the block for the next Acquire(). Only an empty free list allocates,
+ * and Reserve() fills it ahead of time. Every acquired object must be
+ * released before the pool is destroyed.
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    ~ObjectPool()
+    {
+        for (void *block : this->freeBlocks)
+        {
+            ::operator delete(block);
+        }
+    }
+
+    template <typename... Args>
+    T *Acquire(Args &&...args)
+    {
+        void *block;
+        if (this->freeBlocks.empty())
+        {
+            block = ::operator new(sizeof(T));
+        }
+        else
+        {
+            block = this->freeBlocks.back();
+            this->freeBlocks.pop_back();
+        }
+        ++this->liveCount;
+        return new (block) T(std::forward<Args>(args)...);
+    }
+
+    void Release(T *obj)
+    {
+        if (!obj)
+            return;
+        obj->~T();
+        this->freeBlocks.push_back(static_cast<void *>(obj));
+        --this->liveCount;
+    }
+
+    /**
+     * @brief Make sure at least `count` objects can be acquired without allocating.
+     */
+    void Reserve(size_t count)
+    {
+        // Room for every block, so releasing never grows the free list either.
+        this->freeBlocks.reserve(this->liveCount + (count > this->freeBlocks.size() ? count : this->freeBlocks.size()));
+        while (this->freeBlocks.size() < count)
+        {
+            this->freeBlocks.push_back(::operator new(sizeof(T)));
+        }
+    }
+
+    size_t freeCount() const { return this->freeBlocks.size(); }
+    size_t liveObjects() const { return this->liveCount; }
+
+private:
+    std::vector<void *> freeBlocks;
+    size_t liveCount = 0;
+};
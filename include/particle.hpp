@@ -30,6 +30,10 @@ public:
     // Main update loop (physics & aging)
     void update(float dt);
 
+    // update() for particles [first, end) only; disjoint ranges may run on different threads
+    void updateRange(float dt, size_t first, size_t end);
+    size_t count() const { return particles.size(); }
+
     // Draw all active particles (const so it can be called from const Scene methods)
     void draw(Camera camera) const;
 
@@ -0,0 +1,234 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include <raylib.h>
+#include "entityRegistry.hpp"
+#include "object.hpp"
+
+class Entity;
+struct UpdateContext;
+
+using ProjectileKindId = int;
+constexpr ProjectileKindId NO_PROJECTILE_KIND = -1;
+
+/**
+ * @brief Why a projectile left the world; passed to ProjectileKind::onImpact.
+ */
+struct ProjectileImpact
+{
+    enum class Reason
+    {
+        Hit,     // Touched a layer in `damages`; the damage has been applied
+        Blocked, // Stopped by a layer in `collidesWith` it does not damage
+        Ground,  // Fell to the kind's ground height
+        Expired  // Ran out of lifetime
+    };
+
+    Reason reason = Reason::Expired;
+    ProjectileKindId kind = NO_PROJECTILE_KIND;
+    Vector3 position = {0.0f, 0.0f, 0.0f}; // Point of contact, or the last position when expired
+    Vector3 velocity = {0.0f, 0.0f, 0.0f};
+    float damage = 0.0f;
+    EntityHandle owner;
+    Entity *hit = nullptr; // Enemy or player that was touched; null for walls, ground and expiry
+};
+
+/**
+ * @brief Explosion burst spawned by a projectile; a `count` of 0 disables it.
+ */
+struct ProjectileBurst
+{
+    int count = 0;
+    Color color = WHITE;
+    float size = 0.0f;
+    float speed = 0.0f;
+    float spread = 0.0f;
+};
+
+/**
+ * @brief Shared tuning of one family of projectiles, registered once with ProjectileWorld::RegisterKind().
+ */
+struct ProjectileKind
+{
+    enum class Shape
+    {
+        Sphere, // Sphere of `radius`
+        Tile    // Textured box of `tileSize` spinning about Y
+    };
+
+    // Motion
+    float gravity = 0.0f;
+    float homingBlend = 0.0f; // Share of the way the heading turns toward the target each tick; 0 disables homing
+    float homingRange = 0.0f; // Lost targets are replaced by the nearest enemy within this distance
+    float wiggleAmplitude = 0.0f; // Peak sine speed added along the wiggle axis; 0 disables the wiggle
+    float wiggleFrequency = 0.0f; // Radians per second
+    bool wiggleVertical = false;  // Wiggle up and down instead of sideways
+
+    // Collision
+    float radius = 0.1f;
+    float lifetime = 5.0f;
+    bool hitsGround = true;
+    float groundHeight = 0.0f; // Center height at which a projectile counts as grounded
+    unsigned int collidesWith = COLLISION_MASK_STATIC | COLLISION_LAYER_ENEMY; // Walls are always included when any bit is set
+    unsigned int damages = COLLISION_LAYER_ENEMY;                              // Subset of `collidesWith`
+    float knockbackSpeed = 0.0f;
+    float knockbackDuration = 0.0f;
+
+    // Effects
+    ProjectileBurst trail;    // Every tick while flying
+    ProjectileBurst hitBurst; // On Reason::Hit
+    ProjectileBurst stopBurst; // On Reason::Blocked and Reason::Ground
+
+    // Visual
+    Shape shape = Shape::Sphere;
+    Texture2D *texture = nullptr; // Not owned; null draws the sphere untextured
+    Rectangle sourceRect = {0.0f, 0.0f, 0.0f, 0.0f}; // Default region of `texture`
+    Color tint = WHITE;
+    Vector3 tileSize = {1.0f, 1.0f, 1.0f};
+    float spinSpeed = 0.0f; // Degrees per second about Y, Tile only
+    bool glow = false;      // Additive glow billboard on top
+
+    /**
+     * @brief Called for every projectile of this kind as it is removed, after its damage was applied.
+     *
+     * May spawn projectiles and record world events. `user` is passed back as is.
+     */
+    void (*onImpact)(void *user, const ProjectileImpact &impact, UpdateContext &uc) = nullptr;
+    void *user = nullptr;
+};
+
+/**
+ * @brief Initial state of one projectile.
+ */
+struct ProjectileSpawn
+{
+    Vector3 position = {0.0f, 0.0f, 0.0f};
+    Vector3 velocity = {0.0f, 0.0f, 0.0f};
+    float damage = 0.0f;
+    EntityHandle owner;  // Enemy that fired it; its own body never stops it
+    EntityHandle target; // Initial homing target
+    Rectangle sourceRect = {0.0f, 0.0f, 0.0f, 0.0f}; // Overrides the kind's region when it has a size
+};
+
+/**
+ * @brief Structure-of-arrays store that simulates every short-lived projectile in one place.
+ *
+ * Attacks and enemies register a ProjectileKind per family and then only
+ * spawn projectiles; they no longer own, move or collide them. Update()
+ * runs once per tick from Scene::Update:
+ *
+ * 1. steering, only for kinds that home or wiggle;
+ * 2. one integration pass over all projectiles (gravity, velocity, life),
+ *    four at a time with SSE;
+ * 3. swept collision against walls, decorations, enemies, the player and
+ *    the ground, split across the job system and writing only per-index
+ *    results. A coarse grid rebuilt first marks where a wall, an enemy or
+ *    the player is within reach, so projectiles in open space skip the
+ *    exact sweeps. Its wall layer is kept, with a margin, and reused
+ *    while the projectiles stay inside it;
+ * 4. serial resolution in index order: damage and knockback (enemy hits
+ *    go through Scene::events), particles, the kind's onImpact hook and
+ *    removal, which keeps the survivors in spawn order.
+ *
+ * Projectiles are not Entities. The previous positions kept for the sweep
+ * also serve render interpolation.
+ */
+class ProjectileWorld
+{
+public:
+    ProjectileKindId RegisterKind(const ProjectileKind &kind);
+    const ProjectileKind &GetKind(ProjectileKindId id) const { return this->kinds[id]; }
+
+    void Spawn(ProjectileKindId kind, const ProjectileSpawn &spawn);
+    /**
+     * @brief Grow every column so `count` projectiles can fly without allocating.
+     */
+    void Reserve(size_t count);
+    void Update(UpdateContext &uc);
+    size_t size() const { return this->posX.size(); }
+
+    // Read access for drawing
+    ProjectileKindId KindOf(size_t i) const { return this->kind[i]; }
+    Vector3 RenderPosition(size_t i, float alpha) const;
+    float Age(size_t i) const { return this->kinds[this->kind[i]].lifetime - this->life[i]; }
+    const Rectangle &SourceRect(size_t i) const { return this->sourceRect[i]; }
+
+private:
+    static constexpr size_t COLLISION_GRAIN = 256;
+    static constexpr float HAZARD_CELL_SIZE = 0.5f;
+    static constexpr int MAX_HAZARD_CELLS = 128; // per axis; cells grow when projectiles spread wider
+    static constexpr float HAZARD_SNAP = 0.125f; // cell size and wall reach are rounded up to this so the wall layer can be kept
+    static constexpr int HAZARD_PADDING = 8;    // cells the kept wall layer extends past the grid on each side
+
+    enum : unsigned char
+    {
+        HIT_NONE,
+        HIT_TARGET,
+        HIT_BLOCKED,
+        HIT_GROUND
+    };
+
+    enum : unsigned char
+    {
+        NEAR_STATIC = 1,
+        NEAR_ENEMY = 2,
+        NEAR_PLAYER = 4
+    };
+
+    std::vector<ProjectileKind> kinds;
+    bool steering = false; // Some registered kind homes or wiggles
+
+    // Hot columns, integrated together
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> prevX, prevY, prevZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> wiggleX, wiggleY, wiggleZ; // Wiggle velocity for this tick
+    std::vector<float> gravity;
+    std::vector<float> life;
+
+    // Cold columns
+    std::vector<ProjectileKindId> kind;
+    std::vector<float> damage;
+    std::vector<float> phase;
+    std::vector<Vector3> wiggleAxis;
+    std::vector<EntityHandle> owner;
+    std::vector<EntityHandle> target;
+    std::vector<Rectangle> sourceRect;
+
+    // Collision results, one entry per projectile
+    std::vector<unsigned char> hitType;
+    std::vector<float> hitFraction;
+    std::vector<Entity *> hitEntity;
+    std::vector<unsigned char> removed;
+    std::vector<std::pair<size_t, size_t>> keptRuns; // Compact() scratch: [begin, end) ranges that survive
+
+    // Coarse XZ cells over this tick's start positions, flagging NEAR_STATIC, NEAR_ENEMY and NEAR_PLAYER
+    // where a wall or decoration, an enemy or the player is within one tick's reach. Projectiles in a
+    // clear cell skip the sweep.
+    struct HazardLayout
+    {
+        float originX = 0.0f;
+        float originZ = 0.0f;
+        float cellSize = HAZARD_CELL_SIZE;
+        float reach = 0.0f;
+        int columns = 0;
+        int rows = 0;
+        unsigned int wallRevision = 0; // StaticWorldBVH::GetRevision() the cells were tested against
+    };
+    HazardLayout hazardLayout;
+    std::vector<unsigned char> hazard;
+    // NEAR_STATIC cells alone, over the grid padded by HAZARD_PADDING cells a side. Later grids
+    // with the same cell size and reach that fit inside copy their wall layer from it.
+    HazardLayout staticHazardLayout;
+    std::vector<unsigned char> staticHazard;
+
+    void Steer(UpdateContext &uc, float delta);
+    void Integrate(float delta);
+    void BuildHazardGrid(UpdateContext &uc, size_t count);
+    unsigned char HazardAt(size_t i) const;
+    void Collide(UpdateContext &uc, size_t first, size_t end);
+    void Resolve(UpdateContext &uc, size_t count);
+    void Compact();
+    template <typename Fn>
+    void ForEachFloatColumn(Fn &&fn);
+};
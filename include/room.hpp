@@ -10,6 +10,7 @@
 #include <btBulletCollisionCommon.h>
 
 #include "collidableModel.hpp"
+#include "lineOfSight.hpp"
 #include "me.hpp"
 
 class Room;  // Forward declaration
@@ -36,11 +37,17 @@ public:
     ~Door();
 
     void Update(float deltaSeconds);
+    // Update() in two steps: Animate() touches only this door and may run on
+    // a worker; SyncCollision() removes the Bullet collider once fully open.
+    void Animate(float deltaSeconds);
+    void SyncCollision();
     void Draw() const;
     void Open();
     void Close();
     bool IsOpen() const { return this->openComplete; }
     bool IsClosed() const { return !this->opening && this->openProgress <= 0.0f; }
+    // Bumped whenever the Bullet collider is added or removed
+    unsigned int GetCollisionRevision() const { return this->collisionRevision; }
     void SetLightingShader(Shader *shader);
     bool IsPlayerNearby(const Vector3 &playerPos, float maxDistance = 3.0f) const;
     Room* GetRoomA() const { return this->roomA; }
@@ -56,6 +63,7 @@ private:
     bool InitializeVisuals();
     void ApplyLighting() const;
     void DisableCollision();
+    void EnableCollision();
     Vector3 TransformPoint(const Vector3 &localPoint) const;
     void DrawLeaf(const LeafVisual &leaf) const;
 
@@ -79,6 +87,7 @@ private:
     bool opening = false;
     bool openComplete = false;
     bool collisionEnabled = true;
+    unsigned int collisionRevision = 0;
     
     // Track which rooms this door connects
     Room *roomA = nullptr;
@@ -93,24 +102,50 @@ enum class RoomType
     Enemy
 };
 
+/**
+ * @brief Area of the level with its doors, its enemies and its simulation state.
+ *
+ * Enemies are bound to the room they stand in (Enemy::setRoom()). The
+ * EnemyManager reports them as they are added, removed or cross into another
+ * room, so the room knows its head count without scanning. A room sleeps while the player is
+ * elsewhere and none of its enemies' projectiles are in flight; the enemies
+ * of a sleeping room are not updated and drop out of the enemy broadphase.
+ */
 class Room
 {
 public:
     Room(std::string name, BoundingBox bounds, RoomType type);
 
     void AttachDoor(Door *door);
-    void Update(const std::vector<Entity *> &enemies);
+    // Returns true when the room became completed during this call
+    bool Update();
+    /**
+     * @brief Decide whether the room simulates this tick; call once per tick before the enemies update.
+     */
+    void UpdateActivity(bool playerInside);
+    /**
+     * @brief Keep the room awake next tick, e.g. while an enemy's bullets are still flying.
+     */
+    void KeepAwake() { this->keepAwake = true; }
+    bool IsAwake() const { return this->awake; }
+    // Head count upkeep: EnemyManager calls these on add/remove and when an enemy walks into another room
+    void OnEnemyAdded();
+    void OnEnemyRemoved();
+    int GetEnemyCount() const { return this->enemyCount; }
     bool IsCompleted() const { return this->completed; }
-    bool IsPlayerInside(const Vector3 &playerPos) const;
+    bool IsPlayerInside(const Vector3 &playerPos) const { return this->Contains(playerPos); }
+    bool Contains(const Vector3 &pos) const;
     RoomType GetType() const { return this->type; }
     const BoundingBox &GetBounds() const { return this->bounds; }
     const std::string &GetName() const { return this->name; }
     std::vector<Door *> GetDoors() const { return this->doors; }
     bool AreEnemiesSpawned() const { return this->enemiesSpawned; }
     void MarkEnemiesSpawned() { this->enemiesSpawned = true; }
+    // Coarse visibility between points of this room, built by the Scene once the static world exists
+    VisibilityField &GetVisibility() { return this->visibility; }
+    const VisibilityField &GetVisibility() const { return this->visibility; }
 
 private:
-    bool ContainsEnemy(const Entity *entity) const;
     void TryOpenDoors();
 
     std::string name;
@@ -119,5 +154,9 @@ private:
     bool hadEnemies = false;
     bool completed = false;
     bool enemiesSpawned = false;
+    bool awake = false;
+    bool keepAwake = false; // Set during the tick, read by the next UpdateActivity()
+    int enemyCount = 0;     // Live enemies bound to this room
     std::vector<Door *> doors;
+    VisibilityField visibility;
 };
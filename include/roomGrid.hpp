@@ -0,0 +1,37 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <raylib.h>
+
+class Room;
+
+/**
+ * @brief Uniform XZ grid answering "which room contains this point" without scanning every room.
+ *
+ * Build() lists, for every cell, the rooms whose bounds overlap it, in the
+ * order the rooms were given. Find() tests only the rooms of the point's
+ * cell and returns the first that contains it, so it agrees with a linear
+ * scan over the same list when rooms overlap along shared walls. Rooms do
+ * not move, so the grid is built once per level.
+ */
+class RoomGrid
+{
+public:
+    explicit RoomGrid(float cellSize = 8.0f);
+
+    void Build(const std::vector<std::unique_ptr<Room>> &rooms);
+    void Clear();
+    Room *Find(const Vector3 &pos) const;
+
+private:
+    float cellSize;
+    float invCellSize;
+    float originX = 0.0f;
+    float originZ = 0.0f;
+    int columns = 0;
+    int rows = 0;
+    std::vector<unsigned int> cellStart; // columns * rows + 1 offsets into cellRooms
+    std::vector<Room *> cellRooms;
+
+    bool CellOf(float x, float z, int &outColumn, int &outRow) const;
+};
@@ -3,14 +3,22 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <mutex>
 #include <raylib.h>
 #include "attackManager.hpp"
 #include "updateContext.hpp"
 #include "enemyManager.hpp"
 #include "collidableModel.hpp"
 #include "room.hpp"
+#include "roomGrid.hpp"
 #include "rewardBriefcase.hpp"
 #include "particle.hpp"
+#include "worldEvents.hpp"
+#include "projectileWorld.hpp"
+#include "staticWorldBVH.hpp"
+#include "lineOfSight.hpp"
+#include "bulletProxy.hpp"
+#include "contactSolver.hpp"
 
 struct DamageIndicator
 {
@@ -48,6 +56,7 @@ class Scene
 {
 private:
     std::vector<Object *> objects; // List of static objects in the scene (e.g., towers, obstacles)
+    StaticWorldBVH staticWorld;    // Immutable BVH over walls and decoration colliders
     Object floor;                  // Represents the floor of the scene
     Texture2D wallTexture{};       // Procedural room walls texture
     Texture2D floorTexture{};      // Procedural room floor texture
@@ -70,16 +79,26 @@ private:
     std::unique_ptr<btCollisionDispatcher> bulletDispatcher;
     std::unique_ptr<btBroadphaseInterface> bulletBroadphase;
     std::unique_ptr<btCollisionWorld> bulletWorld;
+    mutable std::mutex bulletQueryMutex;   // Bullet queries share broadphase scratch; enemies think in parallel
+    mutable BulletProxyPool entityProxies; // Persistent ghosts for entity-vs-decoration contacts
+    mutable LineOfSightCache lineOfSight;  // Memoized CheckStaticSweep() results, reset when doors change
+    ContactSolver contactSolver;           // Resolves entity overlaps once per tick
 
     std::vector<std::unique_ptr<Room>> rooms;
+    RoomGrid roomGrid; // XZ lookup over `rooms`, rebuilt with them
     std::vector<std::unique_ptr<Door>> doors;
     std::vector<std::unique_ptr<RewardBriefcase>> rewardBriefcases;
     DamageIndicatorSystem damageIndicators;
     Room *currentPlayerRoom = nullptr;
+    std::vector<std::pair<Entity *, Vector3>> renderInterpolated; // entity and its simulated position while drawing
+    float renderAlpha = 1.0f;                                     // Blend factor of the current BeginRenderInterpolation()
+    Texture2D enemyBulletTexture{};                               // Shared by every ShooterEnemy bullet
 
     // Helper function to draw a 3D rectangle (cube) for an object
     void DrawRectangle(const Object &o) const;
     void DrawSphereObject(const Object &o) const;
+    void DrawSphereModel(const Vector3 &position, float radius, const Texture2D *texture, Color tint) const;
+    void DrawProjectiles() const;
     void DrawCubeTexture(Texture2D texture, Vector3 position, float width, float height, float length, Color color) const;                      // Draw cube textured
     void DrawCubeTextureRec(Texture2D texture, Rectangle source, Vector3 position, float width, float height, float length, Color color) const; // Draw cube with a region of a texture
     void DrawTexturedSphere(Texture2D &texture, const Rectangle &source, const Vector3 &position, float radius, Color tint) const;
@@ -87,7 +106,6 @@ private:
     void InitializeLighting();
     void ShutdownLighting();
     void CreatePointLight(Vector3 position, Color color, float intensity = 1.0f);
-    float GetFloorTop() const;
     CollidableModel *AddDecoration(const char *modelPath,
                                    Vector3 desiredPosition,
                                    float targetHeight,
@@ -103,12 +121,16 @@ private:
     void ShutdownBulletWorld();
     void RemoveDecorationColliders();
     void AppendDecorationCollisions(const Object &obj, std::vector<CollisionResult> &out) const;
+    SweepHit Sweep(Vector3 start, Vector3 delta, const OBB *box, float radius, const Entity *ignore, bool includeEnemies);
+    void SweepDecorations(Vector3 start, Vector3 delta, const OBB *box, float radius, SweepHit &closest) const;
     static btTransform BuildBtTransform(const Object &obj);
     static btCollisionShape *CreateShapeFromObject(const Object &obj);
-    void UpdateRooms(const std::vector<Entity *> &enemies);
+    void UpdateIndependentSystems(UpdateContext &uc); // Particles, doors and damage numbers as parallel jobs, then rooms
+    void SpawnRoomReward(const Room &room);
     void DrawDoors() const;
     std::unique_ptr<CollidableModel> DetachDecoration(CollidableModel *target);
     void BuildDoorNetwork(const std::vector<Vector3> &roomCenters, float roomWidth, float roomLength, float wallThickness);
+    void BuildRoomVisibility(); // Needs the static world and the doors in place; sweeps with every door open
     void CreateDoorBetweenRooms(const Vector3 &doorCenter, float rotationYDeg, int roomA, int roomB);
     void PopulateRoomEnemies(const std::vector<Vector3> &roomCenters);
     void SpawnEnemiesForRoom(Room *room, const Vector3 &roomCenter);
@@ -118,6 +140,8 @@ public:
     AttackManager am; // Manages all attacks in the scene
     EnemyManager em;
     ParticleSystem particles; // Particle system for visual effects
+    WorldEventQueue events; // Damage, knockback, spawns and hit effects recorded during the tick
+    ProjectileWorld projectiles; // Bullets, pellets and orbs fired by attacks and enemies
     Model cubeModel; // Shared cube model used to render rotated cubes
     Model sphereModel; // Shared sphere model used to render spheres
     Texture2D glowTexture{}; // Texture for the glow effect on bullets
@@ -139,10 +163,26 @@ public:
     /**
      * @brief Advance scene simulation: update enemies, attacks and other systems.
      *
-     * @param uc Frame update context (scene, player, input snapshot).
+     * @param uc Tick update context (scene, player, input snapshot, step length).
      */
     void Update(UpdateContext &uc);
 
+    /**
+     * @brief Snapshot every entity position before a simulation tick.
+     */
+    void StorePreviousPositions(Entity *player);
+
+    /**
+     * @brief Move the player and all entities to positions blended between the
+     * last two ticks for drawing. Pair with EndRenderInterpolation().
+     */
+    void BeginRenderInterpolation(Entity *player, float alpha);
+
+    /**
+     * @brief Restore the simulated positions moved by BeginRenderInterpolation().
+     */
+    void EndRenderInterpolation();
+
     /**
      * @brief Construct a new Scene with default objects and managers.
      */
@@ -152,14 +192,72 @@ public:
      * @brief Return the vector of static objects placed in the scene.
      */
     std::vector<Object *> getStaticObjects() const;
+    const StaticWorldBVH &GetStaticWorld() const { return this->staticWorld; }
+    float GetFloorTop() const; // Height enemies are spawned standing on
     void CollectDecorationCollisions(const Object &obj, std::vector<CollisionResult> &out) const { this->AppendDecorationCollisions(obj, out); }
     bool CheckDecorationCollision(const Object &obj) const;
     bool CheckDecorationSweep(const Vector3 &start, const Vector3 &end, float radius) const;
+    /**
+     * @brief Sweep a sphere against walls and decorations.
+     *
+     * Wall hits closer than `ignoreDistance` are skipped. Bullet is only
+     * queried when the sweep passes through an enabled decoration's bounds.
+     * Safe to call from several threads at once (Enemy::Think()).
+     */
+    bool CheckStaticSweep(const Vector3 &start, const Vector3 &end, float radius, float ignoreDistance = 0.0f) const;
+    /**
+     * @brief CheckStaticSweep() through the line-of-sight cache.
+     *
+     * Results are shared by all sweeps whose end points fall in the same
+     * one-meter cells and are dropped whenever a door collider changes. Use
+     * it for repeated visibility probes, not for movement.
+     */
+    bool CheckStaticSweepCached(const Vector3 &start, const Vector3 &end, float radius, float ignoreDistance = 0.0f) const;
+
+    /**
+     * @brief Time of impact for a sphere moving from `start` by `delta`.
+     *
+     * Tests walls, decorations and (when `includeEnemies`) enemies, skipping
+     * `ignore`. Use for movers that travel farther than their own size in one
+     * step so they cannot tunnel through thin geometry. A sphere that starts
+     * inside a wall or an enemy hits it at fraction 0, so point-blank shots
+     * and enemies stepping onto a projectile still connect.
+     */
+    SweepHit SweepSphere(Vector3 start, Vector3 delta, float radius, const Entity *ignore = nullptr, bool includeEnemies = true);
+
+    /**
+     * @brief Time of impact for `box` translated by `delta`; see SweepSphere().
+     *
+     * Unlike spheres, a box that starts overlapping something is not stopped
+     * while it moves back out, so bodies left in contact can separate.
+     */
+    SweepHit SweepOBB(const OBB &box, Vector3 delta, const Entity *ignore = nullptr, bool includeEnemies = true);
+
+    /**
+     * @brief Collide-and-slide `box` along `delta` against walls and decorations.
+     *
+     * Each blocking hit advances the box to the contact and clips the rest of
+     * the motion against the hit plane (or the crease of two planes), so the
+     * whole move costs at most a few sweeps. When `velocity` is given it is
+     * clipped against the same planes. Returns the displacement actually made.
+     */
+    Vector3 SlideOBB(const OBB &box, Vector3 delta, const Entity *ignore = nullptr, Vector3 *velocity = nullptr);
+
+    /**
+     * @brief Call `visit` with every entity of category `cat` in the scene (projectiles, then enemies).
+     *
+     * Enemies are walked through `EnemyManager::getEnemies()`, so `visit` may damage or remove them.
+     */
+    void visitEntities(EntityCategory cat, Visitor<Entity> visit);
 
     /**
-     * @brief Return a list of entity pointers currently in the scene.
+     * @brief Broadphase: call `visit` with entities that may overlap `bounds`.
+     *
+     * Enemies come from the EnemyManager grid (same or neighbouring cells);
+     * the short-lived projectiles are all visited. Sources whose layer is
+     * not in `mask` are skipped entirely.
      */
-    std::vector<Entity *> getEntities(EntityCategory cat = ENTITY_ALL);
+    void QueryCollisionCandidates(const BoundingBox &bounds, Visitor<Entity> visit, unsigned int mask = COLLISION_MASK_ALL);
     void SetViewPosition(const Vector3 &viewPosition);
     Color getSkyColor() const { return this->skyColor; }
     void EmitDamageIndicator(const Enemy &enemy, float damageAmount);
@@ -170,6 +268,6 @@ public:
     std::vector<RewardBriefcase *> GetRewardBriefcases();
     Room *GetCurrentPlayerRoom() const { return this->currentPlayerRoom; }
     // Return the room that contains the given world position, or nullptr
-    // if the position is not inside any room.
+    // if the position is not inside any room. Constant time via the room grid.
     Room *GetRoomContainingPosition(const Vector3 &pos) const;
 };
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include "constant.hpp"
+
+/**
+ * @brief Fixed-timestep accumulator that decouples simulation from render rate.
+ *
+ * Each render frame feeds its elapsed time to `Advance()`, which returns how
+ * many fixed ticks to simulate. At most `maxSubsteps` ticks run per frame;
+ * any backlog beyond that is dropped so a hitch slows the game down instead
+ * of spiralling. `Alpha()` is the leftover fraction of a tick, used to blend
+ * renderable state between the last two ticks.
+ */
+class SimulationClock
+{
+public:
+    explicit SimulationClock(float tickRateHz = SIMULATION_HZ, int maxSubsteps = MAX_SIMULATION_SUBSTEPS);
+
+    /**
+     * @brief Accumulate `frameSeconds` and return the number of ticks to run.
+     */
+    int Advance(float frameSeconds);
+
+    void SetMaxSubsteps(int maxSubsteps);
+    float Step() const { return this->step; }
+    float Alpha() const { return this->accumulator / this->step; }
+
+private:
+    float step;
+    int maxSubsteps;
+    float accumulator = 0.0f;
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <raylib.h>
+#include "visitor.hpp"
+
+class Entity;
+
+/**
+ * @brief Uniform XZ grid used as the broadphase for entity collision queries.
+ *
+ * Entities are binned by the cell that contains their OBB center. `Rebuild()`
+ * performs a counting sort into a fixed-size bucket table, so once the
+ * internal arrays have grown it does not allocate. `Query()` visits every
+ * cell overlapping the query bounds grown by the largest inserted half
+ * extent plus one cell of slack, which means bodies that moved a little
+ * since the last rebuild are still reported as candidates. Cells outside
+ * the range holding binned entities are never hashed, and neither are
+ * cells a small wrapped occupancy bitmap knows to be empty.
+ *
+ * Entities added between rebuilds are kept in a small pending list that is
+ * always returned by queries until the next rebuild.
+ */
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(float cellSize = 4.0f);
+
+    /**
+     * @brief Re-bin the given entities from their current OBBs.
+     */
+    template <typename T>
+    void Rebuild(const std::vector<T *> &entities)
+    {
+        this->BeginRebuild(entities.size());
+        for (T *e : entities)
+            this->Stage(e);
+        this->EndRebuild();
+    }
+
+    /**
+     * @brief Track an entity created since the last rebuild.
+     *
+     * If `e` reuses the address of an entity removed since then, the old
+     * binned entry is dropped so queries only report the new one.
+     */
+    void Insert(Entity *e);
+
+    /**
+     * @brief Forget an entity (call before it is deleted). O(1) for binned entities.
+     */
+    void Remove(Entity *e);
+
+    void Clear();
+
+    /**
+     * @brief Call `visit` with every entity that may overlap `bounds`.
+     *
+     * Results are conservative; callers still run a narrowphase test.
+     */
+    void Query(const BoundingBox &bounds, Visitor<Entity> visit) const;
+
+private:
+    struct Entry
+    {
+        Entity *entity;
+        int cellX;
+        int cellZ;
+    };
+
+    static constexpr unsigned int BUCKET_COUNT = 1024; // power of two
+    static constexpr int MAX_QUERY_SPAN = 32;          // cells per axis before falling back to a full scan
+    static constexpr int OCCUPANCY_SIZE = 64;          // occupancy bitmap wraps every 64 cells per axis
+
+    float cellSize;
+    float invCellSize;
+    float maxHalfExtent = 0.0f;
+    int minCellX = 0; // cell range holding binned entries; empty when min > max
+    int maxCellX = -1;
+    int minCellZ = 0;
+    int maxCellZ = -1;
+    std::vector<Entry> staged;
+    std::vector<Entry> entries;            // sorted by bucket
+    std::vector<unsigned int> bucketStart; // BUCKET_COUNT + 1 offsets into entries
+    std::vector<unsigned int> scatterCursor;
+    std::vector<uint64_t> occupancy; // one row of bits per wrapped cellZ; a set bit may hold entries
+    std::vector<Entity *> pending;
+    std::vector<const Entity *> removed; // removed since the last rebuild; usually empty
+
+    void BeginRebuild(size_t expectedCount);
+    void Stage(Entity *e);
+    void EndRebuild();
+    int CellCoord(float v) const;
+    static unsigned int HashCell(int cellX, int cellZ);
+    float HalfExtentOf(const Entity *e) const;
+    bool IsRemoved(const Entity *e) const;
+};
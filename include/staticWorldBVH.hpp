@@ -0,0 +1,136 @@
+#pragma once
+#include <vector>
+#include <raylib.h>
+#include <btBulletCollisionCommon.h>
+#include "obbBatch.hpp"
+#include "visitor.hpp"
+
+class Object;
+
+/**
+ * @brief Immutable bounding-volume hierarchy over the static world.
+ *
+ * Built once from the wall Objects and the Bullet colliders of static
+ * decorations (including doors). Walls are tested exactly against their
+ * OBBs; each leaf owns one four-lane block of an OBBBatch so box queries use
+ * the batched SAT kernel. Decorations are triangle meshes, so the tree only
+ * stores their bounds: queries report `touchesCollider` when an enabled
+ * collider's bounds are hit and the caller refines that with Bullet.
+ *
+ * All queries visit O(log n) nodes for small query volumes. A coarse XZ
+ * occupancy grid built alongside the tree lets small queries out in open
+ * floor space return before touching it at all.
+ */
+class StaticWorldBVH
+{
+public:
+    void Build(const std::vector<Object *> &walls, const std::vector<const btCollisionObject *> &colliders);
+    void Clear();
+    bool empty() const { return this->nodes.empty(); }
+
+    /**
+     * @brief SAT-test `box` against nearby walls, appending hits to `wallHits`.
+     */
+    void OverlapOBB(const OBB &box, std::vector<CollisionResult> &wallHits, bool *touchesCollider = nullptr) const;
+
+    /**
+     * @brief Call `visitWall` with each wall whose OBB intersects the sphere.
+     */
+    void OverlapSphere(Vector3 center, float radius, Visitor<Object> visitWall, bool *touchesCollider = nullptr) const;
+
+    /**
+     * @brief Sweep a sphere from `start` to `end` against the walls.
+     *
+     * Hits closer than `ignoreDistance` along the segment are skipped (used
+     * to ignore the wall a shooter is standing against). Returns true as soon
+     * as a blocking wall is found.
+     */
+    bool SweepSphere(Vector3 start, Vector3 end, float radius, float ignoreDistance = 0.0f, bool *touchesCollider = nullptr) const;
+
+    /**
+     * @brief Closest wall hit along `ray` within `maxDistance`.
+     */
+    RayCollision Raycast(Ray ray, float maxDistance, bool *touchesCollider = nullptr) const;
+
+    /**
+     * @brief Earliest wall hit for a sphere moving from `start` by `delta`.
+     *
+     * A sphere that starts inside a wall hits it at fraction 0.
+     */
+    SweepHit CastSphere(Vector3 start, Vector3 delta, float radius, bool *touchesCollider = nullptr) const;
+
+    /**
+     * @brief Earliest wall hit for `box` translated by `delta`.
+     *
+     * A box that starts inside a wall hits it at fraction 0 unless it is
+     * moving back out (see SweepCenterVsOBB()).
+     */
+    SweepHit CastOBB(const OBB &box, Vector3 delta, bool *touchesCollider = nullptr) const;
+
+    /**
+     * @brief Cheap conservative test: false only when no wall or collider bounds reach the XZ footprint of `query`.
+     *
+     * Footprints wider than a few occupancy cells always return true.
+     */
+    bool MayTouch(const BoundingBox &query) const;
+
+    /**
+     * @brief Bumped by every Build(), so callers can cache answers about the walls.
+     */
+    unsigned int GetRevision() const { return this->revision; }
+
+private:
+    struct Node
+    {
+        BoundingBox bounds;
+        int left = -1;  // child indices; -1 for leaves
+        int right = -1;
+        int firstWall = 0; // leaf: first entry in wallBatch (lane aligned)
+        int wallCount = 0;
+        int firstCollider = 0; // leaf: first entry in colliders
+        int colliderCount = 0;
+    };
+
+    struct BuildItem
+    {
+        BoundingBox bounds;
+        Vector3 centroid;
+        Object *wall;
+        const btCollisionObject *collider;
+    };
+
+    struct ColliderEntry
+    {
+        BoundingBox bounds;
+        const btCollisionObject *collider;
+    };
+
+    static constexpr int LEAF_SIZE = OBBBatch::LANES;
+    static constexpr int MAX_DEPTH = 64;
+    static constexpr float OCCUPANCY_CELL_SIZE = 2.0f;
+    static constexpr int MAX_OCCUPANCY_SPAN = 8; // cells per axis before a query just walks the tree
+
+    std::vector<Node> nodes;
+    OBBBatch wallBatch;
+    std::vector<Object *> wallObjects; // parallel to wallBatch; nullptr for padding
+    std::vector<ColliderEntry> colliders;
+    float originX = 0.0f;
+    float originZ = 0.0f;
+    int columns = 0;
+    int rows = 0;
+    std::vector<unsigned char> occupied; // columns * rows; set where any wall or collider bounds reach
+    unsigned int revision = 0;
+
+    int BuildRecursive(std::vector<BuildItem> &items, int begin, int end);
+    void BuildOccupancy(const std::vector<BuildItem> &items);
+    bool CellRange(const BoundingBox &box, int &c0, int &r0, int &c1, int &r1) const;
+    bool TouchesEnabledCollider(const Node &leaf, const BoundingBox &query) const;
+    SweepHit Cast(Vector3 start, Vector3 delta, const OBB *box, float radius, bool *touchesCollider) const;
+
+    /**
+     * @brief Visit the leaves whose bounds pass `overlaps`; skipped entirely when
+     * the occupancy grid has nothing under `reach`.
+     */
+    template <typename OverlapFn, typename LeafFn>
+    void Traverse(const BoundingBox &reach, OverlapFn &&overlaps, LeafFn &&visitLeaf) const;
+};
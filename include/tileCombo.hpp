@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "tiles.hpp"
+
+// Suits, winds and dragons: DOT_1 .. DRAGON_WHITE
+constexpr int PLAYABLE_TILE_TYPES = static_cast<int>(TileType::DRAGON_WHITE) + 1;
+
+/**
+ * @brief Attack a slot's tiles activate.
+ */
+enum class TileCombo : unsigned char
+{
+    None,         // Empty slot or no valid first tile
+    DefaultThrow, // Valid first tile that forms no combo
+    GravityWell,    // Dot 1-1-1
+    OrbitalShield,  // Dot 2-2-2
+    ChainLightning, // Dot 1-2-3
+    BambooTriple,   // Bamboo 1-1-1
+    BambooBomb,     // Bamboo 2-2-2
+    FanShot,        // Bamboo 1-2-3
+    SeismicSlam,    // Character 2-2-2
+    Melee,          // Any other Character triplet
+    Dash            // Any Character run
+};
+
+/**
+ * @brief How many tiles of each playable TileType a combo holds.
+ */
+using TileCounts = std::array<unsigned char, PLAYABLE_TILE_TYPES>;
+
+/**
+ * @brief Classify the tiles of an attack slot.
+ *
+ * Only the first three entries form combos, in any order. Their multiset
+ * is ranked into a table generated at compile time from TileCounts rules,
+ * so this is a sort of three ints plus one lookup.
+ */
+TileCombo ClassifyTileCombo(const std::vector<SlotTileEntry> &tiles);
+
+/**
+ * @brief Display name of `combo`; "NA" for TileCombo::None.
+ */
+const char *TileComboName(TileCombo combo);
+
+/**
+ * @brief True for combos a skill slot may hold; empty slots and single throws are not combos.
+ */
+inline bool IsSkillCombo(TileCombo combo) { return combo != TileCombo::None && combo != TileCombo::DefaultThrow; }
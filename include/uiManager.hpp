@@ -130,6 +130,10 @@ public:
     bool consumeResumeRequest();
     bool consumeQuitRequest();
     const std::vector<SlotTileEntry> &getSlotEntries(int slotIndex) const;
+    /**
+     * @brief Counter bumped whenever the slot's tiles change; lets callers cache what they derive from them.
+     */
+    unsigned int getSlotRevision(int slotIndex) const { return isValidSlotIndex(slotIndex) ? slotRevisions[slotIndex] : 0; }
 
     void setRewardBriefcaseUIOpen(bool open) { this->briefcaseUIOpen = open; }
     bool isRewardBriefcaseUIOpen() const { return this->briefcaseUIOpen; }
@@ -202,6 +206,7 @@ private:
     std::array<AttackSlotElement *, slotCount> slotElements{}; // Owned UI wrappers for each slot
     std::array<float, slotCount> slotCooldowns{};
     std::array<bool, slotCount> slotValid{};
+    std::array<unsigned int, slotCount> slotRevisions{};
     static const char *slotKeyLabels[slotCount];
     bool slotsInitialized = false;
     bool isDraggingTile = false;
@@ -4,6 +4,7 @@
 class Scene;
 class Me;
 class UIManager; // added forward declaration
+class JobSystem;
 
 /**
  * @brief Snapshot of player input for a single frame.
@@ -26,9 +27,13 @@ typedef struct PlayerInput
  * The `UpdateContext` aggregates references to the `Scene`, the `player`
  * entity, the current `PlayerInput` snapshot and an optional `UIManager`
  * pointer for systems that require UI state (selected tile, textures).
+ * `deltaTime` is the length of the step being simulated; systems read it
+ * instead of `GetFrameTime()` so results do not depend on render rate.
+ * `jobs` is the scheduler created at startup (never null) for work that
+ * can be spread across cores.
  *
- * Construct one per frame in `main()` and pass by reference to scene,
- * entity and manager update methods.
+ * Construct one per simulation tick in `main()` and pass by reference to
+ * scene, entity and manager update methods.
  */
 typedef struct UpdateContext
 {
@@ -36,6 +41,8 @@ typedef struct UpdateContext
     Me *const player;
     PlayerInput playerInput;
     UIManager *uiManager; // pointer to UI manager so systems can access UI state (selected tile / textures)
+    float deltaTime;      // seconds covered by this update
+    JobSystem *const jobs;
 
-    UpdateContext(Scene *s, Me *p, PlayerInput pi, UIManager *ui = nullptr) : scene(s), player(p), playerInput(pi), uiManager(ui) {}
+    UpdateContext(Scene *s, Me *p, PlayerInput pi, UIManager *ui, float dt, JobSystem *j) : scene(s), player(p), playerInput(pi), uiManager(ui), deltaTime(dt), jobs(j) {}
 } UpdateContext;
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief Non-owning callback that receives a `T *`, with no heap allocation.
+ *
+ * Wraps any callable by reference (usually a lambda at the call site), so a
+ * Visitor must not outlive the callable it was built from. Used to walk
+ * entities and objects in place instead of copying them into a vector.
+ */
+template <typename T>
+class Visitor
+{
+public:
+    template <typename Fn, typename = std::enable_if_t<!std::is_same<std::decay_t<Fn>, Visitor>::value>>
+    Visitor(Fn &&fn)
+        : context((void *)std::addressof(fn)),
+          call([](void *ctx, T *item) { (*static_cast<std::remove_reference_t<Fn> *>(ctx))(item); })
+    {
+    }
+
+    void operator()(T *item) const { this->call(this->context, item); }
+
+private:
+    void *context;
+    void (*call)(void *, T *);
+};
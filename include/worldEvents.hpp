@@ -0,0 +1,112 @@
+#pragma once
+#include <mutex>
+#include <vector>
+#include <raylib.h>
+#include "entityRegistry.hpp"
+
+class Enemy;
+struct UpdateContext;
+
+/**
+ * @brief Particle burst recorded for a later flush; mirrors the ParticleSystem spawn calls.
+ */
+struct ParticleRequest
+{
+    enum class Kind
+    {
+        Explosion,
+        Directional,
+        Spiral,
+        Ring
+    };
+
+    Kind kind = Kind::Explosion;
+    Vector3 center = {0.0f, 0.0f, 0.0f};
+    Vector3 direction = {0.0f, 0.0f, 0.0f}; // Directional only
+    int count = 0;
+    Color color = WHITE;
+    float size = 0.0f;   // Explosion only
+    float speed = 0.0f;
+    float spread = 0.0f; // Explosion and Directional
+    float radius = 0.0f; // Spiral and Ring
+    float height = 0.0f; // Spiral only
+    bool upward = false; // Ring only
+    EntityHandle ifAlive; // When set, dropped if this enemy died during the flush
+
+    static ParticleRequest Explosion(Vector3 center, int count, Color color, float size, float speed, float spread);
+    static ParticleRequest Directional(Vector3 center, Vector3 direction, int count, Color color, float speed, float spread);
+    static ParticleRequest Spiral(Vector3 center, float radius, int count, Color color, float height, float speed);
+    static ParticleRequest Ring(Vector3 center, float radius, int count, Color color, float speed, bool upward);
+};
+
+/**
+ * @brief Gameplay side effects recorded during an update and applied at sync points.
+ *
+ * Attacks and enemies record damage, knockback, stun, spawn, despawn and
+ * particle requests here instead of changing the world in the middle of a
+ * loop over it. Scene::Update calls Flush() after the enemies and after the
+ * attacks have updated. Recording is thread-safe, so update phases may run
+ * concurrently.
+ *
+ * Events aimed at the same enemy are merged per flush and applied once:
+ * damage is summed into a single hit, knockback pushes add up while lift and
+ * duration keep the maximum (as Enemy::applyKnockback does), and stun and
+ * electrocute keep the longest duration. Status effects are applied after
+ * the damage and dropped for enemies it killed.
+ */
+class WorldEventQueue
+{
+public:
+    void Damage(const Enemy *target, float amount);
+    void Knockback(const Enemy *target, const Vector3 &push, float durationSeconds, float lift = 0.0f);
+    void Stun(const Enemy *target, float durationSeconds);
+    void Electrocute(const Enemy *target, float durationSeconds);
+    /**
+     * @brief Hand over an enemy from EnemyManager::createEnemy(); it joins the manager at the next flush.
+     */
+    void Spawn(Enemy *enemy);
+    void Despawn(EntityHandle handle);
+    void Particles(const ParticleRequest &request);
+
+    /**
+     * @brief Apply everything recorded so far: spawns, merged enemy effects, despawns, then particles.
+     *
+     * Events recorded while flushing (for example by Enemy::OnDeath) are
+     * applied in the same call.
+     */
+    void Flush(UpdateContext &uc);
+
+private:
+    struct EnemyEffect
+    {
+        EntityHandle target;
+        unsigned int sequence = 0; // Recording order, keeps the merge deterministic
+        float damage = 0.0f;
+        Vector3 push = {0.0f, 0.0f, 0.0f};
+        float knockbackDuration = 0.0f;
+        float lift = 0.0f;
+        float stun = 0.0f;
+        float electrocute = 0.0f;
+    };
+
+    struct Batch
+    {
+        std::vector<EnemyEffect> effects;
+        std::vector<Enemy *> spawns;
+        std::vector<EntityHandle> despawns;
+        std::vector<ParticleRequest> particles;
+
+        bool empty() const { return effects.empty() && spawns.empty() && despawns.empty() && particles.empty(); }
+        void clear();
+    };
+
+    static constexpr int MAX_FLUSH_ROUNDS = 4;
+
+    std::mutex mutex; // Guards `pending` and `nextSequence`
+    Batch pending;
+    Batch applying; // Swapped with `pending` by Flush(); keeps its capacity between ticks
+    unsigned int nextSequence = 0;
+
+    void RecordEffect(const Enemy *target, EnemyEffect effect);
+    void Apply(UpdateContext &uc);
+};
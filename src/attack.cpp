@@ -24,7 +24,7 @@ void BambooBasicBuffAttack::trigger(UpdateContext &uc)
 
 void BambooBasicBuffAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
 
     if (this->cooldownRemaining > 0.0f)
     {
@@ -104,45 +104,35 @@ void BambooBasicAttack::spawnProjectile(UpdateContext &uc)
         spawnPos.y += 1.0f;
     }
 
-    Vector3 velocity = Vector3Scale(forward, shootSpeed);
-
-    // Create projectile object with same proportions as enemy tiles (44, 60, 30) but smaller
+    // Same proportions as enemy tiles (44, 60, 30) but smaller
     Vector3 tileSize = Vector3Scale({44.0f, 60.0f, 30.0f}, projectileSize);
-    Object body(tileSize, spawnPos);
-    body.setRotationFromForward(forward);
-    body.useTexture = uc.uiManager != nullptr;
-    if (uc.uiManager)
+    if (this->projectileKind == NO_PROJECTILE_KIND)
+    {
+        ProjectileKind kind;
+        kind.radius = (tileSize.x + tileSize.y + tileSize.z) / 6.0f; // Mean half extent of the spinning tile
+        kind.lifetime = projectileLifetime;
+        kind.groundHeight = 0.1f;
+        kind.shape = ProjectileKind::Shape::Tile;
+        kind.tileSize = tileSize;
+        kind.spinSpeed = horizontalSpinSpeed;
+        kind.texture = uc.uiManager ? &uc.uiManager->muim.getSpriteSheet() : nullptr;
+        this->projectileKind = uc.scene->projectiles.RegisterKind(kind);
+    }
+
+    ProjectileSpawn projectile;
+    projectile.position = spawnPos;
+    projectile.velocity = Vector3Scale(forward, shootSpeed);
+    projectile.damage = tileDamage;
+    if (this->spawnedBy->category() == ENTITY_ENEMY)
     {
-        TileType tileType = TileType::BAMBOO_1;
-        if (uc.player)
-        {
-            tileType = uc.uiManager->muim.getSelectedTile(uc.player->hand);
-        }
-        body.texture = &uc.uiManager->muim.getSpriteSheet();
-        body.sourceRect = uc.uiManager->muim.getTile(tileType);
-        body.tint = WHITE;
+        projectile.owner = this->spawnedBy->getHandle();
     }
-    body.UpdateOBB();
-
-    TileType tile = TileType::BAMBOO_1;
-    if (uc.uiManager && uc.player)
+    if (uc.uiManager)
     {
-        tile = uc.uiManager->muim.getSelectedTile(uc.player->hand);
+        TileType tileType = uc.player ? uc.uiManager->muim.getSelectedTile(uc.player->hand) : TileType::BAMBOO_1;
+        projectile.sourceRect = uc.uiManager->muim.getTile(tileType);
     }
-    Projectile projectile(
-        spawnPos,
-        velocity,
-        forward,
-        false,
-        body,
-        FRICTION,
-        AIR_DRAG,
-        tile);
-    
-    // Store the damage in the projectile (we'll need to add a field for this)
-    projectile.damage = tileDamage;
-
-    this->projectiles.push_back(projectile);
+    uc.scene->projectiles.Spawn(this->projectileKind, projectile);
 
     // Start cooldown (modified by active cooldown modifier and tile stats)
     this->cooldownRemaining = tileCooldown * this->activeCooldownModifier;
@@ -157,79 +147,13 @@ void BambooBasicAttack::spawnProjectile(UpdateContext &uc)
 
 void BambooBasicAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     
     // Update cooldown
     if (this->cooldownRemaining > 0.0f)
     {
         this->cooldownRemaining = fmaxf(0.0f, this->cooldownRemaining - delta);
     }
-    
-    // Update all projectiles without physics (no gravity, constant velocity)
-    for (auto &p : this->projectiles)
-    {
-        // Manual position update with constant velocity
-        Vector3 newPos = p.pos();
-        newPos.x += p.vel().x * delta;
-        newPos.y += p.vel().y * delta;
-        newPos.z += p.vel().z * delta;
-        p.setPosition(newPos);
-        
-        // Add horizontal spin rotation (like a frisbee/shuriken)
-        static float spinAngle = 0.0f;
-        spinAngle += horizontalSpinSpeed * delta;
-        if (spinAngle > 360.0f) spinAngle -= 360.0f;
-        
-        // Rotate around the Y-axis (horizontal spin)
-        Quaternion spinRotation = QuaternionFromAxisAngle({0.0f, 1.0f, 0.0f}, spinAngle * DEG2RAD);
-        p.obj().setRotation(spinRotation);
-        p.obj().UpdateOBB();
-    }
-
-    // Check for collisions and remove projectiles that hit something
-    auto shouldRemove = [&](Projectile &p) -> bool
-    {
-        // Check if hit ground
-        if (p.pos().y <= 0.1f)
-        {
-            return true;
-        }
-
-        // Check collision with static objects
-        if (uc.scene)
-        {
-            const auto worldHits = Object::collided(p.obj(), uc.scene);
-            for (const auto &hit : worldHits)
-            {
-                if (hit.collided && hit.with == nullptr) // hit static geometry
-                {
-                    return true;
-                }
-            }
-
-            // Check collision with enemies
-            for (Entity *entity : uc.scene->em.getEntities())
-            {
-                if (!entity || entity->category() != ENTITY_ENEMY)
-                    continue;
-                Enemy *enemy = static_cast<Enemy *>(entity);
-                CollisionResult result = Object::collided(p.obj(), enemy->obj());
-                if (result.collided)
-                {
-                    // Deal damage to enemy using projectile's damage value
-                    DamageResult damage(p.damage, result);
-                    uc.scene->em.damage(enemy, damage, uc);
-                    return true; // remove projectile
-                }
-            }
-        }
-
-        return false;
-    };
-
-    this->projectiles.erase(
-        std::remove_if(this->projectiles.begin(), this->projectiles.end(), shouldRemove),
-        this->projectiles.end());
 }
 
 // Helper: create quaternion that faces forward (used by setRotationFromForward / quaternion helpers already in file)
@@ -355,7 +279,7 @@ void BambooBombAttack::releaseExplosionTexture()
 
 void BambooBombAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     this->cooldownRemaining = fmaxf(0.0f, this->cooldownRemaining - delta);
     for (auto &bomb : bombs)
     {
@@ -382,31 +306,14 @@ void BambooBombAttack::update(UpdateContext &uc)
             bool hitEnvironment = false;
             if (uc.scene)
             {
-                const auto worldHits = Object::collided(bomb.projectile.obj(), uc.scene);
-                hitEnvironment = std::any_of(
-                    worldHits.begin(),
-                    worldHits.end(),
-                    [](const CollisionResult &hit)
-                    {
-                        return hit.with == nullptr; // static world geometry
-                    });
+                // Static world geometry only
+                hitEnvironment = !Object::collided(bomb.projectile.obj(), uc.scene, COLLISION_MASK_STATIC).empty();
             }
 
             bool hitEnemy = false;
             if (uc.scene && !hitEnvironment)
             {
-                for (Entity *entity : uc.scene->em.getEntities())
-                {
-                    if (!entity || entity->category() != ENTITY_ENEMY)
-                        continue;
-                    Enemy *enemy = static_cast<Enemy *>(entity);
-                    CollisionResult result = Object::collided(bomb.projectile.obj(), enemy->obj());
-                    if (result.collided)
-                    {
-                        hitEnemy = true;
-                        break;
-                    }
-                }
+                hitEnemy = !Object::collided(bomb.projectile.obj(), uc.scene, COLLISION_LAYER_ENEMY).empty();
             }
 
             bool timedOut = bomb.flightTimeRemaining <= 0.0f;
@@ -450,38 +357,34 @@ float BambooBombAttack::getCooldownPercent() const
     return Clamp(1.0f - (this->cooldownRemaining / cooldownDuration), 0.0f, 1.0f);
 }
 
-std::vector<Entity *> BambooBombAttack::getEntities()
+void BambooBombAttack::visitEntities(Visitor<Entity> visit)
 {
-    std::vector<Entity *> ret;
     for (auto &bomb : bombs)
     {
         if (!bomb.exploded)
         {
-            ret.push_back(&bomb.projectile);
+            visit(&bomb.projectile);
         }
     }
-    return ret;
 }
 
-std::vector<Object *> BambooBombAttack::obj()
+void BambooBombAttack::visitObjects(Visitor<Object> visit)
 {
-    std::vector<Object *> ret;
     for (auto &bomb : bombs)
     {
         if (!bomb.exploded)
         {
-            ret.push_back(&bomb.projectile.obj());
+            visit(&bomb.projectile.obj());
         }
         if (bomb.fxActive)
         {
-            ret.push_back(&bomb.explosionFx);
+            visit(&bomb.explosionFx);
         }
         if (bomb.spriteActive)
         {
-            ret.push_back(&bomb.explosionSprite);
+            visit(&bomb.explosionSprite);
         }
     }
-    return ret;
 }
 
 void BambooBombAttack::startExplosion(Bomb &bomb, const Vector3 &origin, UpdateContext &uc)
@@ -564,8 +467,8 @@ void BambooBombAttack::applyExplosionEffects(const Vector3 &origin, UpdateContex
         if (category == ENTITY_ENEMY)
         {
             Enemy *enemy = static_cast<Enemy *>(entity);
-            enemy->applyKnockback(push, explosionKnockbackDuration, explosionLift);
-            uc.scene->em.damage(enemy, damage, uc);
+            uc.scene->events.Knockback(enemy, push, explosionKnockbackDuration, explosionLift);
+            uc.scene->events.Damage(enemy, explosionDamage);
         }
         else if (category == ENTITY_PLAYER)
         {
@@ -580,9 +483,10 @@ void BambooBombAttack::applyExplosionEffects(const Vector3 &origin, UpdateContex
         applyToEntity(uc.player);
     }
 
-    for (Entity *entity : uc.scene->em.getEntities())
+    uc.scene->em.QuerySphere(origin, explosionEndRadius, this->targets);
+    for (Enemy *enemy : this->targets)
     {
-        applyToEntity(entity);
+        applyToEntity(enemy);
     }
 }
 
@@ -625,7 +529,7 @@ void BambooBombAttack::updateExplosionBillboard(Bomb &bomb, UpdateContext &uc, f
 // --- MeleePushAttack ------------------------------------------------------------------
 void MeleePushAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
 
     if (this->cooldownRemaining > 0.0f)
     {
@@ -659,19 +563,16 @@ void MeleePushAttack::update(UpdateContext &uc)
         this->effectVolumes.end());
 }
 
-std::vector<Object *> MeleePushAttack::obj() const
+void MeleePushAttack::visitObjects(Visitor<Object> visit)
 {
-    std::vector<Object *> ret;
-    ret.reserve(this->effectVolumes.size() + (this->tileIndicator.active ? 1U : 0U));
     for (const auto &volume : this->effectVolumes)
     {
-        ret.push_back(const_cast<Object *>(&volume.area));
+        visit(const_cast<Object *>(&volume.area));
     }
     if (this->tileIndicator.active)
     {
-        ret.push_back(const_cast<Object *>(&this->tileIndicator.sprite));
+        visit(const_cast<Object *>(&this->tileIndicator.sprite));
     }
-    return ret;
 }
 
 Vector3 MeleePushAttack::getForwardVector() const
@@ -782,13 +683,10 @@ bool MeleePushAttack::pushEnemies(UpdateContext &uc, EffectVolume &volume)
         return false;
 
     bool hit = false;
-    for (auto entity : uc.scene->getEntities(ENTITY_ENEMY))
+    uc.scene->em.QueryOBB(volume.area, this->targets);
+    for (Enemy *enemy : this->targets)
     {
-        if (!entity || entity == this->spawnedBy)
-            continue;
-        Enemy *enemy = static_cast<Enemy *>(entity);
-        CollisionResult collision = Object::collided(volume.area, enemy->obj());
-        if (!collision.collided)
+        if (enemy == this->spawnedBy)
             continue;
 
         Vector3 origin = this->spawnedBy->pos();
@@ -808,10 +706,8 @@ bool MeleePushAttack::pushEnemies(UpdateContext &uc, EffectVolume &volume)
         }
 
         Vector3 push = Vector3Scale(dirNorm, pushForce);
-        enemy->applyKnockback(push, knockbackDuration, verticalLift);
-
-        DamageResult damage(pushDamage, collision);
-        uc.scene->em.damage(enemy, damage, uc);
+        uc.scene->events.Knockback(enemy, push, knockbackDuration, verticalLift);
+        uc.scene->events.Damage(enemy, pushDamage);
         hit = true;
     }
     return hit;
@@ -1029,62 +925,16 @@ Vector3 DashAttack::computeCollisionAdjustedVelocity(Me *player, UpdateContext &
     if (!player || !uc.scene || desiredSpeed <= 0.0f)
         return defaultVel;
 
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     if (delta <= 0.0f)
         return defaultVel;
 
-    Object probe = player->obj();
-    Vector3 startPos = player->pos();
-    probe.pos = startPos;
-    probe.UpdateOBB();
-
-    float remainingDistance = desiredSpeed * delta;
-    float approxSize = fmaxf(fmaxf(probe.size.x, probe.size.y), probe.size.z);
-    float stepSize = fmaxf(0.2f, approxSize * 0.25f);
-    Vector3 currentDir = this->dashDirection;
-    int guard = 0;
-
-    while (remainingDistance > 0.0001f && Vector3LengthSqr(currentDir) > 1e-5f && guard < 256)
-    {
-        ++guard;
-        float step = fminf(stepSize, remainingDistance);
-        Vector3 move = Vector3Scale(currentDir, step);
-        probe.pos = Vector3Add(probe.pos, move);
-        probe.UpdateOBB();
-
-        auto hits = Object::collided(probe, uc.scene);
-        bool blocked = false;
-        Vector3 blockNormal = {0.0f, 0.0f, 0.0f};
-        for (const CollisionResult &hit : hits)
-        {
-            if (hit.collided && hit.with == nullptr)
-            {
-                blocked = true;
-                blockNormal = hit.normal;
-                break;
-            }
-        }
-
-        if (blocked)
-        {
-            probe.pos = Vector3Subtract(probe.pos, move);
-            probe.UpdateOBB();
-
-            float normalDot = Vector3DotProduct(currentDir, blockNormal);
-            Vector3 slideDir = Vector3Subtract(currentDir, Vector3Scale(blockNormal, normalDot));
-            if (Vector3LengthSqr(slideDir) < 1e-4f)
-            {
-                remainingDistance = 0.0f;
-                break;
-            }
-            currentDir = Vector3Normalize(slideDir);
-            continue;
-        }
-
-        remainingDistance -= step;
-    }
-
-    Vector3 displacement = Vector3Subtract(probe.pos, startPos);
+    // One collide-and-slide cast replaces stepping a probe box through the scene.
+    OBB box = player->obj().obb;
+    box.center = player->pos();
+    Vector3 move = Vector3Scale(this->dashDirection, desiredSpeed * delta);
+    Vector3 displacement = uc.scene->SlideOBB(box, move, player);
+    displacement.y = 0.0f;
     float displacementLenSq = Vector3LengthSqr(displacement);
     if (displacementLenSq > 1e-6f)
     {
@@ -1120,7 +970,7 @@ void DashAttack::applyDashImpulse(Me *player, UpdateContext &uc)
 
 void DashAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     if (this->cooldownRemaining > 0.0f)
         this->cooldownRemaining = fmaxf(0.0f, this->cooldownRemaining - delta);
 
@@ -1178,7 +1028,7 @@ DragonClawAttack::DragonClawAttack(Entity *_spawnedBy) : AttackController(_spawn
 // --- DragonClawAttack: 3-phase claw swipe animation with arc motion + tweak helper ---
 void DragonClawAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     if (this->spawnedBy && this->spawnedBy->category() == ENTITY_PLAYER)
     {
         handleTweakHotkeys();
@@ -1373,48 +1223,39 @@ void DragonClawAttack::checkSlashHits(SlashEffect &slash, UpdateContext &uc)
         return;
     
     // Check collision with enemies in range
-    for (Entity *entity : uc.scene->em.getEntities())
+    uc.scene->em.QueryOBB(slash.spiritTile, this->targets);
+    if (!this->targets.empty())
     {
-        if (!entity || entity->category() != ENTITY_ENEMY)
-            continue;
+        // A slash hits a single enemy
+        Enemy *enemy = this->targets.front();
+        // Deal damage
+        uc.scene->events.Damage(enemy, slashDamage);
         
-        Enemy *enemy = static_cast<Enemy *>(entity);
-        CollisionResult result = Object::collided(slash.spiritTile, enemy->obj());
+        // Apply knockback
+        Vector3 delta = Vector3Subtract(enemy->pos(), slash.spiritTile.pos);
+        Vector3 pushDir = Vector3Normalize(delta);
+        uc.scene->events.Knockback(enemy, Vector3Scale(pushDir, 20.0f), 0.3f, 0.0f);
         
-        if (result.collided)
+        // Camera shake on hit
+        if (this->spawnedBy && this->spawnedBy->category() == ENTITY_PLAYER)
         {
-            // Deal damage
-            DamageResult damage(slashDamage, result);
-            uc.scene->em.damage(enemy, damage, uc);
-            
-            // Apply knockback
-            Vector3 delta = Vector3Subtract(enemy->pos(), slash.spiritTile.pos);
-            Vector3 pushDir = Vector3Normalize(delta);
-            enemy->applyKnockback(Vector3Scale(pushDir, 20.0f), 0.3f, 0.0f);
-            
-            // Camera shake on hit
-            if (this->spawnedBy && this->spawnedBy->category() == ENTITY_PLAYER)
-            {
-                Me *player = static_cast<Me *>(this->spawnedBy);
-                player->addCameraShake(cameraShakeMagnitude, cameraShakeDuration);
-            }
-            
-            slash.hasHit = true;
-            break;
+            Me *player = static_cast<Me *>(this->spawnedBy);
+            player->addCameraShake(cameraShakeMagnitude, cameraShakeDuration);
         }
+        
+        slash.hasHit = true;
     }
 }
 
-std::vector<Object *> DragonClawAttack::obj()
+void DragonClawAttack::visitObjects(Visitor<Object> visit)
 {
-    std::vector<Object *> ret;
     for (auto &slash : activeSlashes)
     {
         float alpha = spiritTileOpacity * (1.0f - powf(slash.animationProgress, spiritTileOpacityFadeRate));
         
         unsigned char alphaVal = (unsigned char)(alpha * 255.0f);
         slash.spiritTile.tint.a = alphaVal;
-        ret.push_back(&slash.spiritTile);
+        visit(&slash.spiritTile);
     }
 
     // Debug arc particles for tweak mode
@@ -1422,10 +1263,9 @@ std::vector<Object *> DragonClawAttack::obj()
     {
         for (auto &p : debugArcPoints)
         {
-            ret.push_back(&p);
+            visit(&p);
         }
     }
-    return ret;
 }
 
 // Calculate slash position using predetermined cubic Bézier arc (local space)
@@ -1773,38 +1613,13 @@ void DragonClawAttack::drawTweakHud(const Me &player)
 // --- ArcaneOrbAttack: homing projectile with smooth tracking and sine-wave motion ---
 void ArcaneOrbAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     
     // Update cooldown
     if (cooldownRemaining > 0.0f)
     {
         cooldownRemaining = fmaxf(0.0f, cooldownRemaining - delta);
     }
-    
-    // Update projectiles
-    for (auto &orb : activeOrbs)
-    {
-        if (!orb.active)
-            continue;
-        
-        orb.lifetime += delta;
-        
-        // Remove if too old
-        if (orb.lifetime >= OrbProjectile::maxLifetime)
-        {
-            orb.active = false;
-            continue;
-        }
-        
-        updateOrbMovement(orb, uc, delta);
-        checkOrbHits(orb, uc);
-    }
-    
-    // Remove inactive orbs
-    activeOrbs.erase(
-        std::remove_if(activeOrbs.begin(), activeOrbs.end(),
-            [](const OrbProjectile &o) { return !o.active; }),
-        activeOrbs.end());
 }
 
 void ArcaneOrbAttack::spawnOrb(UpdateContext &uc)
@@ -1843,189 +1658,40 @@ void ArcaneOrbAttack::spawnOrb(UpdateContext &uc)
         spawnPos.y += 1.0f;
     }
     
-    OrbProjectile orb;
-    orb.position = spawnPos;
-    orb.lastDirection = forward;  // Initial direction
-    orb.lifetime = 0.0f;
-    orb.sineWavePhase = 0.0f;
-    orb.targetEnemy = nullptr;
-    orb.active = true;
-    
-    // Find nearest enemy for homing
-    orb.targetEnemy = findNearestEnemy(uc, spawnPos, OrbProjectile::searchRadius);
-    if (orb.targetEnemy)
-    {
-        orb.targetPos = orb.targetEnemy->pos();
-    }
-    else
-    {
-        orb.targetPos = Vector3Add(spawnPos, Vector3Scale(forward, 50.0f));
-    }
-    
-    // Create orb object
-    orb.orbObj.setAsSphere(orbSize);
-    orb.orbObj.pos = orb.position;
-    orb.orbObj.useTexture = uc.uiManager != nullptr;
-    if (uc.uiManager)
-    {
-        orb.orbObj.texture = &uc.uiManager->muim.getSpriteSheet();
-        TileType selectedTile = uc.uiManager->muim.getSelectedTile(uc.player->hand);
-        orb.orbObj.sourceRect = uc.uiManager->muim.getTile(selectedTile);
-        orb.orbObj.tint = Color{100, 200, 255, 180}; // Blue tint for magic orb
-    }
-    orb.orbObj.UpdateOBB();
-    
-    activeOrbs.push_back(orb);
-    cooldownRemaining = cooldownDuration;
-}
-
-void ArcaneOrbAttack::updateOrbMovement(OrbProjectile &orb, UpdateContext &uc, float deltaSeconds)
-{
-    // Update target if enemy is still alive
-    if (orb.targetEnemy)
-    {
-        if (orb.targetEnemy->category() == ENTITY_ENEMY)
-        {
-            Enemy *enemy = static_cast<Enemy *>(orb.targetEnemy);
-            orb.targetPos = enemy->pos();
-        }
-        else
-        {
-            orb.targetEnemy = nullptr;
-        }
-    }
-    
-    // Find new target if needed
-    if (!orb.targetEnemy && uc.scene)
-    {
-        orb.targetEnemy = findNearestEnemy(uc, orb.position, OrbProjectile::searchRadius);
-        if (orb.targetEnemy)
-        {
-            orb.targetPos = orb.targetEnemy->pos();
-        }
-    }
-    
-    // Compute desired direction to target
-    Vector3 toTarget = Vector3Subtract(orb.targetPos, orb.position);
-    Vector3 targetDir = Vector3Normalize(toTarget);
-    
-    // Blend between last direction and target direction for smooth tracking
-    // trackingBlend = 0.4f means 40% target tracking, 60% inertia from previous direction
-    Vector3 blendedDir = Vector3Lerp(
-        orb.lastDirection,
-        targetDir,
-        OrbProjectile::trackingBlend);
-    blendedDir = Vector3Normalize(blendedDir);
-    
-    // Apply sine-wave motion for magical feel (vertical oscillation)
-    orb.sineWavePhase += deltaSeconds * OrbProjectile::sineWaveFrequency;
-    float verticalSineWave = sinf(orb.sineWavePhase) * OrbProjectile::sineWaveAmplitude;
-    
-    // Get perpendicular vector for sine wave offset
-    Vector3 up = {0.0f, 1.0f, 0.0f};
-    Vector3 right = Vector3CrossProduct(blendedDir, up);
-    if (Vector3LengthSqr(right) < 0.0001f)
-    {
-        right = {1.0f, 0.0f, 0.0f};
-    }
-    right = Vector3Normalize(right);
-    
-    // Apply sine wave to vertical component
-    Vector3 finalDir = blendedDir;
-    finalDir.y += verticalSineWave * 0.1f;  // Add vertical oscillation
-    finalDir = Vector3Normalize(finalDir);
-    
-    // Store direction for next frame tracking
-    orb.lastDirection = finalDir;
-    
-    // Update position
-    orb.position = Vector3Add(orb.position, Vector3Scale(finalDir, OrbProjectile::baseSpeed * deltaSeconds));
-    
-    // Update object
-    orb.orbObj.pos = orb.position;
-    
-    // Add rotation to orb for visual interest
-    static float orbRotation = 0.0f;
-    orbRotation += orbSpinSpeed * deltaSeconds;
-    if (orbRotation > 360.0f) orbRotation -= 360.0f;
-    Quaternion rot = QuaternionFromEuler(orbRotation * DEG2RAD, orbRotation * DEG2RAD * 0.5f, orbRotation * DEG2RAD * 0.3f);
-    orb.orbObj.setRotation(rot);
-    
-    orb.orbObj.UpdateOBB();
-}
-
-void ArcaneOrbAttack::checkOrbHits(OrbProjectile &orb, UpdateContext &uc)
-{
-    if (!uc.scene)
-        return;
-    
-    // Check collision with enemies
-    for (Entity *entity : uc.scene->em.getEntities())
-    {
-        if (!entity || entity->category() != ENTITY_ENEMY)
-            continue;
-        
-        Enemy *enemy = static_cast<Enemy *>(entity);
-        CollisionResult result = Object::collided(orb.orbObj, enemy->obj());
-        
-        if (result.collided)
-        {
-            // Deal damage
-            DamageResult damage(OrbProjectile::damage, result);
-            uc.scene->em.damage(enemy, damage, uc);
-            
-            // Apply knockback
-            Vector3 delta = Vector3Subtract(enemy->pos(), orb.position);
-            Vector3 pushDir = Vector3Normalize(delta);
-            enemy->applyKnockback(Vector3Scale(pushDir, 15.0f), 0.2f, 0.0f);
-            
-            orb.active = false;
-            break;
-        }
-    }
-    
-    // Check if hit ground
-    if (orb.position.y <= 0.1f)
+    if (this->orbKind == NO_PROJECTILE_KIND)
     {
-        orb.active = false;
+        ProjectileKind kind;
+        kind.homingBlend = trackingBlend;
+        kind.homingRange = searchRadius;
+        kind.wiggleAmplitude = sineWaveAmplitude;
+        kind.wiggleFrequency = sineWaveFrequency;
+        kind.wiggleVertical = true;
+        kind.radius = orbSize;
+        kind.lifetime = maxLifetime;
+        kind.groundHeight = 0.1f;
+        kind.knockbackSpeed = knockbackSpeed;
+        kind.knockbackDuration = knockbackDuration;
+        kind.texture = uc.uiManager ? &uc.uiManager->muim.getSpriteSheet() : nullptr;
+        kind.tint = Color{100, 200, 255, 180}; // Blue tint for magic orb
+        kind.glow = true;
+        this->orbKind = uc.scene->projectiles.RegisterKind(kind);
     }
-}
 
-Entity *ArcaneOrbAttack::findNearestEnemy(UpdateContext &uc, const Vector3 &position, float searchRadius) const
-{
-    if (!uc.scene)
-        return nullptr;
-    
-    Entity *nearest = nullptr;
-    float minDistSq = searchRadius * searchRadius;
-    
-    for (Entity *entity : uc.scene->em.getEntities())
+    // The world picks the nearest enemy within range as the first target
+    ProjectileSpawn orb;
+    orb.position = spawnPos;
+    orb.velocity = Vector3Scale(forward, baseSpeed);
+    orb.damage = damage;
+    if (this->spawnedBy->category() == ENTITY_ENEMY)
     {
-        if (!entity || entity->category() != ENTITY_ENEMY)
-            continue;
-        
-        float distSq = Vector3DistanceSqr(position, entity->pos());
-        if (distSq < minDistSq)
-        {
-            minDistSq = distSq;
-            nearest = entity;
-        }
+        orb.owner = this->spawnedBy->getHandle();
     }
-    
-    return nearest;
-}
-
-std::vector<Object *> ArcaneOrbAttack::obj()
-{
-    std::vector<Object *> ret;
-    for (auto &orb : activeOrbs)
+    if (uc.uiManager && uc.player)
     {
-        if (orb.active)
-        {
-            ret.push_back(&orb.orbObj);
-        }
+        orb.sourceRect = uc.uiManager->muim.getTile(uc.uiManager->muim.getSelectedTile(uc.player->hand));
     }
-    return ret;
+    uc.scene->projectiles.Spawn(this->orbKind, orb);
+    cooldownRemaining = cooldownDuration;
 }
 
 // ============================================================================
@@ -2034,9 +1700,9 @@ std::vector<Object *> ArcaneOrbAttack::obj()
 
 bool GravityWellAttack::trigger(UpdateContext &uc)
 {
-    if (this->cooldownRemaining > 0.0f || this->projectile.active || this->activeWell.active)
+    if (this->cooldownRemaining > 0.0f || this->seedInFlight || this->activeWell.active)
         return false;
-    if (!this->spawnedBy || !uc.player)
+    if (!this->spawnedBy || !uc.player || !uc.scene)
         return false;
 
     Vector3 forward = {0.0f, 0.0f, -1.0f};
@@ -2050,85 +1716,81 @@ bool GravityWellAttack::trigger(UpdateContext &uc)
         forward = {0.0f, 0.0f, -1.0f};
     forward = Vector3Normalize(forward);
 
-    Vector3 up = {0.0f, 1.0f, 0.0f};
-    Vector3 wiggleAxis = Vector3CrossProduct(forward, up);
-    if (Vector3LengthSqr(wiggleAxis) < 1e-4f)
-        wiggleAxis = {1.0f, 0.0f, 0.0f};
-    wiggleAxis = Vector3Normalize(wiggleAxis);
-
     spawnPos = Vector3Add(spawnPos, Vector3Scale(forward, 2.2f));
     spawnPos.y += 1.2f;
 
-    this->projectile.active = true;
-    this->projectile.position = spawnPos;
-    this->projectile.velocity = Vector3Scale(forward, flightSpeed);
-    this->projectile.velocity.y += flightLift;
-    this->projectile.wiggleAxis = wiggleAxis;
-    this->projectile.sinePhase = 0.0f;
-    this->projectile.visual.setAsSphere(projectileRadius);
-    this->projectile.visual.pos = spawnPos;
-    this->projectile.visual.tint = Color{8, 8, 12, 230};
-    this->projectile.visual.useTexture = false;
-    this->projectile.visual.texture = nullptr;
-    this->projectile.visual.setVisible(true);
-    this->projectile.visual.UpdateOBB();
+    // Slow seed with a sideways sine wiggle and light gravity; the well opens where it lands
+    if (this->seedKind == NO_PROJECTILE_KIND)
+    {
+        ProjectileKind kind;
+        kind.gravity = projectileGravity;
+        kind.wiggleAmplitude = flightSineAmplitude;
+        kind.wiggleFrequency = flightSineFrequency;
+        kind.radius = projectileRadius;
+        kind.lifetime = projectileLifetime;
+        kind.groundHeight = projectileRadius;
+        kind.collidesWith = 0;
+        kind.damages = 0;
+        kind.tint = Color{8, 8, 12, 230};
+        kind.glow = true;
+        kind.onImpact = &GravityWellAttack::OnSeedGone;
+        kind.user = this;
+        this->seedKind = uc.scene->projectiles.RegisterKind(kind);
+    }
+
+    ProjectileSpawn seed;
+    seed.position = spawnPos;
+    seed.velocity = Vector3Scale(forward, flightSpeed);
+    seed.velocity.y += flightLift;
+    uc.scene->projectiles.Spawn(this->seedKind, seed);
+    this->seedInFlight = true;
 
     this->cooldownRemaining = cooldownDuration;
     return true;
 }
 
-void GravityWellAttack::update(UpdateContext &uc)
+void GravityWellAttack::OnSeedGone(void *user, const ProjectileImpact &impact, UpdateContext &uc)
 {
-    float delta = GetFrameTime();
-    if (this->cooldownRemaining > 0.0f)
-        this->cooldownRemaining = fmaxf(0.0f, this->cooldownRemaining - delta);
-
-    // Flight phase: slow projectile with sine wiggle and light gravity
-    if (this->projectile.active)
+    GravityWellAttack *self = static_cast<GravityWellAttack *>(user);
+    self->seedInFlight = false;
+    if (impact.reason == ProjectileImpact::Reason::Ground)
     {
-        this->projectile.velocity.y -= projectileGravity * delta;
-        this->projectile.sinePhase += flightSineFrequency * delta;
-        float wiggle = sinf(this->projectile.sinePhase) * flightSineAmplitude;
-        Vector3 wiggleVel = Vector3Scale(this->projectile.wiggleAxis, wiggle);
-        Vector3 step = Vector3Add(this->projectile.velocity, wiggleVel);
-        this->projectile.position = Vector3Add(this->projectile.position, Vector3Scale(step, delta));
-        this->projectile.visual.pos = this->projectile.position;
-        this->projectile.visual.UpdateOBB();
+        Vector3 center = impact.position;
+        center.y = projectileRadius;
+        self->openWell(center, uc);
+    }
+}
 
-        if (this->projectile.position.y <= projectileRadius)
-        {
-            this->projectile.position.y = projectileRadius;
-            this->projectile.visual.pos = this->projectile.position;
-            this->projectile.visual.UpdateOBB();
-            this->projectile.active = false;
-            this->projectile.visual.setVisible(false);
-
-            this->activeWell.active = true;
-            this->activeWell.opening = true;
-            this->activeWell.collapsing = false;
-            this->activeWell.lifetime = wellDuration;
-            this->activeWell.openTimer = openingDuration;
-            this->activeWell.collapseTimer = collapseDuration;
-            this->activeWell.currentRadius = projectileRadius;
-
-            this->activeWell.core.setAsSphere(projectileRadius * 0.7f);
-            this->activeWell.core.pos = this->projectile.position;
-            this->activeWell.core.tint = Color{8, 8, 12, 240};
-            this->activeWell.core.useTexture = false;
-            this->activeWell.core.texture = nullptr;
-            this->activeWell.core.setVisible(true);
-            this->activeWell.core.UpdateOBB();
-
-            this->activeWell.outerRing.setVisible(false);
-            this->activeWell.innerRing.setVisible(false);
+void GravityWellAttack::openWell(const Vector3 &center, UpdateContext &uc)
+{
+    this->activeWell.active = true;
+    this->activeWell.opening = true;
+    this->activeWell.collapsing = false;
+    this->activeWell.lifetime = wellDuration;
+    this->activeWell.openTimer = openingDuration;
+    this->activeWell.collapseTimer = collapseDuration;
+    this->activeWell.currentRadius = projectileRadius;
 
-            if (uc.scene)
-            {
-                uc.scene->particles.spawnRing(this->projectile.position, projectileRadius * 1.4f, 24, Color{120, 60, 190, 220}, 1.5f, true);
-                uc.scene->particles.spawnRing(this->projectile.position, projectileRadius * 0.9f, 18, Color{80, 30, 140, 210}, 1.1f, true);
-            }
-        }
-    }
+    this->activeWell.core.setAsSphere(projectileRadius * 0.7f);
+    this->activeWell.core.pos = center;
+    this->activeWell.core.tint = Color{8, 8, 12, 240};
+    this->activeWell.core.useTexture = false;
+    this->activeWell.core.texture = nullptr;
+    this->activeWell.core.setVisible(true);
+    this->activeWell.core.UpdateOBB();
+
+    this->activeWell.outerRing.setVisible(false);
+    this->activeWell.innerRing.setVisible(false);
+
+    uc.scene->particles.spawnRing(center, projectileRadius * 1.4f, 24, Color{120, 60, 190, 220}, 1.5f, true);
+    uc.scene->particles.spawnRing(center, projectileRadius * 0.9f, 18, Color{80, 30, 140, 210}, 1.1f, true);
+}
+
+void GravityWellAttack::update(UpdateContext &uc)
+{
+    float delta = uc.deltaTime;
+    if (this->cooldownRemaining > 0.0f)
+        this->cooldownRemaining = fmaxf(0.0f, this->cooldownRemaining - delta);
 
     if (!this->activeWell.active)
         return;
@@ -2169,16 +1831,12 @@ void GravityWellAttack::update(UpdateContext &uc)
     // Suction logic and suppression
     if (uc.scene)
     {
-        for (Entity *entity : uc.scene->em.getEntities())
+        uc.scene->em.QueryCylinder(center, pullRadius, this->targets);
+        for (Enemy *enemy : this->targets)
         {
-            if (!entity || entity->category() != ENTITY_ENEMY)
-                continue;
-            Enemy *enemy = static_cast<Enemy *>(entity);
             Vector3 deltaPos = Vector3Subtract(center, enemy->pos());
             deltaPos.y = 0.0f; // keep pull planar to avoid launch
             float distSq = Vector3LengthSqr(deltaPos);
-            if (distSq > pullRadius * pullRadius)
-                continue;
 
             float dist = sqrtf(fmaxf(distSq, 0.0001f));
             Vector3 dir = Vector3Scale(deltaPos, 1.0f / dist);
@@ -2219,7 +1877,7 @@ void GravityWellAttack::update(UpdateContext &uc)
 
             if (dist <= suppressRadius)
             {
-                enemy->applyStun(suppressStunDuration);
+                uc.scene->events.Stun(enemy, suppressStunDuration);
             }
 
             if (GetRandomValue(0, 100) < 30)
@@ -2261,14 +1919,12 @@ void GravityWellAttack::update(UpdateContext &uc)
         this->activeWell.outerRing.setVisible(false);
         this->activeWell.innerRing.setVisible(false);
         
-        // When well ends, clamp enemy velocities to prevent fling-out
+        // When well ends, clamp the velocities of the enemies it held to prevent fling-out
         if (uc.scene)
         {
-            for (Entity *entity : uc.scene->em.getEntities())
+            uc.scene->em.QueryCylinder(center, pullRadius, this->targets);
+            for (Enemy *enemy : this->targets)
             {
-                if (!entity || entity->category() != ENTITY_ENEMY)
-                    continue;
-                Enemy *enemy = static_cast<Enemy *>(entity);
                 Vector3 vel = enemy->vel();
                 
                 // Reduce horizontal speed to prevent outward fling
@@ -2286,18 +1942,12 @@ void GravityWellAttack::update(UpdateContext &uc)
     }
 }
 
-std::vector<Object *> GravityWellAttack::obj()
+void GravityWellAttack::visitObjects(Visitor<Object> visit)
 {
-    std::vector<Object *> out;
-    if (this->projectile.active)
-    {
-        out.push_back(&this->projectile.visual);
-    }
     if (this->activeWell.active)
     {
-        out.push_back(&this->activeWell.core);
+        visit(&this->activeWell.core);
     }
-    return out;
 }
 
 float GravityWellAttack::getCooldownPercent() const
@@ -2311,28 +1961,23 @@ float GravityWellAttack::getCooldownPercent() const
 // ChainLightningAttack Implementation
 // ============================================================================
 
-Entity *ChainLightningAttack::findPrimaryTarget(UpdateContext &uc, Vector3 camPos, Vector3 camForward) const
+Entity *ChainLightningAttack::findPrimaryTarget(UpdateContext &uc, Vector3 camPos, Vector3 camForward)
 {
     if (!uc.scene)
         return nullptr;
 
     Entity *best = nullptr;
     float bestProj = maxRange;
-    for (Entity *entity : uc.scene->em.getEntities())
+    Vector3 rayEnd = Vector3Add(camPos, Vector3Scale(camForward, maxRange));
+    uc.scene->em.QueryCapsule(camPos, rayEnd, aimRadius, this->targets);
+    for (Enemy *entity : this->targets)
     {
-        if (!entity || entity->category() != ENTITY_ENEMY)
-            continue;
+        // The capsule's rounded ends reach behind the camera and past the range
         Vector3 toEnemy = Vector3Subtract(entity->pos(), camPos);
         float proj = Vector3DotProduct(toEnemy, camForward);
         if (proj < 0.0f || proj > maxRange)
             continue;
 
-        Vector3 along = Vector3Scale(camForward, proj);
-        Vector3 perpendicular = Vector3Subtract(toEnemy, along);
-        float offset = Vector3Length(perpendicular);
-        if (offset > 2.2f)
-            continue;
-
         if (proj < bestProj)
         {
             bestProj = proj;
@@ -2342,27 +1987,12 @@ Entity *ChainLightningAttack::findPrimaryTarget(UpdateContext &uc, Vector3 camPo
     return best;
 }
 
-std::vector<Entity *> ChainLightningAttack::findSecondaryTargets(UpdateContext &uc, Entity *primary) const
+const std::vector<Enemy *> &ChainLightningAttack::findSecondaryTargets(UpdateContext &uc, Entity *primary)
 {
-    std::vector<Entity *> candidates;
-    if (!uc.scene || !primary)
-        return candidates;
-
-    for (Entity *entity : uc.scene->em.getEntities())
-    {
-        if (!entity || entity == primary || entity->category() != ENTITY_ENEMY)
-            continue;
-        float dist = Vector3Distance(entity->pos(), primary->pos());
-        if (dist <= chainRadius)
-            candidates.push_back(entity);
-    }
-
-    std::sort(candidates.begin(), candidates.end(), [primary](Entity *a, Entity *b)
-              { return Vector3Distance(a->pos(), primary->pos()) < Vector3Distance(b->pos(), primary->pos()); });
-
-    if (candidates.size() > 3)
-        candidates.resize(3);
-    return candidates;
+    this->targets.clear();
+    if (uc.scene && primary)
+        uc.scene->em.QueryNearest(primary->pos(), chainRadius, maxSecondaryTargets, this->targets, primary);
+    return this->targets;
 }
 
 void ChainLightningAttack::applyDamageAndStun(Entity *target, float damage, UpdateContext &uc)
@@ -2370,28 +2000,23 @@ void ChainLightningAttack::applyDamageAndStun(Entity *target, float damage, Upda
     if (!target || target->category() != ENTITY_ENEMY || !uc.scene)
         return;
     Enemy *enemy = static_cast<Enemy *>(target);
-    int healthBefore = enemy->getHealth();
     Vector3 enemyPos = enemy->pos();
-    TraceLog(LOG_INFO, "[ChainLightning] applyDamageAndStun: dmg=%.1f to enemy=%p health_before=%d", damage, (void*)enemy, healthBefore);
-    
-    CollisionResult cr{};
-    DamageResult d(damage, cr);
-    uc.scene->em.damage(enemy, d, uc);
-    
-    // Only apply stun and particles if enemy is still alive
-    if (healthBefore - (int)damage > 0)
-    {
-        enemy->applyStun(stunDuration);
-        enemy->applyElectrocute(stunDuration);
-        // Hit particles (white + light blue burst)
-        uc.scene->particles.spawnExplosion(enemyPos, 14, Color{210, 240, 255, 230}, 0.18f, 5.0f, 0.7f);
-        uc.scene->particles.spawnExplosion(enemyPos, 10, Color{140, 200, 255, 220}, 0.12f, 3.5f, 0.55f);
-        uc.scene->particles.spawnRing(enemyPos, 2.2f, 16, Color{180, 220, 255, 200}, 2.5f, true);
-    }
-    else
-    {
-        TraceLog(LOG_WARNING, "[ChainLightning] enemy killed by damage, skipping stun and particles");
-    }
+    TraceLog(LOG_INFO, "[ChainLightning] applyDamageAndStun: dmg=%.1f to enemy=%p health_before=%d", damage, (void*)enemy, enemy->getHealth());
+
+    // Stun and particles are dropped at the flush if the damage kills the enemy
+    WorldEventQueue &events = uc.scene->events;
+    events.Damage(enemy, damage);
+    events.Stun(enemy, stunDuration);
+    events.Electrocute(enemy, stunDuration);
+
+    // Hit particles (white + light blue burst)
+    ParticleRequest burst = ParticleRequest::Explosion(enemyPos, 14, Color{210, 240, 255, 230}, 0.18f, 5.0f, 0.7f);
+    ParticleRequest core = ParticleRequest::Explosion(enemyPos, 10, Color{140, 200, 255, 220}, 0.12f, 3.5f, 0.55f);
+    ParticleRequest ring = ParticleRequest::Ring(enemyPos, 2.2f, 16, Color{180, 220, 255, 200}, 2.5f, true);
+    burst.ifAlive = core.ifAlive = ring.ifAlive = enemy->getHandle();
+    events.Particles(burst);
+    events.Particles(core);
+    events.Particles(ring);
 }
 
 void ChainLightningAttack::rebuildBoltGeometry(Bolt &bolt)
@@ -2479,17 +2104,17 @@ bool ChainLightningAttack::trigger(UpdateContext &uc)
         return false;
     }
     
-    Enemy *primaryEnemy = dynamic_cast<Enemy *>(primary);
+    Enemy *primaryEnemy = (primary->category() == ENTITY_ENEMY) ? static_cast<Enemy *>(primary) : nullptr;
     TraceLog(LOG_INFO, "[ChainLightning] found primary target=%p health=%d", (void*)primary, primaryEnemy ? primaryEnemy->getHealth() : -1);
 
     // Apply damage
     TraceLog(LOG_INFO, "[ChainLightning] applying primary dmg=%.1f", primaryDamage);
     applyDamageAndStun(primary, primaryDamage, uc);
-    auto secondaries = findSecondaryTargets(uc, primary);
+    const std::vector<Enemy *> &secondaries = findSecondaryTargets(uc, primary);
     TraceLog(LOG_INFO, "[ChainLightning] found %zu secondary targets", secondaries.size());
     for (Entity *e : secondaries)
     {
-        Enemy *secEnemy = dynamic_cast<Enemy *>(e);
+        Enemy *secEnemy = (e->category() == ENTITY_ENEMY) ? static_cast<Enemy *>(e) : nullptr;
         TraceLog(LOG_INFO, "[ChainLightning] applying secondary dmg=%.1f to enemy=%p health=%d", secondaryDamage, (void*)e, secEnemy ? secEnemy->getHealth() : -1);
         applyDamageAndStun(e, secondaryDamage, uc);
     }
@@ -2531,7 +2156,7 @@ bool ChainLightningAttack::trigger(UpdateContext &uc)
 
 void ChainLightningAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     if (this->cooldownRemaining > 0.0f)
         this->cooldownRemaining = fmaxf(0.0f, this->cooldownRemaining - delta);
 
@@ -2547,15 +2172,13 @@ void ChainLightningAttack::update(UpdateContext &uc)
         this->activeBolts.end());
 }
 
-std::vector<Object *> ChainLightningAttack::obj()
+void ChainLightningAttack::visitObjects(Visitor<Object> visit)
 {
-    std::vector<Object *> out;
     for (auto &b : this->activeBolts)
     {
         for (auto &seg : b.segments)
-            out.push_back(&seg);
+            visit(&seg);
     }
-    return out;
 }
 
 float ChainLightningAttack::getCooldownPercent() const
@@ -2635,7 +2258,7 @@ bool OrbitalShieldAttack::trigger(UpdateContext &uc)
 
 void OrbitalShieldAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     if (this->cooldownRemaining > 0.0f)
         this->cooldownRemaining = fmaxf(0.0f, this->cooldownRemaining - delta);
 
@@ -2668,27 +2291,20 @@ void OrbitalShieldAttack::update(UpdateContext &uc)
         else
         {
             orb.visual.pos = Vector3Add(orb.visual.pos, Vector3Scale(orb.velocity, delta));
-            orb.velocity = Vector3Scale(orb.velocity, 0.985f);
+            orb.velocity = Vector3Scale(orb.velocity, powf(0.985f, delta * PHYSICS_REFERENCE_HZ));
 
             // Collision vs enemies
             if (uc.scene)
             {
-                for (Entity *entity : uc.scene->em.getEntities())
+                uc.scene->em.QueryOBB(orb.visual, this->targets);
+                if (!this->targets.empty())
                 {
-                    if (!entity || entity->category() != ENTITY_ENEMY)
-                        continue;
-                    Enemy *enemy = static_cast<Enemy *>(entity);
-                    CollisionResult result = Object::collided(orb.visual, enemy->obj());
-                    if (result.collided)
-                    {
-                        DamageResult damage(shieldDamage, result);
-                        uc.scene->em.damage(enemy, damage, uc);
-                        enemy->applyKnockback(Vector3Scale(orb.velocity, 0.2f), 0.35f, 2.5f);
-                        orb.launching = false;
-                        orb.visual.setVisible(false);
-                        orb.velocity = {0.0f, 0.0f, 0.0f};
-                        break;
-                    }
+                    Enemy *enemy = this->targets.front();
+                    uc.scene->events.Damage(enemy, shieldDamage);
+                    uc.scene->events.Knockback(enemy, Vector3Scale(orb.velocity, 0.2f), 0.35f, 2.5f);
+                    orb.launching = false;
+                    orb.visual.setVisible(false);
+                    orb.velocity = {0.0f, 0.0f, 0.0f};
                 }
             }
 
@@ -2710,12 +2326,10 @@ void OrbitalShieldAttack::update(UpdateContext &uc)
         this->orbs.end());
 }
 
-std::vector<Object *> OrbitalShieldAttack::obj()
+void OrbitalShieldAttack::visitObjects(Visitor<Object> visit)
 {
-    std::vector<Object *> out;
     for (auto &orb : this->orbs)
-        out.push_back(&orb.visual);
-    return out;
+        visit(&orb.visual);
 }
 
 float OrbitalShieldAttack::getCooldownPercent() const
@@ -2763,7 +2377,7 @@ bool TryConsumeOrbitalShield(Me *player, DamageResult &dResult)
 
 void FanShotAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     cooldownRemaining -= delta;
     if (cooldownRemaining < 0.0f)
         cooldownRemaining = 0.0f;
@@ -2798,69 +2412,11 @@ void FanShotAttack::update(UpdateContext &uc)
             recoilActive = false;
         }
     }
-
-    // Update all projectiles
-    for (auto &proj : projectiles)
-    {
-        proj.UpdateBody(uc);
-    }
-
-    // Remove projectiles that hit enemies or go out of bounds
-    auto shouldRemove = [&uc](Projectile &p) -> bool
-    {
-        // Check if projectile is too low (fell through floor) or too far
-        if (p.pos().y < -10.0f || Vector3Distance(p.pos(), {0, 0, 0}) > 200.0f)
-            return true;
-
-        // Check collision with enemies
-        if (uc.scene)
-        {
-            for (Entity *entity : uc.scene->em.getEntities())
-            {
-                if (!entity || entity->category() != ENTITY_ENEMY)
-                    continue;
-                Enemy *enemy = static_cast<Enemy *>(entity);
-                CollisionResult result = Object::collided(p.obj(), enemy->obj());
-                if (result.collided)
-                {
-                    DamageResult damage(p.damage, result);
-                    uc.scene->em.damage(enemy, damage, uc);
-                    return true; // remove projectile
-                }
-            }
-        }
-
-        return false;
-    };
-
-    projectiles.erase(
-        std::remove_if(projectiles.begin(), projectiles.end(), shouldRemove),
-        projectiles.end());
-}
-
-std::vector<Entity *> FanShotAttack::getEntities()
-{
-    std::vector<Entity *> ret;
-    for (auto &p : projectiles)
-    {
-        ret.push_back(&p);
-    }
-    return ret;
-}
-
-std::vector<Object *> FanShotAttack::obj()
-{
-    std::vector<Object *> ret;
-    for (auto &p : projectiles)
-    {
-        ret.push_back(&p.obj());
-    }
-    return ret;
 }
 
 bool FanShotAttack::trigger(UpdateContext &uc)
 {
-    if (cooldownRemaining > 0.0f)
+    if (cooldownRemaining > 0.0f || !uc.scene)
         return false;
 
     Vector3 spawnPos = {0.0f, 0.0f, 0.0f};
@@ -2908,6 +2464,28 @@ bool FanShotAttack::trigger(UpdateContext &uc)
     float halfSpread = spreadAngle * 0.5f * DEG2RAD;
     float angleStep = (spreadCount > 1) ? (spreadAngle * DEG2RAD) / (float)(spreadCount - 1) : 0.0f;
 
+    if (this->projectileKind == NO_PROJECTILE_KIND)
+    {
+        // Pellets fall under gravity and are removed where they land
+        ProjectileKind kind;
+        kind.gravity = GRAVITY;
+        kind.radius = projectileSize;
+        kind.lifetime = projectileLifetime;
+        kind.groundHeight = projectileSize;
+        kind.texture = uc.uiManager ? &uc.uiManager->muim.getSpriteSheet() : nullptr;
+        kind.tint = Color{255, 255, 255, 220}; // White-hot tint
+        kind.glow = true;
+        this->projectileKind = uc.scene->projectiles.RegisterKind(kind);
+    }
+
+    ProjectileSpawn pellet;
+    pellet.position = spawnPos;
+    pellet.damage = projectileDamage;
+    if (uc.uiManager)
+    {
+        pellet.sourceRect = uc.uiManager->muim.getTile(selectedTile);
+    }
+
     for (int i = 0; i < spreadCount; ++i)
     {
         // Calculate angle for this projectile (-halfSpread to +halfSpread)
@@ -2917,33 +2495,8 @@ bool FanShotAttack::trigger(UpdateContext &uc)
         Vector3 dir = Vector3RotateByAxisAngle(forward, up, angle);
         dir = Vector3Normalize(dir);
 
-        // Create projectile body
-        Object body;
-        body.setAsSphere(projectileSize);
-        body.pos = spawnPos;
-        body.useTexture = uc.uiManager != nullptr;
-        if (uc.uiManager)
-        {
-            body.texture = &uc.uiManager->muim.getSpriteSheet();
-            body.sourceRect = uc.uiManager->muim.getTile(selectedTile);
-            body.tint = Color{255, 255, 255, 220}; // White-hot tint
-        }
-        body.UpdateOBB();
-
-        // Create projectile
-        Projectile proj(
-            spawnPos,
-            Vector3Scale(dir, projectileSpeed),
-            dir,
-            false,
-            body,
-            1.0f,
-            1.0f,
-            selectedTile
-        );
-        proj.damage = projectileDamage;
-
-        projectiles.push_back(proj);
+        pellet.velocity = Vector3Scale(dir, projectileSpeed);
+        uc.scene->projectiles.Spawn(this->projectileKind, pellet);
     }
 
     cooldownRemaining = cooldownDuration;
@@ -2984,7 +2537,7 @@ SeismicSlamAttack::SeismicSlamAttack(Entity *_spawnedBy)
 
 void SeismicSlamAttack::update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     
     // Update cooldown
     if (cooldownRemaining > 0.0f)
@@ -3112,8 +2665,8 @@ void SeismicSlamAttack::updateLeap(UpdateContext &uc, float delta)
             testBox.pos = arcPos;
             testBox.UpdateOBB();
             
-            // Check collision with scene objects (walls)
-            auto collisions = Object::collided(testBox, uc.scene);
+            // Check collision with scene objects (walls) and enemies
+            auto collisions = Object::collided(testBox, uc.scene, COLLISION_MASK_STATIC | COLLISION_LAYER_ENEMY);
             bool hitWall = false;
             for (const auto &col : collisions)
             {
@@ -3251,33 +2804,24 @@ void SeismicSlamAttack::applyShockwaveDamage(UpdateContext &uc)
     
     Vector3 impactPos = uc.player->pos();
     
-    for (Entity *entity : uc.scene->em.getEntities())
+    uc.scene->em.QuerySphere(impactPos, shockwaveEndRadius, this->targets);
+    for (Enemy *enemy : this->targets)
     {
-        if (!entity || entity->category() != ENTITY_ENEMY)
-            continue;
+        // Deal damage
+        uc.scene->events.Damage(enemy, slamDamage);
         
-        Enemy *enemy = static_cast<Enemy *>(entity);
-        float dist = Vector3Distance(impactPos, enemy->pos());
-        
-        if (dist <= shockwaveEndRadius)
-        {
-            // Deal damage
-            CollisionResult cResult;
-            DamageResult damage(slamDamage, cResult);
-            uc.scene->em.damage(enemy, damage, uc);
-            
-            // Apply knockback
-            Vector3 delta = Vector3Subtract(enemy->pos(), impactPos);
-            delta.y = 0.0f;
-            if (Vector3LengthSqr(delta) < 0.0001f)
-                delta = {1.0f, 0.0f, 0.0f};
-            Vector3 pushDir = Vector3Normalize(delta);
-            enemy->applyKnockback(
-                Vector3Scale(pushDir, slamKnockback),
-                slamKnockbackDuration,
-                slamLift
-            );
-        }
+        // Apply knockback
+        Vector3 delta = Vector3Subtract(enemy->pos(), impactPos);
+        delta.y = 0.0f;
+        if (Vector3LengthSqr(delta) < 0.0001f)
+            delta = {1.0f, 0.0f, 0.0f};
+        Vector3 pushDir = Vector3Normalize(delta);
+        uc.scene->events.Knockback(
+            enemy,
+            Vector3Scale(pushDir, slamKnockback),
+            slamKnockbackDuration,
+            slamLift
+        );
     }
 }
 
@@ -3288,7 +2832,7 @@ void SeismicSlamAttack::updateCameraLook(UpdateContext &uc, float targetPitch)
     
     float &currentPitch = uc.player->getLookRotation().y;
     float pitchDiff = targetPitch - currentPitch;
-    currentPitch += pitchDiff * cameraTransitionSpeed * GetFrameTime();
+    currentPitch += pitchDiff * cameraTransitionSpeed * uc.deltaTime;
 }
 
 void SeismicSlamAttack::restoreCameraControl(UpdateContext &uc)
@@ -3356,21 +2900,19 @@ float SeismicSlamAttack::getCooldownPercent() const
     return Clamp(1.0f - (cooldownRemaining / cooldownDuration), 0.0f, 1.0f);
 }
 
-std::vector<Object *> SeismicSlamAttack::obj()
+void SeismicSlamAttack::visitObjects(Visitor<Object> visit)
 {
-    std::vector<Object *> ret;
     if (shockwaveActive)
     {
-        ret.push_back(&shockwaveRing);
+        visit(&shockwaveRing);
     }
     if (tweakModeEnabled && !debugArcPoints.empty())
     {
         for (auto &pt : debugArcPoints)
         {
-            ret.push_back(&pt);
+            visit(&pt);
         }
     }
-    return ret;
 }
 
 // ============================================================================
@@ -1,4 +1,5 @@
 #include "attackManager.hpp"
+#include "scene.hpp"
 #include <array>
 #include <algorithm>
 #include <iostream>
@@ -11,16 +12,6 @@ bool isCharacterTile(TileType tile)
     return tile >= TileType::CHARACTER_1 && tile <= TileType::CHARACTER_9;
 }
 
-int getCharacterValue(TileType tile)
-{
-    return static_cast<int>(tile) - static_cast<int>(TileType::CHARACTER_1) + 1;
-}
-
-int getBambooValue(TileType tile)
-{
-    return static_cast<int>(tile) - static_cast<int>(TileType::BAMBOO_1) + 1;
-}
-
 bool isDotTile(TileType tile)
 {
     return tile >= TileType::DOT_1 && tile <= TileType::DOT_9;
@@ -76,88 +67,113 @@ AttackArchetype getAttackArchetype(TileType tile)
 }
 }
 
-// Destructor cleans up dynamically allocated ThousandAttack instances
+// Destructor cleans up every controller in the registry
 AttackManager::~AttackManager()
- {
-    for (auto &a : this->basicTileAttacks)
-        delete a;
-    for (auto &m : this->meleeAttacks)
-        delete m;
-    for (auto &d : this->dashAttacks)
-        delete d;
-    for (auto &b : this->bambooBombAttacks)
-        delete b;
-    for (auto &b : this->bambooTripleAttacks)
-        delete b;
-    for (auto &d : this->dragonClawAttacks)
-        delete d;
-    for (auto &a : this->arcaneOrbAttacks)
-        delete a;
-    for (auto &f : this->fanShotAttacks)
-        delete f;
-    for (auto &s : this->seismicSlamAttacks)
-        delete s;
-    for (auto &g : this->gravityWellAttacks)
-        delete g;
-    for (auto &c : this->chainLightningAttacks)
+{
+    for (auto &entry : this->controllers)
+    {
+        for (AttackController *c : entry.second)
+            delete c;
+    }
+}
+
+void AttackManager::schedule(AttackController *controller)
+{
+    if (controller->scheduled)
+        return;
+    controller->scheduled = true;
+    this->active.push_back(controller);
+}
+
+// Drops the controllers of enemies that no longer exist; the player's have a null handle and stay
+void AttackManager::releaseDeadOwners(UpdateContext &uc)
+{
+    if (!uc.scene)
+        return;
+
+    // Scheduled controllers are checked every tick since update() would touch their owner;
+    // idle ones only every sweepInterval ticks
+    std::vector<OwnerKey> dead;
+    for (AttackController *c : this->active)
+    {
+        if (!c->ownerHandle.isNull() && !uc.scene->em.Get(c->ownerHandle))
+            dead.push_back(OwnerKey{c->spawnedBy, c->ownerHandle});
+    }
+    if (++this->sweepCounter >= sweepInterval)
+    {
+        this->sweepCounter = 0;
+        for (const auto &entry : this->controllers)
+        {
+            if (!entry.first.handle.isNull() && !uc.scene->em.Get(entry.first.handle))
+                dead.push_back(entry.first);
+        }
+    }
+
+    for (const OwnerKey &key : dead)
+        this->releaseOwner(key);
+}
+
+void AttackManager::releaseAttacks(const Entity *owner)
+{
+    if (owner)
+        this->releaseOwner(OwnerKey{owner, owner->getHandle()});
+}
+
+void AttackManager::releaseOwner(const OwnerKey &key)
+{
+    auto it = this->controllers.find(key);
+    if (it == this->controllers.end())
+        return;
+
+    for (AttackController *c : it->second)
+    {
+        if (!c)
+            continue;
+        if (c->scheduled)
+            this->active.erase(std::find(this->active.begin(), this->active.end(), c));
+        if (this->attackLockOwner == c)
+            this->attackLockOwner = nullptr;
         delete c;
-    for (auto &o : this->orbitalShieldAttacks)
-        delete o;
+    }
+    this->controllers.erase(it);
 }
 
-// Updates all ThousandAttack instances
+// Updates the scheduled controllers and drops the ones that went idle
 void AttackManager::update(UpdateContext& uc)
 {
-    for (auto &a : this->basicTileAttacks)
-        a->update(uc);
-    for (auto &m : this->meleeAttacks)
-        m->update(uc);
-    for (auto &d : this->dashAttacks)
-        d->update(uc);
-    for (auto &b : this->bambooBombAttacks)
-        b->update(uc);
-    for (auto &b : this->bambooTripleAttacks)
-        b->update(uc);
-    for (auto &d : this->dragonClawAttacks)
-        d->update(uc);
-    for (auto &a : this->arcaneOrbAttacks)
-        a->update(uc);
-    for (auto &f : this->fanShotAttacks)
-        f->update(uc);
-    for (auto &s : this->seismicSlamAttacks)
-        s->update(uc);
-    for (auto &g : this->gravityWellAttacks)
-        g->update(uc);
-    for (auto &c : this->chainLightningAttacks)
-        c->update(uc);
-    for (auto &o : this->orbitalShieldAttacks)
-        o->update(uc);
+    this->releaseDeadOwners(uc);
 
-    // Update BambooBasicAttack cooldown modifiers based on BambooBasicBuffAttack state
-    for (auto &basic : this->basicTileAttacks)
+    // Controllers fetched during this loop are appended and updated in the same tick
+    for (size_t i = 0; i < this->active.size(); ++i)
     {
-        // Find associated bamboo triple attack (same spawner)
-        BambooBasicBuffAttack *bamboo = nullptr;
-        for (auto &b : this->bambooTripleAttacks)
+        AttackController *c = this->active[i];
+        c->update(uc);
+
+        // Keep the owner's BambooBasicAttack cooldown modifier in step with the buff
+        if (c->kind == AttackKind::BambooBuff)
         {
-            if (b->spawnedBy == basic->spawnedBy)
+            BambooBasicBuffAttack *bamboo = static_cast<BambooBasicBuffAttack *>(c);
+            auto it = this->controllers.find(OwnerKey{c->spawnedBy, c->ownerHandle});
+            AttackController *slot = it->second[(size_t)AttackKind::BasicTile];
+            if (BambooBasicAttack *basic = static_cast<BambooBasicAttack *>(slot))
             {
-                bamboo = b;
-                break;
+                if (bamboo->isActive())
+                    basic->setCooldownModifier(0.4f); // 40% = faster shooting
+                else
+                    basic->resetCooldownModifier(); // Back to normal
             }
         }
-        
-        // Update cooldown modifier based on effect state
-        if (bamboo && bamboo->isActive())
-        {
-            basic->setCooldownModifier(0.4f); // 40% = faster shooting
-        }
-        else
-        {
-            basic->resetCooldownModifier(); // Back to normal
-        }
     }
 
+    // Stable compaction keeps update order deterministic
+    auto kept = std::remove_if(this->active.begin(), this->active.end(), [](AttackController *c) {
+        if (!c->isIdle())
+            return false;
+        c->scheduled = false;
+        return true;
+    });
+    this->active.erase(kept, this->active.end());
+
     if (uc.uiManager)
     {
         for (int slotIdx = 0; slotIdx < UIManager::slotCount; ++slotIdx)
@@ -177,10 +193,7 @@ void AttackManager::update(UpdateContext& uc)
             // Three or more tiles: check if they form a valid combo
             else
             {
-                SlotAttackKind kind = classifySlotAttack(slotEntries);
-                // Only DefaultThrow and None are invalid for 3+ tiles
-                bool valid = (kind != SlotAttackKind::None && kind != SlotAttackKind::DefaultThrow);
-                uc.uiManager->setSlotValidity(slotIdx, valid);
+                uc.uiManager->setSlotValidity(slotIdx, IsSkillCombo(slotCombo(slotIdx, *uc.uiManager)));
             }
 
             float percent = computeSlotCooldownPercent(slotIdx, uc);
@@ -189,352 +202,53 @@ void AttackManager::update(UpdateContext& uc)
     }
 }
 
-bool AttackManager::triggerSlotAttack(int slotIndex, UpdateContext &uc)
+TileCombo AttackManager::slotCombo(int slotIndex, const UIManager &ui)
 {
-    if (!uc.player || !uc.uiManager)
-        return false;
-
-    const auto &slotEntries = uc.uiManager->getSlotEntries(slotIndex);
-    if (slotEntries.empty())
-        return false;
-
-    const bool canCheckCombo = slotEntries.size() >= 3;
-    std::array<int, 3> characterValues{};
-    bool allValidCharacters = canCheckCombo;
-    if (canCheckCombo)
-    {
-        for (int i = 0; i < 3; ++i)
-        {
-            const auto &entry = slotEntries[i];
-            if (!entry.isValid() || !isCharacterTile(entry.tile))
-            {
-                allValidCharacters = false;
-                break;
-            }
-            characterValues[i] = getCharacterValue(entry.tile);
-        }
-    }
-
-    bool isDot1Triple = false;
-    bool isDot2Triple = false;
-    bool isDot123 = false;
-    if (canCheckCombo)
-    {
-        const auto &a = slotEntries[0];
-        const auto &b = slotEntries[1];
-        const auto &c = slotEntries[2];
-        if (a.isValid() && b.isValid() && c.isValid())
-        {
-            isDot1Triple = isDotTile(a.tile) && a.tile == TileType::DOT_1 && a.tile == b.tile && b.tile == c.tile;
-            isDot2Triple = isDotTile(a.tile) && a.tile == TileType::DOT_2 && a.tile == b.tile && b.tile == c.tile;
-
-            if (isDotTile(a.tile) && isDotTile(b.tile) && isDotTile(c.tile))
-            {
-                std::array<int, 3> dotVals{
-                    static_cast<int>(a.tile), static_cast<int>(b.tile), static_cast<int>(c.tile)};
-                std::sort(dotVals.begin(), dotVals.end());
-                isDot123 = (dotVals[0] == static_cast<int>(TileType::DOT_1) &&
-                            dotVals[1] == static_cast<int>(TileType::DOT_2) &&
-                            dotVals[2] == static_cast<int>(TileType::DOT_3));
-            }
-        }
-    }
-
-    bool isBambooTriple = false;
-    int bambooValue = 0;
-    if (canCheckCombo && !(isDot1Triple || isDot2Triple || isDot123))
+    SlotComboCache &cache = this->slotCombos[slotIndex];
+    unsigned int revision = ui.getSlotRevision(slotIndex);
+    if (!cache.known || cache.revision != revision)
     {
-        const auto &first = slotEntries[0];
-        if (first.isValid() && isBambooTile(first.tile))
-        {
-            isBambooTriple = true;
-            bambooValue = getBambooValue(first.tile);
-            for (int i = 1; i < 3; ++i)
-            {
-                if (!slotEntries[i].isValid() || slotEntries[i].tile != first.tile)
-                {
-                    isBambooTriple = false;
-                    break;
-                }
-            }
-        }
+        cache.combo = ClassifyTileCombo(ui.getSlotEntries(slotIndex));
+        cache.revision = revision;
+        cache.known = true;
     }
-
-    if (isDot1Triple)
-    {
-        if (GravityWellAttack *gw = getGravityWellAttack(uc.player))
-        {
-            if (gw->trigger(uc))
-                return true;
-        }
-        return false;
-    }
-
-    if (isDot2Triple)
-    {
-        if (OrbitalShieldAttack *shield = getOrbitalShieldAttack(uc.player))
-        {
-            if (shield->trigger(uc))
-                return true;
-        }
-        return false;
-    }
-
-    if (isDot123)
-    {
-        if (ChainLightningAttack *chain = getChainLightningAttack(uc.player))
-        {
-            if (chain->trigger(uc))
-                return true;
-        }
-        return false;
-    }
-
-    if (isBambooTriple)
-    {
-        if (bambooValue == 1)
-        {
-            if (BambooBasicBuffAttack *bamboo = getBambooTripleAttack(uc.player))
-            {
-                bamboo->trigger(uc);
-                if (BambooBasicAttack *basic = getBasicTileAttack(uc.player))
-                {
-                    basic->setCooldownModifier(0.4f);
-                }
-                return true;
-            }
-        }
-        else if (bambooValue == 2)
-        {
-            if (BambooBombAttack *bomb = getBambooBombAttack(uc.player))
-            {
-                if (bomb->trigger(uc, slotEntries[0].tile))
-                    return true;
-            }
-        }
-        return false;
-    }
-
-    // Check for FanShot combo (Bamboo 1-2-3 sequence)
-    if (canCheckCombo)
-    {
-        if (slotEntries[0].isValid() && slotEntries[1].isValid() && slotEntries[2].isValid())
-        {
-            if (isBambooTile(slotEntries[0].tile) && isBambooTile(slotEntries[1].tile) && isBambooTile(slotEntries[2].tile))
-            {
-                int val0 = getBambooValue(slotEntries[0].tile);
-                int val1 = getBambooValue(slotEntries[1].tile);
-                int val2 = getBambooValue(slotEntries[2].tile);
-                
-                std::array<int, 3> sortedBamboo = {val0, val1, val2};
-                std::sort(sortedBamboo.begin(), sortedBamboo.end());
-                
-                if (sortedBamboo[0] == 1 && sortedBamboo[1] == 2 && sortedBamboo[2] == 3)
-                {
-                    if (FanShotAttack *fanShot = getFanShotAttack(uc.player))
-                    {
-                        if (fanShot->trigger(uc))
-                            return true;
-                    }
-                    return false;
-                }
-            }
-        }
-    }
-
-    if (canCheckCombo && allValidCharacters)
-    {
-        // Check for SeismicSlam combo (Character 2-2-2)
-        if (characterValues[0] == 2 && characterValues[1] == 2 && characterValues[2] == 2)
-        {
-            if (SeismicSlamAttack *slam = getSeismicSlamAttack(uc.player))
-            {
-                if (slam->trigger(uc))
-                    return true;
-            }
-            return false;
-        }
-        
-        bool isMeleeCombo = (characterValues[0] == characterValues[1]) && (characterValues[1] == characterValues[2]);
-        bool isDashCombo = false;
-        if (!isMeleeCombo)
-        {
-            auto sortedValues = characterValues;
-            std::sort(sortedValues.begin(), sortedValues.end());
-            isDashCombo = (sortedValues[0] + 1 == sortedValues[1]) && (sortedValues[1] + 1 == sortedValues[2]);
-        }
-
-        if (isMeleeCombo)
-        {
-            if (MeleePushAttack *melee = getMeleePushAttack(uc.player))
-            {
-                melee->trigger(uc);
-                return true;
-            }
-            return false;
-        }
-
-        if (isDashCombo)
-        {
-            if (DashAttack *dash = getDashAttack(uc.player))
-            {
-                dash->trigger(uc);
-                return true;
-            }
-            return false;
-        }
-    }
-
-    return false;
+    return cache.combo;
 }
 
-std::string AttackManager::classifyAttackType(const std::vector<SlotTileEntry> &tiles)
+bool AttackManager::triggerSlotAttack(int slotIndex, UpdateContext &uc)
 {
-    if (tiles.empty())
-        return "NA";
-
-    bool canCheckCombo = tiles.size() >= 3;
-    std::array<int, 3> characterValues{};
-    bool allValidCharacters = canCheckCombo;
-    if (canCheckCombo)
-    {
-        for (int i = 0; i < 3; ++i)
-        {
-            const auto &entry = tiles[i];
-            if (!entry.isValid() || !isCharacterTile(entry.tile))
-            {
-                allValidCharacters = false;
-                break;
-            }
-            characterValues[i] = getCharacterValue(entry.tile);
-        }
-    }
-
-    bool isDot1Triple = false;
-    bool isDot2Triple = false;
-    bool isDot123 = false;
-    if (canCheckCombo)
-    {
-        const auto &a = tiles[0];
-        const auto &b = tiles[1];
-        const auto &c = tiles[2];
-        if (a.isValid() && b.isValid() && c.isValid())
-        {
-            isDot1Triple = isDotTile(a.tile) && a.tile == TileType::DOT_1 && a.tile == b.tile && b.tile == c.tile;
-            isDot2Triple = isDotTile(a.tile) && a.tile == TileType::DOT_2 && a.tile == b.tile && b.tile == c.tile;
-            if (isDotTile(a.tile) && isDotTile(b.tile) && isDotTile(c.tile))
-            {
-                std::array<int, 3> dots{
-                    static_cast<int>(a.tile), static_cast<int>(b.tile), static_cast<int>(c.tile)};
-                std::sort(dots.begin(), dots.end());
-                isDot123 = (dots[0] == static_cast<int>(TileType::DOT_1) &&
-                            dots[1] == static_cast<int>(TileType::DOT_2) &&
-                            dots[2] == static_cast<int>(TileType::DOT_3));
-            }
-        }
-    }
-
-    if (isDot1Triple)
-        return "GravityWell";
-    if (isDot2Triple)
-        return "OrbitalShield";
-    if (isDot123)
-        return "ChainLightning";
-
-    // Check Bamboo Triple (e.g., Bamboo 3-3-3)
-    bool isBambooTriple = false;
-    int bambooValue = 0;
-    if (canCheckCombo && !(isDot1Triple || isDot2Triple || isDot123))
-    {
-        const auto &first = tiles[0];
-        if (first.isValid() && isBambooTile(first.tile))
-        {
-            isBambooTriple = true;
-            bambooValue = getBambooValue(first.tile);
-            for (int i = 1; i < 3; ++i)
-            {
-                if (!tiles[i].isValid() || tiles[i].tile != first.tile)
-                {
-                    isBambooTriple = false;
-                    break;
-                }
-            }
-        }
-    }
-
-    if (isBambooTriple)
-    {
-        if (bambooValue == 1)
-            return "BambooTriple";
-        if (bambooValue == 2)
-            return "BambooBomb";
-    }
-
-    // Check for Bamboo FanShot combo (1-2-3 in any order)
-    if (canCheckCombo)
-    {
-        if (tiles[0].isValid() && tiles[1].isValid() && tiles[2].isValid())
-        {
-            if (isBambooTile(tiles[0].tile) && isBambooTile(tiles[1].tile) && isBambooTile(tiles[2].tile))
-            {
-                int val0 = getBambooValue(tiles[0].tile);
-                int val1 = getBambooValue(tiles[1].tile);
-                int val2 = getBambooValue(tiles[2].tile);
-                
-                std::array<int, 3> sortedBamboo = {val0, val1, val2};
-                std::sort(sortedBamboo.begin(), sortedBamboo.end());
-                
-                if (sortedBamboo[0] == 1 && sortedBamboo[1] == 2 && sortedBamboo[2] == 3)
-                    return "FanShot";
-            }
-        }
-    }
-
-    // Check Character combos
-    if (canCheckCombo && allValidCharacters)
-    {
-        // Seismic Slam: Character 2-2-2
-        if (characterValues[0] == 2 && characterValues[1] == 2 && characterValues[2] == 2)
-            return "SeismicSlam";
-        
-        // Melee: All same value
-        bool isMeleeCombo = (characterValues[0] == characterValues[1]) && (characterValues[1] == characterValues[2]);
-
-        // Dash: Sequential values in any order (e.g., 1-2-3, 3-4-5)
-        auto sortedValues = characterValues;
-        std::sort(sortedValues.begin(), sortedValues.end());
-        bool isDashCombo = (sortedValues[0] + 1 == sortedValues[1]) && (sortedValues[1] + 1 == sortedValues[2]);
+    if (!uc.player || !uc.uiManager || slotIndex < 0 || slotIndex >= UIManager::slotCount)
+        return false;
 
-        if (isMeleeCombo)
-            return "Melee";
-        if (isDashCombo)
-            return "Dash";
+    switch (slotCombo(slotIndex, *uc.uiManager))
+    {
+    case TileCombo::GravityWell:
+        return getGravityWellAttack(uc.player)->trigger(uc);
+    case TileCombo::OrbitalShield:
+        return getOrbitalShieldAttack(uc.player)->trigger(uc);
+    case TileCombo::ChainLightning:
+        return getChainLightningAttack(uc.player)->trigger(uc);
+    case TileCombo::BambooTriple:
+        getBambooTripleAttack(uc.player)->trigger(uc);
+        getBasicTileAttack(uc.player)->setCooldownModifier(0.4f);
+        return true;
+    case TileCombo::BambooBomb:
+        return getBambooBombAttack(uc.player)->trigger(uc, uc.uiManager->getSlotEntries(slotIndex)[0].tile);
+    case TileCombo::FanShot:
+        return getFanShotAttack(uc.player)->trigger(uc);
+    case TileCombo::SeismicSlam:
+        return getSeismicSlamAttack(uc.player)->trigger(uc);
+    case TileCombo::Melee:
+        getMeleePushAttack(uc.player)->trigger(uc);
+        return true;
+    case TileCombo::Dash:
+        getDashAttack(uc.player)->trigger(uc);
+        return true;
+    case TileCombo::None:
+    case TileCombo::DefaultThrow:
+    default:
+        return false;
     }
-
-    // Default throw for single valid tile
-    if (tiles.front().isValid())
-        return "DefaultThrow";
-
-    return "NA";
-}
-
-AttackManager::SlotAttackKind AttackManager::classifySlotAttack(const std::vector<SlotTileEntry> &slotEntries) const
-{
-    // Use the static function and convert back to enum
-    std::string attackType = classifyAttackType(slotEntries);
-    
-    if (attackType == "GravityWell") return SlotAttackKind::GravityWell;
-    if (attackType == "OrbitalShield") return SlotAttackKind::OrbitalShield;
-    if (attackType == "ChainLightning") return SlotAttackKind::ChainLightning;
-    if (attackType == "BambooBomb") return SlotAttackKind::DotBomb; // legacy enum name kept for UI coloring
-    if (attackType == "BambooTriple") return SlotAttackKind::BambooTriple;
-    if (attackType == "FanShot") return SlotAttackKind::FanShot;
-    if (attackType == "SeismicSlam") return SlotAttackKind::SeismicSlam;
-    if (attackType == "Melee") return SlotAttackKind::Melee;
-    if (attackType == "Dash") return SlotAttackKind::Dash;
-    if (attackType == "DefaultThrow") return SlotAttackKind::DefaultThrow;
-    
-    return SlotAttackKind::None;
 }
 
 float AttackManager::computeSlotCooldownPercent(int slotIndex, UpdateContext &uc)
@@ -542,200 +256,78 @@ float AttackManager::computeSlotCooldownPercent(int slotIndex, UpdateContext &uc
     if (!uc.uiManager || !uc.player)
         return 0.0f;
 
-    const auto &slotEntries = uc.uiManager->getSlotEntries(slotIndex);
-    SlotAttackKind kind = classifySlotAttack(slotEntries);
-    switch (kind)
+    // Reading a cooldown must not wake an idle controller, so look it up without scheduling
+    switch (slotCombo(slotIndex, *uc.uiManager))
     {
-    case SlotAttackKind::DotBomb:
+    case TileCombo::BambooBomb:
     {
-        BambooBombAttack *bomb = getBambooBombAttack(uc.player);
+        BambooBombAttack *bomb = findOrCreate<BambooBombAttack>(uc.player);
         return bomb ? bomb->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::GravityWell:
+    case TileCombo::GravityWell:
     {
-        GravityWellAttack *gw = getGravityWellAttack(uc.player);
+        GravityWellAttack *gw = findOrCreate<GravityWellAttack>(uc.player);
         return gw ? gw->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::ChainLightning:
+    case TileCombo::ChainLightning:
     {
-        ChainLightningAttack *cl = getChainLightningAttack(uc.player);
+        ChainLightningAttack *cl = findOrCreate<ChainLightningAttack>(uc.player);
         return cl ? cl->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::OrbitalShield:
+    case TileCombo::OrbitalShield:
     {
-        OrbitalShieldAttack *os = getOrbitalShieldAttack(uc.player);
+        OrbitalShieldAttack *os = findOrCreate<OrbitalShieldAttack>(uc.player);
         return os ? os->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::BambooTriple:
+    case TileCombo::BambooTriple:
     {
-        BambooBasicBuffAttack *bamboo = getBambooTripleAttack(uc.player);
+        BambooBasicBuffAttack *bamboo = findOrCreate<BambooBasicBuffAttack>(uc.player);
         return bamboo ? bamboo->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::Melee:
+    case TileCombo::Melee:
     {
-        MeleePushAttack *melee = getMeleePushAttack(uc.player);
+        MeleePushAttack *melee = findOrCreate<MeleePushAttack>(uc.player);
         return melee ? melee->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::Dash:
+    case TileCombo::Dash:
     {
-        DashAttack *dash = getDashAttack(uc.player);
+        DashAttack *dash = findOrCreate<DashAttack>(uc.player);
         return dash ? dash->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::FanShot:
+    case TileCombo::FanShot:
     {
-        FanShotAttack *fanShot = getFanShotAttack(uc.player);
+        FanShotAttack *fanShot = findOrCreate<FanShotAttack>(uc.player);
         return fanShot ? fanShot->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::SeismicSlam:
+    case TileCombo::SeismicSlam:
     {
-        SeismicSlamAttack *slam = getSeismicSlamAttack(uc.player);
+        SeismicSlamAttack *slam = findOrCreate<SeismicSlamAttack>(uc.player);
         return slam ? slam->getCooldownPercent() : 0.0f;
     }
-    case SlotAttackKind::None:
-    case SlotAttackKind::DefaultThrow:
+    case TileCombo::None:
+    case TileCombo::DefaultThrow:
     default:
         // Empty slots or default throws should show as ready (not gray)
         return 1.0f;
     }
 }
 
-BambooBasicAttack *AttackManager::getBasicTileAttack(Entity *spawnedBy)
-{
-    for (const auto &a : this->basicTileAttacks)
-    {
-        if (a->spawnedBy == spawnedBy)
-            return a;
-    }
-    // Create a new BambooBasicAttack if none exists for the entity
-    this->basicTileAttacks.push_back(new BambooBasicAttack(spawnedBy));
-    return this->basicTileAttacks.back();
-}
-
-MeleePushAttack *AttackManager::getMeleePushAttack(Entity *spawnedBy)
-{
-    for (const auto &m : this->meleeAttacks)
-    {
-        if (m->spawnedBy == spawnedBy)
-            return m;
-    }
-    this->meleeAttacks.push_back(new MeleePushAttack(spawnedBy));
-    return this->meleeAttacks.back();
-}
-
-DashAttack *AttackManager::getDashAttack(Entity *spawnedBy)
-{
-    for (const auto &d : this->dashAttacks)
-    {
-        if (d->spawnedBy == spawnedBy)
-            return d;
-    }
-    this->dashAttacks.push_back(new DashAttack(spawnedBy));
-    return this->dashAttacks.back();
-}
-
-BambooBasicBuffAttack *AttackManager::getBambooTripleAttack(Entity *spawnedBy)
-{
-    for (const auto &b : this->bambooTripleAttacks)
-    {
-        if (b->spawnedBy == spawnedBy)
-            return b;
-    }
-    this->bambooTripleAttacks.push_back(new BambooBasicBuffAttack(spawnedBy));
-    return this->bambooTripleAttacks.back();
-}
-
-BambooBombAttack *AttackManager::getBambooBombAttack(Entity *spawnedBy)
-{
-    for (const auto &b : this->bambooBombAttacks)
-    {
-        if (b->spawnedBy == spawnedBy)
-            return b;
-    }
-    this->bambooBombAttacks.push_back(new BambooBombAttack(spawnedBy));
-    return this->bambooBombAttacks.back();
-}
-
-std::vector<Entity *> AttackManager::getEntities(EntityCategory cat)
+void AttackManager::visitEntities(EntityCategory cat, Visitor<Entity> visit)
 {
-    std::vector<Entity *> ret;
     // If caller requests projectiles or all entities, include projectiles
     if (cat == ENTITY_PROJECTILE || cat == ENTITY_ALL)
     {
-        for (const auto &a : this->basicTileAttacks)
-        {
-            auto v = a->getEntities();
-            ret.insert(ret.end(), v.begin(), v.end());
-        }
-        for (const auto &b : this->bambooBombAttacks)
-        {
-            auto v = b->getEntities();
-            ret.insert(ret.end(), v.begin(), v.end());
-        }
-        for (const auto &f : this->fanShotAttacks)
-        {
-            auto v = f->getEntities();
-            ret.insert(ret.end(), v.begin(), v.end());
-        }
+        for (AttackController *c : this->active)
+            c->visitEntities(visit);
     }
-    return ret;
 }
 
-// Returns a list of objects representing all projectiles for rendering or collision detection
-std::vector<Object *> AttackManager::getObjects() const
+// Visits the objects of every projectile/effect for rendering or collision detection
+void AttackManager::visitObjects(Visitor<Object> visit) const
 {
-    std::vector<Object *> ret;
-    for (const auto &a : this->basicTileAttacks)
-    {
-        auto v = a->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &m : this->meleeAttacks)
-    {
-        auto v = m->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &b : this->bambooBombAttacks)
-    {
-        auto v = b->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &d : this->dragonClawAttacks)
-    {
-        auto v = d->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &a : this->arcaneOrbAttacks)
-    {
-        auto v = a->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &f : this->fanShotAttacks)
-    {
-        auto v = f->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &s : this->seismicSlamAttacks)
-    {
-        auto v = s->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &g : this->gravityWellAttacks)
-    {
-        auto v = g->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &c : this->chainLightningAttacks)
-    {
-        auto v = c->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    for (const auto &o : this->orbitalShieldAttacks)
-    {
-        auto v = o->obj();
-        ret.insert(ret.end(), v.begin(), v.end());
-    }
-    // dash attack currently has no objects to render
-    return ret;
+    // Idle controllers have nothing in flight, so the update list covers everything drawable
+    for (AttackController *c : this->active)
+        c->visitObjects(visit);
 }
 
 bool AttackManager::isAttackLockedByOther(const AttackController *controller) const
@@ -760,80 +352,3 @@ void AttackManager::releaseAttackLock(const AttackController *controller)
         this->attackLockOwner = nullptr;
     }
 }
-
-DragonClawAttack *AttackManager::getDragonClawAttack(Entity *spawnedBy)
-{
-    for (const auto &d : this->dragonClawAttacks)
-    {
-        if (d->spawnedBy == spawnedBy)
-            return d;
-    }
-    this->dragonClawAttacks.push_back(new DragonClawAttack(spawnedBy));
-    return this->dragonClawAttacks.back();
-}
-
-ArcaneOrbAttack *AttackManager::getArcaneOrbAttack(Entity *spawnedBy)
-{
-    for (const auto &a : this->arcaneOrbAttacks)
-    {
-        if (a->spawnedBy == spawnedBy)
-            return a;
-    }
-    this->arcaneOrbAttacks.push_back(new ArcaneOrbAttack(spawnedBy));
-    return this->arcaneOrbAttacks.back();
-}
-
-FanShotAttack *AttackManager::getFanShotAttack(Entity *spawnedBy)
-{
-    for (const auto &f : this->fanShotAttacks)
-    {
-        if (f->spawnedBy == spawnedBy)
-            return f;
-    }
-    this->fanShotAttacks.push_back(new FanShotAttack(spawnedBy));
-    return this->fanShotAttacks.back();
-}
-
-SeismicSlamAttack *AttackManager::getSeismicSlamAttack(Entity *spawnedBy)
-{
-    for (const auto &s : this->seismicSlamAttacks)
-    {
-        if (s->spawnedBy == spawnedBy)
-            return s;
-    }
-    this->seismicSlamAttacks.push_back(new SeismicSlamAttack(spawnedBy));
-    return this->seismicSlamAttacks.back();
-}
-
-GravityWellAttack *AttackManager::getGravityWellAttack(Entity *spawnedBy)
-{
-    for (const auto &g : this->gravityWellAttacks)
-    {
-        if (g->spawnedBy == spawnedBy)
-            return g;
-    }
-    this->gravityWellAttacks.push_back(new GravityWellAttack(spawnedBy));
-    return this->gravityWellAttacks.back();
-}
-
-ChainLightningAttack *AttackManager::getChainLightningAttack(Entity *spawnedBy)
-{
-    for (const auto &c : this->chainLightningAttacks)
-    {
-        if (c->spawnedBy == spawnedBy)
-            return c;
-    }
-    this->chainLightningAttacks.push_back(new ChainLightningAttack(spawnedBy));
-    return this->chainLightningAttacks.back();
-}
-
-OrbitalShieldAttack *AttackManager::getOrbitalShieldAttack(Entity *spawnedBy)
-{
-    for (const auto &o : this->orbitalShieldAttacks)
-    {
-        if (o->spawnedBy == spawnedBy)
-            return o;
-    }
-    this->orbitalShieldAttacks.push_back(new OrbitalShieldAttack(spawnedBy));
-    return this->orbitalShieldAttacks.back();
-}
\ No newline at end of file
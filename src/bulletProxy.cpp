@@ -0,0 +1,267 @@
+#include "bulletProxy.hpp"
+
+namespace
+{
+// Ghosts only ever pair with decorations, never with each other.
+int ProxyMask(const Object &obj)
+{
+    return (int)(obj.collisionMask & COLLISION_LAYER_DECORATION);
+}
+
+// Parked ghosts wait far below the level, so the next SetTransform is a
+// teleport and the broadphase pairs them afresh even at the same spot.
+constexpr float PARKING_DEPTH = -10000.0f;
+}
+
+void BulletProxy::Retire(BulletProxy *proxy)
+{
+    if (!proxy)
+    {
+        return;
+    }
+    if (proxy->pool)
+    {
+        proxy->pool->Park(proxy);
+    }
+    else
+    {
+        delete proxy;
+    }
+}
+
+bool BulletProxy::MatchesShape(const Object &obj) const
+{
+    const Vector3 &size = obj.getSize();
+    return this->shape && this->shapeKind == obj.shape &&
+           this->shapeSize.x == size.x && this->shapeSize.y == size.y && this->shapeSize.z == size.z &&
+           this->filterGroup == (int)obj.collisionLayer && this->filterMask == ProxyMask(obj);
+}
+
+void BulletProxy::SetShape(btCollisionShape *newShape, const Object &obj)
+{
+    // Cached pair algorithms depend on the shape, so swap it outside the world.
+    if (this->inWorld && this->pool && this->pool->world)
+    {
+        this->pool->world->removeCollisionObject(&this->ghost);
+        this->inWorld = false;
+    }
+    this->shape.reset(newShape);
+    this->shapeKind = obj.shape;
+    this->shapeSize = obj.getSize();
+    this->filterGroup = (int)obj.collisionLayer;
+    this->filterMask = ProxyMask(obj);
+    this->ghost.setCollisionShape(this->shape.get());
+    this->ghost.setCollisionFlags(this->ghost.getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+}
+
+void BulletProxy::SetTransform(const btTransform &transform)
+{
+    if (!this->pool || !this->pool->world || !this->shape)
+    {
+        return;
+    }
+
+    this->ghost.setWorldTransform(transform);
+    if (this->inWorld)
+    {
+        this->pool->world->updateSingleAabb(&this->ghost);
+    }
+    else
+    {
+        this->pool->world->addCollisionObject(&this->ghost, this->filterGroup, this->filterMask);
+        this->inWorld = true;
+    }
+}
+
+void BulletProxy::AppendContacts(std::vector<CollisionResult> &out)
+{
+    if (!this->inWorld || !this->pool || !this->pool->world)
+    {
+        return;
+    }
+
+    btCollisionWorld *world = this->pool->world;
+    btHashedOverlappingPairCache *pairCache = this->ghost.getOverlappingPairCache();
+    btBroadphasePairArray &pairs = pairCache->getOverlappingPairArray();
+    if (pairs.size() == 0)
+    {
+        return;
+    }
+
+    // Only this ghost's pairs are refreshed; the rest of the world is untouched.
+    world->getDispatcher()->dispatchAllCollisionPairs(pairCache, world->getDispatchInfo(), world->getDispatcher());
+
+    for (int i = 0; i < pairs.size(); ++i)
+    {
+        btBroadphasePair &pair = pairs[i];
+        if (!pair.m_algorithm)
+        {
+            continue;
+        }
+
+        this->manifolds.resize(0);
+        pair.m_algorithm->getAllContactManifolds(this->manifolds);
+        for (int m = 0; m < this->manifolds.size(); ++m)
+        {
+            const btPersistentManifold *manifold = this->manifolds[m];
+            // m_normalWorldOnB points from body1 towards body0.
+            float sign = (manifold->getBody0() == &this->ghost) ? 1.0f : -1.0f;
+            for (int c = 0; c < manifold->getNumContacts(); ++c)
+            {
+                const btManifoldPoint &point = manifold->getContactPoint(c);
+                if (point.getDistance() > 0.0f)
+                {
+                    continue;
+                }
+
+                btVector3 normal = point.m_normalWorldOnB;
+                Vector3 raylibNormal = Vector3Scale({normal.x(), normal.y(), normal.z()}, sign);
+                if (Vector3Length(raylibNormal) > 0.0f)
+                {
+                    raylibNormal = Vector3Normalize(raylibNormal);
+                }
+
+                CollisionResult result{};
+                result.with = nullptr;
+                result.collided = true;
+                result.penetration = -point.getDistance();
+                result.normal = raylibNormal;
+                out.push_back(result);
+            }
+        }
+    }
+}
+
+BulletProxyPool::~BulletProxyPool()
+{
+    this->Detach();
+}
+
+void BulletProxyPool::Attach(btCollisionWorld *world)
+{
+    this->Detach();
+    if (!world)
+    {
+        return;
+    }
+    this->world = world;
+    this->ghostPairCallback = std::make_unique<btGhostPairCallback>();
+    world->getBroadphase()->getOverlappingPairCache()->setInternalGhostPairCallback(this->ghostPairCallback.get());
+}
+
+void BulletProxyPool::Detach()
+{
+    for (BulletProxy *proxy : this->live)
+    {
+        if (proxy->inWorld && this->world)
+        {
+            this->world->removeCollisionObject(&proxy->ghost);
+        }
+        proxy->inWorld = false;
+        proxy->pool = nullptr;
+    }
+    this->live.clear();
+
+    for (BulletProxy *proxy : this->parked)
+    {
+        if (proxy->inWorld && this->world)
+        {
+            this->world->removeCollisionObject(&proxy->ghost);
+        }
+        delete proxy;
+    }
+    this->parked.clear();
+
+    if (this->world && this->ghostPairCallback)
+    {
+        this->world->getBroadphase()->getOverlappingPairCache()->setInternalGhostPairCallback(nullptr);
+    }
+    this->ghostPairCallback.reset();
+    this->world = nullptr;
+}
+
+BulletProxy *BulletProxyPool::Bind(const Object &obj)
+{
+    if (!this->world || !obj.bulletProxy.IsEnabled())
+    {
+        return nullptr;
+    }
+
+    BulletProxy *proxy = obj.bulletProxy.get();
+    if (proxy && proxy->pool == this)
+    {
+        return proxy;
+    }
+
+    // Either the first query or a proxy left behind by a previous world.
+    // Reuse a parked proxy before allocating, ideally one with the same shape.
+    if (!this->parked.empty())
+    {
+        size_t pick = this->parked.size() - 1;
+        for (size_t i = 0; i < this->parked.size(); ++i)
+        {
+            if (this->parked[i]->MatchesShape(obj))
+            {
+                pick = i;
+                break;
+            }
+        }
+        proxy = this->parked[pick];
+        this->parked[pick] = this->parked.back();
+        this->parked.pop_back();
+        this->SetHandleFilter(proxy, proxy->filterGroup, proxy->filterMask);
+    }
+    else
+    {
+        proxy = new BulletProxy(this);
+    }
+    proxy->poolIndex = this->live.size();
+    this->live.push_back(proxy);
+    obj.bulletProxy.reset(proxy);
+    return proxy;
+}
+
+void BulletProxyPool::PrunePairs()
+{
+    if (this->world && !this->live.empty())
+    {
+        this->world->getBroadphase()->calculateOverlappingPairs(this->world->getDispatcher());
+    }
+}
+
+void BulletProxyPool::Park(BulletProxy *proxy)
+{
+    // Leaving the ghost in the world keeps its broadphase handle allocated;
+    // an empty mask stops it pairing until the next Bind restores the filter.
+    this->SetHandleFilter(proxy, proxy->filterGroup, 0);
+    if (proxy->inWorld && this->world)
+    {
+        btTransform transform = proxy->ghost.getWorldTransform();
+        transform.setOrigin(btVector3(0.0f, PARKING_DEPTH, 0.0f));
+        proxy->ghost.setWorldTransform(transform);
+        this->world->updateSingleAabb(&proxy->ghost);
+    }
+
+    // Swap-remove keeps Park O(1).
+    size_t index = proxy->poolIndex;
+    BulletProxy *last = this->live.back();
+    this->live[index] = last;
+    last->poolIndex = index;
+    this->live.pop_back();
+    this->parked.push_back(proxy);
+}
+
+void BulletProxyPool::SetHandleFilter(BulletProxy *proxy, int group, int mask)
+{
+    btBroadphaseProxy *handle = proxy->ghost.getBroadphaseHandle();
+    if (!proxy->inWorld || !this->world || !handle)
+    {
+        return;
+    }
+    handle->m_collisionFilterGroup = group;
+    handle->m_collisionFilterMask = mask;
+    if (mask == 0)
+    {
+        this->world->getBroadphase()->getOverlappingPairCache()->removeOverlappingPairsContainingProxy(handle, this->world->getDispatcher());
+    }
+}
@@ -0,0 +1,292 @@
+#include "contactSolver.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <raymath.h>
+#include "scene.hpp"
+#include "me.hpp"
+
+namespace
+{
+    // Coarse direction of a normal (dominant axis and sign) so contacts keep their identity across ticks.
+    int NormalBucket(Vector3 n)
+    {
+        Vector3 a = {fabsf(n.x), fabsf(n.y), fabsf(n.z)};
+        int axis = (a.x >= a.y && a.x >= a.z) ? 0 : (a.y >= a.z ? 1 : 2);
+        float component = (axis == 0) ? n.x : (axis == 1 ? n.y : n.z);
+        return axis * 2 + (component < 0.0f ? 1 : 0);
+    }
+
+    unsigned long long ContactKey(const Entity *a, const Entity *b, int bucket)
+    {
+        unsigned long long h = (unsigned long long)(uintptr_t)a * 0x9E3779B97F4A7C15ull;
+        h ^= ((unsigned long long)(uintptr_t)b + (unsigned long long)bucket) * 0xC2B2AE3D27D4EB4Full;
+        return h;
+    }
+
+    void ClipVelocity(Entity *e, Vector3 normal)
+    {
+        Vector3 vel = e->vel();
+        float dot = Vector3DotProduct(vel, normal);
+        if (dot < 0.0f)
+        {
+            e->setVelocity(Vector3Subtract(vel, Vector3Scale(normal, dot)));
+        }
+    }
+}
+
+void ContactSolver::Solve(Scene &scene, Entity *player, const EntityView<Enemy> &enemies)
+{
+    this->bodies.clear();
+    this->bodyIndex.clear();
+    if (player && player->isContactPending())
+    {
+        this->bodies.push_back(player);
+    }
+    for (Entity *e : enemies)
+    {
+        if (e->isContactPending())
+        {
+            this->bodies.push_back(e);
+        }
+    }
+    if (this->bodies.empty())
+    {
+        this->warmStart.clear();
+        return;
+    }
+
+    for (int i = 0; i < (int)this->bodies.size(); ++i)
+    {
+        this->bodyIndex.emplace_back(this->bodies[i], i);
+    }
+    std::sort(this->bodyIndex.begin(), this->bodyIndex.end());
+    this->displacement.assign(this->bodies.size(), Vector3Zero());
+    this->islandParent.resize(this->bodies.size());
+    for (int i = 0; i < (int)this->bodies.size(); ++i)
+    {
+        this->islandParent[i] = i;
+    }
+
+    this->GatherContacts(scene, player);
+
+    // Group contacts by island so each island is relaxed on its own and can stop early.
+    this->contactOrder.resize(this->contacts.size());
+    for (int i = 0; i < (int)this->contacts.size(); ++i)
+    {
+        this->contactOrder[i] = i;
+    }
+    std::vector<int> &islandOf = this->contactIsland;
+    islandOf.resize(this->contacts.size());
+    for (int i = 0; i < (int)this->contacts.size(); ++i)
+    {
+        islandOf[i] = this->FindIsland(this->contacts[i].a);
+    }
+    std::sort(this->contactOrder.begin(), this->contactOrder.end(),
+              [&](int lhs, int rhs) { return islandOf[lhs] < islandOf[rhs]; });
+
+    size_t begin = 0;
+    while (begin < this->contactOrder.size())
+    {
+        size_t end = begin;
+        int island = islandOf[this->contactOrder[begin]];
+        while (end < this->contactOrder.size() && islandOf[this->contactOrder[end]] == island)
+        {
+            ++end;
+        }
+
+        for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration)
+        {
+            float error = 0.0f;
+            for (size_t i = begin; i < end; ++i)
+            {
+                this->SolveContact(this->contacts[this->contactOrder[i]], &error);
+            }
+            if (error < LINEAR_SLOP)
+            {
+                break;
+            }
+        }
+        begin = end;
+    }
+
+    // Remember this tick's pushes, the largest per key; contacts that vanished drop out of the cache.
+    this->nextWarmStart.clear();
+    for (const Contact &c : this->contacts)
+    {
+        this->nextWarmStart.push_back({c.key, c.lambda});
+    }
+    std::sort(this->nextWarmStart.begin(), this->nextWarmStart.end(),
+              [](const WarmStart &lhs, const WarmStart &rhs) { return lhs.key < rhs.key; });
+    size_t kept = 0;
+    for (const WarmStart &entry : this->nextWarmStart)
+    {
+        if (kept > 0 && this->nextWarmStart[kept - 1].key == entry.key)
+        {
+            this->nextWarmStart[kept - 1].lambda = fmaxf(this->nextWarmStart[kept - 1].lambda, entry.lambda);
+            continue;
+        }
+        this->nextWarmStart[kept++] = entry;
+    }
+    this->nextWarmStart.resize(kept);
+    this->warmStart.swap(this->nextWarmStart);
+
+    this->WriteBack();
+}
+
+void ContactSolver::GatherContacts(Scene &scene, Entity *player)
+{
+    this->contacts.clear();
+    int playerBody = (player && player->isContactPending()) ? 0 : -1;
+
+    for (int i = 0; i < (int)this->bodies.size(); ++i)
+    {
+        Entity *body = this->bodies[i];
+        Object &o = body->obj();
+        unsigned int mask = o.collisionMask;
+
+        // Walls, decorations and projectiles never move in response.
+        this->staticHits.clear();
+        Object::collided(o, &scene, mask & (COLLISION_MASK_STATIC | COLLISION_LAYER_PROJECTILE), this->staticHits);
+        for (const CollisionResult &hit : this->staticHits)
+        {
+            if (hit.collided && hit.with != body)
+            {
+                this->AddContact(i, -1, hit.normal, hit.penetration, hit.with);
+            }
+        }
+
+        // Enemies: pairs between two flagged bodies are added once, by the lower index.
+        if (mask & COLLISION_LAYER_ENEMY)
+        {
+            scene.QueryCollisionCandidates(OBB_GetBoundingBox(&o.obb), [&](Entity *other)
+            {
+                if (other == body)
+                {
+                    return;
+                }
+                int j = this->BodyIndexOf(other);
+                if (j >= 0 && j < i)
+                {
+                    return;
+                }
+                CollisionResult hit = Object::collided(o, other->obj());
+                if (hit.collided)
+                {
+                    this->AddContact(i, j, hit.normal, hit.penetration, other);
+                }
+            }, COLLISION_LAYER_ENEMY);
+        }
+
+        // The player is not in the enemy grid; treat it as immovable when it is not a body itself.
+        if (player && playerBody < 0 && body != player && (mask & COLLISION_LAYER_PLAYER))
+        {
+            CollisionResult hit = Object::collided(o, player->obj());
+            if (hit.collided)
+            {
+                this->AddContact(i, -1, hit.normal, hit.penetration, player);
+            }
+        }
+    }
+}
+
+void ContactSolver::AddContact(int a, int b, Vector3 normal, float penetration, const Entity *other)
+{
+    if (penetration <= 0.0f || Vector3LengthSqr(normal) < 1e-8f)
+    {
+        return;
+    }
+
+    Contact c;
+    c.a = a;
+    c.b = b;
+    c.normal = normal;
+    c.penetration = penetration;
+    c.key = ContactKey(this->bodies[a], other, NormalBucket(normal));
+    c.lambda = 0.0f;
+
+    if (b >= 0)
+    {
+        int rootA = this->FindIsland(a);
+        int rootB = this->FindIsland(b);
+        if (rootA != rootB)
+        {
+            this->islandParent[rootB] = rootA;
+        }
+    }
+
+    // Warm start: begin from last tick's push, never more than this tick's overlap.
+    auto cached = std::lower_bound(this->warmStart.begin(), this->warmStart.end(), c.key,
+                                   [](const WarmStart &entry, unsigned long long key) { return entry.key < key; });
+    if (cached != this->warmStart.end() && cached->key == c.key)
+    {
+        float wb = (b >= 0) ? 1.0f : 0.0f;
+        c.lambda = fminf(cached->lambda * WARM_START_FACTOR, penetration / (1.0f + wb));
+        this->displacement[a] = Vector3Add(this->displacement[a], Vector3Scale(normal, c.lambda));
+        if (b >= 0)
+        {
+            this->displacement[b] = Vector3Subtract(this->displacement[b], Vector3Scale(normal, c.lambda));
+        }
+    }
+    this->contacts.push_back(c);
+}
+
+int ContactSolver::BodyIndexOf(const Entity *e) const
+{
+    auto found = std::lower_bound(this->bodyIndex.begin(), this->bodyIndex.end(), e,
+                                  [](const std::pair<const Entity *, int> &entry, const Entity *key) { return entry.first < key; });
+    return (found != this->bodyIndex.end() && found->first == e) ? found->second : -1;
+}
+
+int ContactSolver::FindIsland(int body)
+{
+    while (this->islandParent[body] != body)
+    {
+        this->islandParent[body] = this->islandParent[this->islandParent[body]];
+        body = this->islandParent[body];
+    }
+    return body;
+}
+
+void ContactSolver::SolveContact(Contact &c, float *error)
+{
+    // Every flagged body has unit inverse mass; the other side of a static contact has none.
+    float wb = (c.b >= 0) ? 1.0f : 0.0f;
+    Vector3 relative = this->displacement[c.a];
+    if (c.b >= 0)
+    {
+        relative = Vector3Subtract(relative, this->displacement[c.b]);
+    }
+
+    float remaining = c.penetration - Vector3DotProduct(c.normal, relative);
+    float newLambda = fmaxf(0.0f, c.lambda + remaining / (1.0f + wb));
+    float step = newLambda - c.lambda;
+    c.lambda = newLambda;
+    *error = fmaxf(*error, fabsf(step));
+
+    this->displacement[c.a] = Vector3Add(this->displacement[c.a], Vector3Scale(c.normal, step));
+    if (c.b >= 0)
+    {
+        this->displacement[c.b] = Vector3Subtract(this->displacement[c.b], Vector3Scale(c.normal, step * wb));
+    }
+}
+
+void ContactSolver::WriteBack()
+{
+    for (const Contact &c : this->contacts)
+    {
+        if (c.lambda <= 0.0f)
+        {
+            continue;
+        }
+        ClipVelocity(this->bodies[c.a], c.normal);
+        if (c.b >= 0)
+        {
+            ClipVelocity(this->bodies[c.b], Vector3Negate(c.normal));
+        }
+    }
+
+    for (int i = 0; i < (int)this->bodies.size(); ++i)
+    {
+        this->bodies[i]->applyContactDisplacement(this->displacement[i]);
+    }
+}
@@ -1,6 +1,7 @@
 #include "dialogBox.hpp"
 #include <raymath.h>
 #include <cmath>
+#include <algorithm>
 
 DialogBox::DialogBox() = default;
 
@@ -31,6 +32,19 @@ bool DialogBox::ensureTexture() const
     return true;
 }
 
+void DialogBox::Reset()
+{
+    this->worldPosition = {0.0f, 0.0f, 0.0f};
+    this->fillPercent = 1.0f;
+    this->visible = true;
+    this->worldBarWidth = 2.5f;
+    this->worldBarHeight = 0.32f;
+    this->barVisibleDistance = 55.0f;
+    this->barOutline = {0, 0, 0, 220};
+    this->barBackground = {30, 30, 36, 220};
+    this->barFill = {230, 41, 55, 255};
+}
+
 void DialogBox::setFillPercent(float percent)
 {
     this->fillPercent = Clamp(percent, 0.0f, 1.0f);
@@ -122,3 +136,45 @@ bool DialogBox::Draw(const Camera &camera) const
 
     return true;
 }
+
+DialogBoxPool::~DialogBoxPool()
+{
+    for (DialogBox *box : this->freeBoxes)
+    {
+        delete box;
+    }
+}
+
+DialogBox *DialogBoxPool::Acquire()
+{
+    ++this->liveCount;
+    if (this->freeBoxes.empty())
+    {
+        return new DialogBox();
+    }
+    DialogBox *box = this->freeBoxes.back();
+    this->freeBoxes.pop_back();
+    box->Reset();
+    return box;
+}
+
+void DialogBoxPool::Release(DialogBox *box)
+{
+    if (!box)
+        return;
+    box->setVisible(false);
+    this->freeBoxes.push_back(box);
+    --this->liveCount;
+}
+
+void DialogBoxPool::Reserve(size_t count)
+{
+    // Room for every box, so releasing never grows the free list either
+    this->freeBoxes.reserve(this->liveCount + std::max(count, this->freeBoxes.size()));
+    while (this->freeBoxes.size() < count)
+    {
+        DialogBox *box = new DialogBox();
+        box->Prepare();
+        this->freeBoxes.push_back(box);
+    }
+}
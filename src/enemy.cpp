@@ -11,7 +11,7 @@
 // ---------------------------- MinionEnemy ----------------------------
 void MinionEnemy::UpdateBody(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     this->tickStatusTimers(delta);
     bool isStunned = this->updateStun(uc);
 
@@ -27,6 +27,7 @@ void MinionEnemy::UpdateBody(UpdateContext &uc)
     settings.decelGround = FRICTION * 1.1f;
     settings.decelAir = AIR_DRAG;
     settings.facingHint = toPlayer;
+    settings.batchedPhysics = true;
 
     if (!this->isKnockbackActive() && !isStunned && !this->isMovementDisabled())
     {
@@ -97,7 +98,11 @@ void MinionEnemy::UpdateBody(UpdateContext &uc)
     }
 
     this->UpdateCommonBehavior(uc, desiredDir, delta, settings);
-    this->updateElectrocute(delta);
+}
+
+void MinionEnemy::FinishBody(UpdateContext &uc)
+{
+    this->updateElectrocute(uc.deltaTime);
     this->UpdateDialog(uc);
 }
 
@@ -156,7 +161,35 @@ void Enemy::UpdateCommonBehavior(UpdateContext &uc, const Vector3 &desiredDirect
         params.zeroThreshold = (settings.maxSpeed > 0.0f) ? settings.maxSpeed * 0.01f : MAX_SPEED * 0.01f;
     }
 
+    this->movement.params = params;
+    this->movement.settings = settings;
+    this->movement.moveDir = moveDir;
+    this->movement.knockedBack = knockedBack;
+    this->movement.deltaSeconds = deltaSeconds;
+    if (settings.batchedPhysics && uc.scene && uc.scene->em.StageBody(this, this->BodyFor(params)))
+    {
+        this->movementStaged = true;
+        return;
+    }
+
     Entity::ApplyPhysics(this, uc, params);
+    this->FinishCommonBehavior(uc);
+}
+
+void Enemy::FinishStagedMovement(UpdateContext &uc, const KinematicsStore &bodies)
+{
+    this->movementStaged = false;
+    Entity::ApplyBatchedPhysics(this, uc, this->movement.params, bodies, this->kinematicsBody);
+    this->FinishCommonBehavior(uc);
+}
+
+void Enemy::FinishCommonBehavior(UpdateContext &uc)
+{
+    const MovementSettings &settings = this->movement.settings;
+    const Vector3 &moveDir = this->movement.moveDir;
+    bool knockedBack = this->movement.knockedBack;
+    float deltaSeconds = this->movement.deltaSeconds;
+    float floory = this->movement.params.floorY;
 
     if (settings.lockToGround && !knockedBack)
     {
@@ -253,6 +286,7 @@ void Enemy::UpdateCommonBehavior(UpdateContext &uc, const Vector3 &desiredDirect
     }
 
     this->o.UpdateOBB();
+    this->FinishBody(uc);
 }
 
 Enemy::~Enemy()
@@ -290,7 +324,7 @@ void Enemy::snapToGroundWithRotation(const Quaternion &rotation)
 // Implement Enemy::UpdateBody
 void Enemy::UpdateBody(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     this->tickStatusTimers(delta);
     bool isStunned = this->updateStun(uc);
 
@@ -316,7 +350,7 @@ void Enemy::UpdateBody(UpdateContext &uc)
 
 void ChargingEnemy::UpdateBody(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     this->tickStatusTimers(delta);
     bool isStunned = this->updateStun(uc);
 
@@ -622,6 +656,12 @@ void Enemy::tickStatusTimers(float deltaSeconds)
     }
 }
 
+void Enemy::ThinkNow(UpdateContext &uc)
+{
+    ThinkContext tc(uc, (unsigned int)GetRandomValue(1, 0x7FFFFFFF));
+    this->Think(tc);
+}
+
 bool Enemy::updateStun(UpdateContext &uc)
 {
     return this->stunTimer > 0.0f;
@@ -641,9 +681,9 @@ bool Enemy::updateElectrocute(float deltaSeconds)
     return true;
 }
 
-void Enemy::gatherObjects(std::vector<Object *> &out) const
+void Enemy::visitObjects(Visitor<Object> visit) const
 {
-    out.push_back(const_cast<Object *>(&this->o));
+    visit(const_cast<Object *>(&this->o));
 }
 
 // Base draw implementation - just draws the object
@@ -657,7 +697,7 @@ void Enemy::UpdateDialog(UpdateContext &uc, float verticalOffset)
 {
     if (!this->healthDialog)
     {
-        this->healthDialog = new DialogBox();
+        this->healthDialog = uc.scene ? uc.scene->em.acquireHealthDialog() : new DialogBox();
         this->healthDialog->setBarSize(2.5f, 0.32f);
     }
 
@@ -670,7 +710,7 @@ void Enemy::UpdateDialog(UpdateContext &uc, float verticalOffset)
     this->healthDialog->setFillPercent(this->getHealthPercent());
 }
 
-ShooterEnemy::ShooterEnemy() : Enemy(250)  // Sniper: 250 HP
+ShooterEnemy::ShooterEnemy() : Enemy(ENEMY_SHOOTER, 250)  // Sniper: 250 HP
 {
     this->setMaxHealth(250);
     this->setTileType(TileType::BAMBOO_7); // Sniper uses Bamboo tiles
@@ -679,12 +719,37 @@ ShooterEnemy::ShooterEnemy() : Enemy(250)  // Sniper: 250 HP
     // Set default bullet pattern (single bullet)
     this->bulletPattern.bulletCount = 1;
     this->bulletPattern.arcDegrees = 0.0f;
-    
-    // Load sun texture for bullets
-    this->sunTexture = LoadTexture("sun.png");
-    if (this->sunTexture.id == 0)
+}
+
+ProjectileKindId ShooterEnemy::bulletKind = NO_PROJECTILE_KIND;
+
+void ShooterEnemy::RegisterBulletKind(ProjectileWorld &world, Texture2D *texture)
+{
+    ProjectileKind kind;
+    kind.radius = bulletRadius;
+    kind.lifetime = bulletLifetime;
+    kind.hitsGround = false;
+    kind.collidesWith = COLLISION_MASK_STATIC | COLLISION_LAYER_ENEMY | COLLISION_LAYER_PLAYER;
+    kind.damages = COLLISION_LAYER_PLAYER;
+    kind.knockbackSpeed = 5.0f;
+    kind.knockbackDuration = 0.2f;
+    kind.trail = {1, ORANGE, 0.15f, 0.5f, 0.1f}; // Minecraft-style trail
+    kind.hitBurst = {15, ORANGE, 0.2f, 3.0f, 0.8f};
+    kind.stopBurst = {10, ORANGE, 0.2f, 2.0f, 0.6f};
+    kind.texture = texture;
+    kind.glow = true;
+    kind.onImpact = &ShooterEnemy::OnBulletGone;
+    bulletKind = world.RegisterKind(kind);
+}
+
+void ShooterEnemy::OnBulletGone(void *, const ProjectileImpact &impact, UpdateContext &uc)
+{
+    // The owner may have died while its bullet was in flight
+    Enemy *owner = uc.scene->em.Get(impact.owner);
+    if (owner && owner->getType() == ENEMY_SHOOTER)
     {
-        TraceLog(LOG_WARNING, "ShooterEnemy: Failed to load sun.png");
+        ShooterEnemy *shooter = static_cast<ShooterEnemy *>(owner);
+        shooter->liveBullets = std::max(shooter->liveBullets - 1, 0);
     }
 }
 // ---------------------------- SummonerEnemy ----------------------------
@@ -696,12 +761,15 @@ void SummonerEnemy::SpawnMinionGroup(UpdateContext &uc)
     // Calculate minion size: summoner size / 3
     Vector3 minionSize = Vector3Scale(this->obj().size, 1.0f / 3.0f);
     // Determine room bounds for summoner so spawned minions remain inside
-    Room *room = nullptr;
+    Room *room = this->getRoom();
     BoundingBox roomBounds{};
     bool haveRoomBounds = false;
     if (uc.scene)
     {
-        room = uc.scene->GetRoomContainingPosition(this->position);
+        if (!room)
+        {
+            room = uc.scene->GetRoomContainingPosition(this->position);
+        }
         if (room)
         {
             roomBounds = room->GetBounds();
@@ -721,7 +789,7 @@ void SummonerEnemy::SpawnMinionGroup(UpdateContext &uc)
             spawnPos.x = fmaxf(roomBounds.min.x + margin, fminf(spawnPos.x, roomBounds.max.x - margin));
             spawnPos.z = fmaxf(roomBounds.min.z + margin, fminf(spawnPos.z, roomBounds.max.z - margin));
         }
-            MinionEnemy *m = new MinionEnemy(); // Create a new MinionEnemy instance
+        MinionEnemy *m = uc.scene->em.createEnemy<MinionEnemy>(); // Recycled from the minion pool
         m->obj().size = minionSize;
         m->obj().pos = spawnPos;
         m->setPosition(spawnPos);
@@ -731,9 +799,10 @@ void SummonerEnemy::SpawnMinionGroup(UpdateContext &uc)
         m->obj().sourceRect = this->obj().sourceRect;
         m->obj().useTexture = this->obj().useTexture;
         
-        // Track this minion so it can be cleaned up when summoner dies
-        this->ownedMinions.push_back(m);
-        uc.scene->em.addEnemy(m);
+        // Tag this minion so it can be cleaned up when summoner dies; it joins the scene at the next flush
+        m->setSummoner(this->getHandle());
+        m->setRoom(room); // Minions sleep and count towards completion with the summoner's room
+        uc.scene->events.Spawn(m);
         // Small spawn particles for each minion (helps visibility)
         if (uc.scene)
         {
@@ -745,27 +814,35 @@ void SummonerEnemy::SpawnMinionGroup(UpdateContext &uc)
 
 void SummonerEnemy::CleanupMinions(UpdateContext &uc)
 {
-    // Remove all minions from the enemy manager
-    for (MinionEnemy* minion : this->ownedMinions)
+    // Remove all of this summoner's minions at the next flush
+    for (Enemy *e : uc.scene->em.viewEnemies(ENEMY_MINION))
     {
-        if (minion)
+        if (static_cast<MinionEnemy *>(e)->getSummoner() == this->getHandle())
         {
-            uc.scene->em.RemoveEnemy(minion);
+            uc.scene->events.Despawn(e->getHandle());
         }
     }
-    this->ownedMinions.clear();
 }
 
-SummonerEnemy::~SummonerEnemy()
+Texture2D SummonerEnemy::sharedSpiralParticleTexture = {0};
+
+void SummonerEnemy::LoadSharedResources()
 {
-    // Texture will be cleaned up by UIManager, don't unload it here
-    if (this->spiralParticleTexture.id != 0 && IsWindowReady())
+    if (sharedSpiralParticleTexture.id == 0)
     {
-        UnloadTexture(this->spiralParticleTexture);
-        this->spiralParticleTexture.id = 0;
+        sharedSpiralParticleTexture = LoadTexture("kenney_particle-pack/PNG (Transparent)/magic_02.png");
     }
 }
 
+void SummonerEnemy::UnloadSharedResources()
+{
+    if (sharedSpiralParticleTexture.id != 0 && IsWindowReady())
+    {
+        UnloadTexture(sharedSpiralParticleTexture);
+    }
+    sharedSpiralParticleTexture.id = 0;
+}
+
 void SummonerEnemy::OnDeath(UpdateContext &uc)
 {
     // Cleanup owned minions when summoner dies
@@ -922,15 +999,10 @@ void SummonerEnemy::UpdateSummonAnimation(UpdateContext &uc, float delta)
 
 void SummonerEnemy::EmitSummonParticles(const Vector3 &summonPos, float intensity)
 {
-    // Load purple particle texture on first use
-    if (this->spiralParticleTexture.id == 0)
+    // Purple particle texture is loaded once by LoadSharedResources()
+    if (sharedSpiralParticleTexture.id == 0)
     {
-        this->spiralParticleTexture = LoadTexture("kenney_particle-pack/PNG (Transparent)/magic_02.png");
-        if (this->spiralParticleTexture.id == 0)
-        {
-            TraceLog(LOG_WARNING, "Failed to load spiral particle texture");
-            return;
-        }
+        return;
     }
 }
 
@@ -943,7 +1015,7 @@ void SummonerEnemy::Draw() const
 
 void SummonerEnemy::UpdateBody(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     this->tickStatusTimers(delta);
     bool isStunned = this->updateStun(uc);
 
@@ -1001,11 +1073,53 @@ void SummonerEnemy::UpdateBody(UpdateContext &uc)
     this->UpdateDialog(uc);
 }
 
+void ShooterEnemy::Think(ThinkContext &tc)
+{
+    UpdateContext &uc = tc.uc;
+    Intent next;
+    next.valid = true;
+
+    // A stunned or knocked back shooter neither aims nor repositions, so skip the sweeps
+    if (this->isIncapacitatedNextUpdate(uc.deltaTime))
+    {
+        next.incapacitated = true;
+        this->intent = next;
+        return;
+    }
+
+    next.hasLineOfSight = this->findShotDirection(uc, next.aimDir);
+
+    Vector3 toPlayer = Vector3Subtract(uc.player->pos(), this->position);
+    toPlayer.y = 0.0f;
+    float distance = Vector3Length(toPlayer);
+
+    // Run the six-probe goal search here rather than in FindMovement whenever
+    // FindMovement is going to ask for it this tick.
+    if (this->NeedsRepositionSearch(distance, next.hasLineOfSight, uc.deltaTime))
+    {
+        Vector3 planar = Vector3LengthSqr(toPlayer) > 0.0001f ? Vector3Normalize(toPlayer) : Vector3Zero();
+        next.repositionSearched = true;
+        next.repositionFound = this->FindRepositionGoal(uc, planar, distance, next.repositionGoal);
+    }
+    this->intent = next;
+}
+
 void ShooterEnemy::UpdateBody(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    if (!this->intent.valid)
+    {
+        this->ThinkNow(uc);
+    }
+
+    float delta = uc.deltaTime;
     this->tickStatusTimers(delta);
     bool isStunned = this->updateStun(uc);
+    bool canAct = !isStunned && !this->isMovementDisabled() && !this->isKnockbackActive();
+    if (canAct && this->intent.incapacitated)
+    {
+        this->ThinkNow(uc); // Recovered sooner than Think() expected
+    }
+    this->intent.valid = false; // Consumed by this update; the next tick thinks again
 
     Vector3 toPlayer = Vector3Subtract(uc.player->pos(), this->position);
     toPlayer.y = 0.0f;
@@ -1015,9 +1129,10 @@ void ShooterEnemy::UpdateBody(UpdateContext &uc)
     bool hasLineOfSight = false;
     MovementCommand command{};
 
-    if (!isStunned && !this->isMovementDisabled())
+    if (canAct)
     {
-        hasLineOfSight = this->findShotDirection(uc, aimDir);
+        hasLineOfSight = this->intent.hasLineOfSight;
+        aimDir = this->intent.aimDir;
         bool withinRange = this->isWithinPreferredRange(distance);
 
         if (this->phase == Phase::FindPosition)
@@ -1061,7 +1176,7 @@ void ShooterEnemy::UpdateBody(UpdateContext &uc)
 
         if (this->phase == Phase::Shooting)
         {
-            this->HandleShooting(delta, muzzle, aimDir, hasLineOfSight);
+            this->HandleShooting(uc, delta, muzzle, aimDir, hasLineOfSight);
         }
         else
         {
@@ -1069,7 +1184,6 @@ void ShooterEnemy::UpdateBody(UpdateContext &uc)
         }
     }
 
-    this->updateBullets(uc, delta);
     this->updateElectrocute(delta);
     // Update health dialog
     this->UpdateDialog(uc);
@@ -1146,12 +1260,20 @@ ShooterEnemy::MovementCommand ShooterEnemy::FindMovement(UpdateContext &uc, cons
     return command;
 }
 
+bool ShooterEnemy::NeedsRepositionSearch(float distance, bool hasLineOfSight, float deltaSeconds) const
+{
+    // Mirrors the branch in FindMovement that calls SelectRepositionGoal
+    if (hasLineOfSight || distance > this->maxFiringDistance || distance < this->retreatDistance)
+        return false;
+    return !this->hasRepositionGoal || this->repositionCooldown <= 0.0f || this->losRepositionTimer + deltaSeconds >= this->strafeSwitchInterval;
+}
+
 bool ShooterEnemy::isWithinPreferredRange(float distance) const
 {
     return distance <= this->maxFiringDistance && distance >= this->retreatDistance;
 }
 
-void ShooterEnemy::HandleShooting(float deltaSeconds, const Vector3 &muzzlePosition, const Vector3 &aimDirection, bool hasLineOfSight)
+void ShooterEnemy::HandleShooting(UpdateContext &uc, float deltaSeconds, const Vector3 &muzzlePosition, const Vector3 &aimDirection, bool hasLineOfSight)
 {
     this->fireCooldown = fmaxf(this->fireCooldown - deltaSeconds, 0.0f);
 
@@ -1165,7 +1287,7 @@ void ShooterEnemy::HandleShooting(float deltaSeconds, const Vector3 &muzzlePosit
         return;
     }
 
-    if ((int)this->bullets.size() >= this->maxActiveBullets)
+    if (this->liveBullets >= this->maxActiveBullets)
     {
         return;
     }
@@ -1174,7 +1296,7 @@ void ShooterEnemy::HandleShooting(float deltaSeconds, const Vector3 &muzzlePosit
     if (this->bulletPattern.bulletCount <= 1 || this->bulletPattern.arcDegrees <= 0.0f)
     {
         // Single bullet - shoot straight
-        this->spawnBullet(muzzlePosition, aimDirection);
+        this->spawnBullet(uc, muzzlePosition, aimDirection);
     }
     else
     {
@@ -1208,7 +1330,7 @@ void ShooterEnemy::HandleShooting(float deltaSeconds, const Vector3 &muzzlePosit
             
             // Rotate aim direction around the up axis by the angle
             Vector3 bulletDir = Vector3RotateByAxisAngle(aimNormalized, up, angle);
-            this->spawnBullet(muzzlePosition, bulletDir);
+            this->spawnBullet(uc, muzzlePosition, bulletDir);
         }
     }
     
@@ -1235,6 +1357,29 @@ bool ShooterEnemy::HasLineOfSightFromPosition(const Vector3 &origin, UpdateConte
 }
 
 bool ShooterEnemy::SelectRepositionGoal(UpdateContext &uc, const Vector3 &planarToPlayer, float distanceToPlayer)
+{
+    Vector3 goal = {0.0f, 0.0f, 0.0f};
+    bool found;
+    if (this->intent.repositionSearched)
+    {
+        goal = this->intent.repositionGoal;
+        found = this->intent.repositionFound;
+        this->intent.repositionSearched = false;
+    }
+    else
+    {
+        found = this->FindRepositionGoal(uc, planarToPlayer, distanceToPlayer, goal);
+    }
+
+    this->hasRepositionGoal = found;
+    if (found)
+    {
+        this->losRepositionGoal = goal;
+    }
+    return found;
+}
+
+bool ShooterEnemy::FindRepositionGoal(UpdateContext &uc, const Vector3 &planarToPlayer, float distanceToPlayer, Vector3 &outGoal) const
 {
     Vector3 dir = planarToPlayer;
     dir.y = 0.0f;
@@ -1250,7 +1395,11 @@ bool ShooterEnemy::SelectRepositionGoal(UpdateContext &uc, const Vector3 &planar
     static const float offsetAnglesDeg[] = {90.0f, -90.0f, 60.0f, -60.0f, 120.0f, -120.0f};
     float desiredDistance = Clamp(distanceToPlayer, this->retreatDistance + 2.0f, this->maxFiringDistance - 4.0f);
     Vector3 playerPos = uc.player->pos();
+    Vector3 eyePos = uc.player->getCamera().position;
     float baseY = this->position.y;
+    // Candidates in this room that the coarse field already rules out skip the sweep
+    const Room *room = this->getRoom();
+    const VisibilityField *field = (room && room->Contains(playerPos)) ? &room->GetVisibility() : nullptr;
 
     auto rotateY = [](Vector3 v, float degrees) {
         float radians = degrees * DEG2RAD;
@@ -1273,15 +1422,17 @@ bool ShooterEnemy::SelectRepositionGoal(UpdateContext &uc, const Vector3 &planar
         Vector3 desiredPos = Vector3Subtract(playerPos, Vector3Scale(candidateDir, desiredDistance));
         desiredPos.y = baseY;
 
+        if (field && !field->MayBeVisible(desiredPos, eyePos))
+        {
+            continue;
+        }
         if (this->HasLineOfSightFromPosition(desiredPos, uc))
         {
-            this->losRepositionGoal = desiredPos;
-            this->hasRepositionGoal = true;
+            outGoal = desiredPos;
             return true;
         }
     }
 
-    this->hasRepositionGoal = false;
     return false;
 }
 
@@ -1312,214 +1463,82 @@ bool ShooterEnemy::hasLineOfFire(const Vector3 &start, const Vector3 &end, Updat
 {
     float losRadius = fmaxf(probeRadius, 0.05f);
     float ignoreDistance = fmaxf(losRadius * 1.5f, 0.2f);
-    auto staticObjects = uc.scene->getStaticObjects();
-    for (auto *obj : staticObjects)
-    {
-        if (!obj)
-            continue;
-        float hitDistance = 0.0f;
-        if (CheckLineSegmentVsOBB(start, end, losRadius, &obj->obb, &hitDistance))
-        {
-            if (hitDistance <= ignoreDistance)
-            {
-                continue;
-            }
-            return false;
-        }
-    }
-
-    if (uc.scene->CheckDecorationSweep(start, end, losRadius))
-    {
-        return false;
-    }
-
-    return true;
+    return !uc.scene->CheckStaticSweepCached(start, end, losRadius, ignoreDistance);
 }
 
-void ShooterEnemy::spawnBullet(const Vector3 &origin, const Vector3 &dir)
+void ShooterEnemy::spawnBullet(UpdateContext &uc, const Vector3 &origin, const Vector3 &dir)
 {
-    Bullet bullet;
+    ProjectileSpawn bullet;
     bullet.position = origin;
     bullet.velocity = Vector3Scale(Vector3Normalize(dir), this->bulletSpeed);
-    bullet.radius = this->bulletRadius;
-    bullet.remainingLife = this->bulletLifetime;
-    bullet.visual = Object();
-    bullet.visual.setAsSphere(bullet.radius);
-    bullet.visual.pos = origin;
-    bullet.visual.tint = {255, 255, 255, 255};
-    bullet.visual.visible = true;
-    
-    // Apply sun texture if available
-    if (this->sunTexture.id != 0)
-    {
-        bullet.visual.useTexture = true;
-        bullet.visual.texture = &this->sunTexture;
-        bullet.visual.sourceRect = {0.0f, 0.0f, (float)this->sunTexture.width, (float)this->sunTexture.height};
-    }
-    
-    bullet.visual.UpdateOBB();
-
-    this->bullets.push_back(bullet);
+    bullet.damage = this->bulletDamage;
+    bullet.owner = this->getHandle();
+    uc.scene->projectiles.Spawn(bulletKind, bullet);
+    ++this->liveBullets;
 }
 
-void ShooterEnemy::updateBullets(UpdateContext &uc, float deltaSeconds)
-{
-    for (auto &bullet : this->bullets)
-    {
-        bullet.remainingLife -= deltaSeconds;
-        bullet.position = Vector3Add(bullet.position, Vector3Scale(bullet.velocity, deltaSeconds));
-        bullet.visual.pos = bullet.position;
-        bullet.visual.UpdateOBB();
-        
-        // Spawn trailing particles for Minecraft look
-        if (uc.scene)
-        {
-            uc.scene->particles.spawnExplosion(bullet.position, 1, ORANGE, 0.15f, 0.5f, 0.1f);
-        }
-    }
-
-    auto removeIt = std::remove_if(this->bullets.begin(), this->bullets.end(), [&](Bullet &bullet) {
-        if (bullet.remainingLife <= 0.0f)
-            return true;
-
-        if (CheckCollisionSphereVsOBB(bullet.position, bullet.radius, &uc.player->obj().obb))
-        {
-            CollisionResult directHit = Object::collided(bullet.visual, uc.player->obj());
-            DamageResult damage(this->bulletDamage, directHit);
-            uc.player->damage(damage);
-            Vector3 knockDir = Vector3Normalize(bullet.velocity);
-            if (Vector3LengthSqr(knockDir) < 0.0001f)
-                knockDir = {0.0f, 0.0f, 1.0f};
-            uc.player->applyKnockback(Vector3Scale(knockDir, 5.0f), 0.2f, 0.0f);
-            
-            // Spawn impact particles
-            if (uc.scene)
-            {
-                uc.scene->particles.spawnExplosion(bullet.position, 15, ORANGE, 0.2f, 3.0f, 0.8f);
-            }
-            return true;
-        }
-
-        auto collisions = Object::collided(bullet.visual, uc.scene);
-        for (auto &hit : collisions)
-        {
-            if (hit.with == this)
-                continue;
-
-            if (hit.with && hit.with->category() == ENTITY_PLAYER)
-            {
-                DamageResult damage(this->bulletDamage, hit);
-                uc.player->damage(damage);
-                Vector3 knockDir = Vector3Normalize(bullet.velocity);
-                if (Vector3LengthSqr(knockDir) < 0.0001f)
-                    knockDir = {0.0f, 0.0f, 1.0f};
-                uc.player->applyKnockback(Vector3Scale(knockDir, 5.0f), 0.2f, 0.0f);
-                
-                // Spawn impact particles
-                if (uc.scene)
-                {
-                    uc.scene->particles.spawnExplosion(bullet.position, 15, ORANGE, 0.2f, 3.0f, 0.8f);
-                }
-                return true;
-            }
-
-            // Ignore collisions with player projectiles
-            if (hit.with && hit.with->category() == ENTITY_PROJECTILE)
-            {
-                continue;
-            }
-
-            // Spawn impact particles on wall/environment hit
-            if (uc.scene)
-            {
-                uc.scene->particles.spawnExplosion(bullet.position, 10, ORANGE, 0.2f, 2.0f, 0.6f);
-            }
-            return true; // hit environment or other entity
-        }
-
-        return false;
-    });
+// ---------------------------- SupportEnemy ----------------------------
 
-    this->bullets.erase(removeIt, this->bullets.end());
-}
+// ======================== SupportEnemy ========================
 
-ShooterEnemy::~ShooterEnemy()
+namespace
 {
-    if (this->sunTexture.id != 0)
+    // Minions are too small to hide behind and not worth healing; every other type is a candidate ally.
+    template <typename Fn>
+    void ForEachNonMinion(const EnemyManager &em, Fn &&fn)
     {
-        if (IsWindowReady())
+        for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
         {
-            UnloadTexture(this->sunTexture);
+            if (type == ENEMY_MINION) continue;
+            for (Enemy *ally : em.viewEnemies((EnemyType)type))
+            {
+                fn(ally);
+            }
         }
-        this->sunTexture.id = 0;
     }
 }
 
-void ShooterEnemy::gatherObjects(std::vector<Object *> &out) const
+Enemy* SupportEnemy::FindAllyToHideBehind(ThinkContext &tc) const
 {
-    Enemy::gatherObjects(out);
-    for (const auto &bullet : this->bullets)
-    {
-        out.push_back(const_cast<Object *>(&bullet.visual));
-    }
-}
-
-// ---------------------------- SupportEnemy ----------------------------
-
-// ======================== SupportEnemy ========================
+    const EnemyManager &em = tc.uc.scene->em;
 
-Enemy* SupportEnemy::FindAllyToHideBehind(UpdateContext &uc)
-{
-    // Find allies within normal search radius
-    std::vector<Entity *> enemies = uc.scene->em.getEntities(ENTITY_ENEMY);
-    std::vector<Enemy*> candidateAllies;
-    
-    for (Entity *entity : enemies)
+    // Priority 1: Find a tank (ChargingEnemy) within normal search radius
+    for (Enemy *ally : em.viewEnemies(ENEMY_CHARGING))
     {
-        if (!entity || entity == this) continue;
-        
-        Enemy *ally = dynamic_cast<Enemy*>(entity);
-        if (!ally) continue;
-        
-        // Skip minions
-        if (dynamic_cast<MinionEnemy*>(ally)) continue;
-        
-        float dist = Vector3Distance(this->position, ally->pos());
-        if (dist <= normalSearchRadius)
-        {
-            candidateAllies.push_back(ally);
-        }
-    }
-    
-    // Priority 1: Find a tank (ChargingEnemy)
-    for (Enemy* ally : candidateAllies)
-    {
-        if (dynamic_cast<ChargingEnemy*>(ally))
+        if (Vector3Distance(this->position, ally->pos()) <= normalSearchRadius)
         {
             return ally;
         }
     }
     
-    // Priority 2: Pick a random ally from candidates
-    if (!candidateAllies.empty())
+    // Priority 2: Pick a random ally within normal search radius
+    auto isCandidate = [&](Enemy *ally)
+    {
+        return ally != this && Vector3Distance(this->position, ally->pos()) <= normalSearchRadius;
+    };
+    int candidateCount = 0;
+    ForEachNonMinion(em, [&](Enemy *ally)
+    {
+        if (isCandidate(ally)) candidateCount++;
+    });
+    if (candidateCount > 0)
     {
-        int randomIdx = GetRandomValue(0, (int)candidateAllies.size() - 1);
-        return candidateAllies[randomIdx];
+        int randomIdx = tc.Random(0, candidateCount - 1);
+        Enemy* picked = nullptr;
+        ForEachNonMinion(em, [&](Enemy *ally)
+        {
+            if (!picked && isCandidate(ally) && randomIdx-- == 0) picked = ally;
+        });
+        return picked;
     }
     
     // Priority 3: Find closest enemy (even if far)
     Enemy* closestAlly = nullptr;
     float closestDist = 999999.0f;
     
-    for (Entity *entity : enemies)
+    ForEachNonMinion(em, [&](Enemy *ally)
     {
-        if (!entity || entity == this) continue;
-        
-        Enemy *ally = dynamic_cast<Enemy*>(entity);
-        if (!ally) continue;
-        
-        // Skip minions
-        if (dynamic_cast<MinionEnemy*>(ally)) continue;
+        if (ally == this) return;
         
         float dist = Vector3Distance(this->position, ally->pos());
         if (dist < closestDist)
@@ -1527,14 +1546,14 @@ Enemy* SupportEnemy::FindAllyToHideBehind(UpdateContext &uc)
             closestDist = dist;
             closestAlly = ally;
         }
-    }
+    });
     
     return closestAlly;
 }
 
-Enemy* SupportEnemy::FindBestTarget(UpdateContext &uc, bool forHealing)
+Enemy* SupportEnemy::FindBestTarget(UpdateContext &uc, bool forHealing) const
 {
-    std::vector<Entity *> enemies = uc.scene->em.getEntities(ENTITY_ENEMY);
+    const EnemyManager &em = uc.scene->em;
     Enemy* bestTarget = nullptr;
     
     if (forHealing)
@@ -1542,42 +1561,32 @@ Enemy* SupportEnemy::FindBestTarget(UpdateContext &uc, bool forHealing)
         // Find lowest HP ally below healing threshold within search radius
         float lowestHealthPercent = 1.0f;
         
-        for (Entity *entity : enemies)
+        ForEachNonMinion(em, [&](Enemy *ally)
         {
-            if (!entity || entity == this) continue;
-            
-            Enemy *ally = dynamic_cast<Enemy*>(entity);
-            if (!ally) continue;
-            
-            // Skip minions
-            if (dynamic_cast<MinionEnemy*>(ally)) continue;
+            if (ally == this) return;
             
             float dist = Vector3Distance(this->position, ally->pos());
-            if (dist > actionSearchRadius) continue;
+            if (dist > actionSearchRadius) return;
             
             float healthPercent = (float)ally->getHealth() / (float)ally->getMaxHealth();
-            if (healthPercent >= healingThreshold) continue;
+            if (healthPercent >= healingThreshold) return;
             
             if (healthPercent < lowestHealthPercent)
             {
                 lowestHealthPercent = healthPercent;
                 bestTarget = ally;
             }
-        }
+        });
     }
     else
     {
         // Find any ally to buff (prioritize lowest health)
         float lowestHealthPercent = 1.0f;
         
-        for (Entity *entity : enemies)
+        for (Enemy *ally : em.viewEnemies())
         {
-            if (!entity || entity == this) continue;
+            if (ally == this) continue;
             
-            Enemy *ally = dynamic_cast<Enemy*>(entity);
-            if (!ally) continue;
-            
-            // Skip minions
             float dist = Vector3Distance(this->position, ally->pos());
             if (dist > actionSearchRadius) continue;
             
@@ -1620,7 +1629,7 @@ Vector3 SupportEnemy::CalculateHidePosition(UpdateContext &uc, Enemy* allyToHide
 
 void SupportEnemy::UpdateNormalMode(UpdateContext &uc, const Vector3 &toPlayer)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     float playerDist = Vector3Length(toPlayer);
     
     Vector3 desiredDir = Vector3Zero();
@@ -1631,9 +1640,9 @@ void SupportEnemy::UpdateNormalMode(UpdateContext &uc, const Vector3 &toPlayer)
     settings.decelGround = FRICTION;
     settings.decelAir = AIR_DRAG;
     
-    // Check for targets to heal or buff
-    Enemy* healTarget = FindBestTarget(uc, true);
-    Enemy* buffTarget = FindBestTarget(uc, false);
+    // Targets to heal or buff were picked by Think()
+    Enemy* healTarget = this->intent.healTarget;
+    Enemy* buffTarget = this->intent.buffTarget;
     
     // Decide: heal takes priority over buff
     if (healTarget)
@@ -1652,7 +1661,7 @@ void SupportEnemy::UpdateNormalMode(UpdateContext &uc, const Vector3 &toPlayer)
     }
     
     // Normal mode: hide behind allies or retreat
-    this->targetAlly = FindAllyToHideBehind(uc);
+    this->targetAlly = this->intent.hideAlly;
     
     if (this->targetAlly)
     {
@@ -1695,7 +1704,7 @@ void SupportEnemy::UpdateNormalMode(UpdateContext &uc, const Vector3 &toPlayer)
 
 void SupportEnemy::UpdateHealMode(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     
     Vector3 toPlayer = Vector3Subtract(uc.player->pos(), this->position);
     toPlayer.y = 0.0f;
@@ -1792,7 +1801,7 @@ void SupportEnemy::UpdateHealMode(UpdateContext &uc)
 
 void SupportEnemy::UpdateBuffMode(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     
     Vector3 toPlayer = Vector3Subtract(uc.player->pos(), this->position);
     toPlayer.y = 0.0f;
@@ -1881,9 +1890,32 @@ void SupportEnemy::UpdateBuffMode(UpdateContext &uc)
     this->UpdateDialog(uc);
 }
 
+void SupportEnemy::Think(ThinkContext &tc)
+{
+    // Only Normal mode searches; Heal and Buff keep their target
+    Intent next;
+    next.valid = true;
+    if (this->mode == SupportMode::Normal)
+    {
+        next.healTarget = this->FindBestTarget(tc.uc, true);
+        next.buffTarget = next.healTarget ? nullptr : this->FindBestTarget(tc.uc, false);
+        if (!next.healTarget && !next.buffTarget)
+        {
+            next.hideAlly = this->FindAllyToHideBehind(tc);
+        }
+    }
+    this->intent = next;
+}
+
 void SupportEnemy::UpdateBody(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    if (!this->intent.valid)
+    {
+        this->ThinkNow(uc);
+    }
+    this->intent.valid = false; // Consumed by this update; the next tick thinks again
+
+    float delta = uc.deltaTime;
     this->tickStatusTimers(delta);
     bool isStunned = this->updateStun(uc);
 
@@ -2076,7 +2108,7 @@ bool VanguardEnemy::CheckSlashHit(UpdateContext &uc)
 
 void VanguardEnemy::HandleGroundCombo(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     this->stateTimer -= delta;
     
     if (this->comboStage == 1)
@@ -2151,8 +2183,9 @@ void VanguardEnemy::HandleGroundCombo(UpdateContext &uc)
                 this->spearRetractAmount = 0.0f;
                 this->spearThrustAmount = 1.0f - retractProgress;
             }
-            this->velocity.x *= 0.85f;
-            this->velocity.z *= 0.85f;
+            float recoveryDrag = powf(0.85f, delta * PHYSICS_REFERENCE_HZ);
+            this->velocity.x *= recoveryDrag;
+            this->velocity.z *= recoveryDrag;
         }
         
         // Apply ground physics
@@ -2339,7 +2372,7 @@ void VanguardEnemy::HandleGroundCombo(UpdateContext &uc)
         this->updateElectrocute(delta);
         this->UpdateDialog(uc);}
 
-void VanguardEnemy::DecideAction(UpdateContext &uc, float distanceToPlayer)
+VanguardEnemy::VanguardAction VanguardEnemy::ChooseAction(float distanceToPlayer, float roll, float diveCooldown) const
 {
     // Weighted RNG system based on distance zones (from design doc)
     
@@ -2347,66 +2380,74 @@ void VanguardEnemy::DecideAction(UpdateContext &uc, float distanceToPlayer)
     if (distanceToPlayer < 10.0f)
     {
         // 90% Ground Combo, 10% Panic Dive
-        float roll = (float)GetRandomValue(0, 100) / 100.0f;
-        if (roll < 0.9f)
-        {
-            // Start ground combo with Piston Thrust
-            this->state = VanguardState::GroundComboStab;
-            this->comboStage = 1;
-            this->stateTimer = this->stabWindupTime + this->stabActiveTime + this->stabRecoveryTime;
-            this->comboHitPlayer = false;
-            
-            // Store stab direction
-            Vector3 toPlayer = Vector3Subtract(uc.player->pos(), this->position);
-            toPlayer.y = 0.0f;
-            if (Vector3LengthSqr(toPlayer) > 0.001f)
-                this->stabDirection = Vector3Normalize(toPlayer);
-            else
-                this->stabDirection = this->getFacingDirection();
-        }
-        else
-        {
-            // Panic dive to escape
-            this->state = VanguardState::AerialAscend;
-            this->stateTimer = this->diveAscendTime;
-            this->velocity.y = this->diveAscendInitialVelocity;
-            this->diveCooldownTimer = this->diveCooldownDuration;
-        }
+        return roll < 0.9f ? VanguardAction::GroundCombo : VanguardAction::Dive;
     }
     // Zone B: The "Skirmish" (Distance 10.0 - 30.0 units)
     else if (distanceToPlayer >= 10.0f && distanceToPlayer <= 30.0f)
     {
-        // 30% Aerial Dive, 40% Run Forward
-        float roll = (float)GetRandomValue(0, 100) / 100.0f;
-        if (roll < 0.3f && this->diveCooldownTimer <= 0.0f)
-        {
-            // Dive to close gap instantly
-            this->state = VanguardState::AerialAscend;
-            this->stateTimer = this->diveAscendTime;
-            this->velocity.y = this->diveAscendInitialVelocity;
-            this->diveCooldownTimer = this->diveCooldownDuration;
-        }
-        // else: Stay in Chasing state (run forward)
+        // 30% Aerial Dive to close gap instantly, otherwise run forward
+        if (roll < 0.3f && diveCooldown <= 0.0f)
+            return VanguardAction::Dive;
     }
     // Zone C: The "Sniper" (Distance > 10.0 units)
     else
     {
         // 50% chance to dive if ready (punish running)
-        float roll = (float)GetRandomValue(0, 100) / 100.0f;
-        if (roll < 0.5f && this->diveCooldownTimer <= 0.0f)
-        {
-            this->state = VanguardState::AerialAscend;
-            this->stateTimer = this->diveAscendTime;
-            this->velocity.y = this->diveAscendInitialVelocity;
-            this->diveCooldownTimer = this->diveCooldownDuration;
-        }
-        // else: Stay in Chasing state (run forward)
+        if (roll < 0.5f && diveCooldown <= 0.0f)
+            return VanguardAction::Dive;
+    }
+    return VanguardAction::Chase;
+}
+
+void VanguardEnemy::DecideAction(UpdateContext &uc, VanguardAction action)
+{
+    if (action == VanguardAction::GroundCombo)
+    {
+        // Start ground combo with Piston Thrust
+        this->state = VanguardState::GroundComboStab;
+        this->comboStage = 1;
+        this->stateTimer = this->stabWindupTime + this->stabActiveTime + this->stabRecoveryTime;
+        this->comboHitPlayer = false;
+        
+        // Store stab direction
+        Vector3 toPlayer = Vector3Subtract(uc.player->pos(), this->position);
+        toPlayer.y = 0.0f;
+        if (Vector3LengthSqr(toPlayer) > 0.001f)
+            this->stabDirection = Vector3Normalize(toPlayer);
+        else
+            this->stabDirection = this->getFacingDirection();
+    }
+    else if (action == VanguardAction::Dive)
+    {
+        this->state = VanguardState::AerialAscend;
+        this->stateTimer = this->diveAscendTime;
+        this->velocity.y = this->diveAscendInitialVelocity;
+        this->diveCooldownTimer = this->diveCooldownDuration;
     }
+    // Chase: stay in Chasing state (run forward)
+}
+
+void VanguardEnemy::Think(ThinkContext &tc)
+{
+    Intent next;
+    next.valid = true;
+
+    // Roll only on ticks where UpdateBody will ask for a decision, using the
+    // timers as they will be after UpdateBody counts them down.
+    float delta = tc.uc.deltaTime;
+    if (this->state == VanguardState::Chasing && fmaxf(0.0f, this->decisionCooldownTimer - delta) <= 0.0f)
+    {
+        Vector3 toPlayer = Vector3Subtract(tc.uc.player->pos(), this->position);
+        toPlayer.y = 0.0f;
+        float roll = (float)tc.Random(0, 100) / 100.0f;
+        next.action = this->ChooseAction(Vector3Length(toPlayer), roll, fmaxf(0.0f, this->diveCooldownTimer - delta));
+    }
+    this->intent = next;
 }
 
 void VanguardEnemy::HandleAerialDive(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     
     // Update shockwave if active
     if (this->shockwaveActive)
@@ -2526,47 +2567,65 @@ void VanguardEnemy::HandleAerialDive(UpdateContext &uc)
         this->velocity = Vector3Scale(dir, this->diveCurrentSpeed);
         
         // Update position with room bounds checking
-        Vector3 newPosition = Vector3Add(this->position, Vector3Scale(this->velocity, delta));
+        Vector3 displacement = Vector3Scale(this->velocity, delta);
+        Vector3 newPosition = Vector3Add(this->position, displacement);
         
         // Check room bounds to prevent diving out
         if (uc.scene)
         {
+            bool hitWall = false;
+            float floorY = 0.0f;
+
+            // At dive speed a single step can cross a wall, so sweep instead of testing the end point
+            if (OBB_MotionNeedsSweep(&this->o.obb, displacement))
+            {
+                SweepHit sweep = uc.scene->SweepOBB(this->o.obb, displacement, this, false);
+                if (sweep.hit)
+                {
+                    newPosition = Vector3Add(this->position, Vector3Scale(displacement, sweep.fraction));
+                    hitWall = true;
+                }
+            }
+
             Room *r = uc.scene->GetRoomContainingPosition(this->position);
             if (r)
             {
                 BoundingBox bounds = r->GetBounds();
+                floorY = bounds.min.y;
                 // Clamp position to room bounds with small margin
                 float margin = 2.0f;
                 if (newPosition.x < bounds.min.x + margin || newPosition.x > bounds.max.x - margin ||
                     newPosition.z < bounds.min.z + margin || newPosition.z > bounds.max.z - margin)
                 {
-                    // Hit wall - stop dive and land
                     newPosition.x = Clamp(newPosition.x, bounds.min.x + margin, bounds.max.x - margin);
                     newPosition.z = Clamp(newPosition.z, bounds.min.z + margin, bounds.max.z - margin);
-                    newPosition.y = bounds.min.y; // Force to ground
-                    this->position = newPosition;
-                    this->velocity = {0.0f, 0.0f, 0.0f};
-                    this->state = VanguardState::AerialLanding;
-                    this->stateTimer = this->diveLandingRecoveryTime;
-                    this->diveCurrentSpeed = 0.0f;
-                    this->visualScale = {1.6f, 0.6f, 1.6f};
-                    this->o.pos = this->position;
-                    this->o.UpdateOBB();
-                    
-                    // Start shockwave on wall impact landing
-                    this->shockwaveActive = true;
-                    this->shockwaveRadius = 0.0f;
-                    this->shockwaveCenter = this->position;
-                    this->shockwaveHitPlayer = false;
-                    
-                    // Wall impact particles
-                    if (uc.scene)
-                    {
-                        uc.scene->particles.spawnExplosion(this->position, 24, ORANGE, 0.3f, 6.0f, 1.0f);
-                    }
-                    return; // Exit early
+                    hitWall = true;
                 }
             }
+
+            if (hitWall)
+            {
+                // Hit wall - stop dive and land
+                newPosition.y = floorY; // Force to ground
+                this->position = newPosition;
+                this->velocity = {0.0f, 0.0f, 0.0f};
+                this->state = VanguardState::AerialLanding;
+                this->stateTimer = this->diveLandingRecoveryTime;
+                this->diveCurrentSpeed = 0.0f;
+                this->visualScale = {1.6f, 0.6f, 1.6f};
+                this->o.pos = this->position;
+                this->o.UpdateOBB();
+                
+                // Start shockwave on wall impact landing
+                this->shockwaveActive = true;
+                this->shockwaveRadius = 0.0f;
+                this->shockwaveCenter = this->position;
+                this->shockwaveHitPlayer = false;
+                
+                // Wall impact particles
+                uc.scene->particles.spawnExplosion(this->position, 24, ORANGE, 0.3f, 6.0f, 1.0f);
+                return; // Exit early
+            }
         }
         
         this->position = newPosition;
@@ -2718,7 +2777,13 @@ void VanguardEnemy::UnloadSharedResources()
 
 void VanguardEnemy::UpdateBody(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    if (!this->intent.valid)
+    {
+        this->ThinkNow(uc);
+    }
+    this->intent.valid = false; // Consumed by this update; the next tick thinks again
+
+    float delta = uc.deltaTime;
     this->tickStatusTimers(delta);
     bool isStunned = this->updateStun(uc);
 
@@ -2763,7 +2828,7 @@ void VanguardEnemy::UpdateBody(UpdateContext &uc)
         // Use decision logic periodically (not every frame)
         if (this->decisionCooldownTimer <= 0.0f)
         {
-            DecideAction(uc, dist);
+            DecideAction(uc, this->intent.action);
             this->decisionCooldownTimer = this->decisionCooldownDuration;
         }
         
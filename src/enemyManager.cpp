@@ -1,59 +1,288 @@
 #include "enemyManager.hpp"
 #include "me.hpp"
 #include "scene.hpp"
+#include "room.hpp"
+#include "jobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Enemies of a sleeping room keep their state but are neither updated nor binned
+    bool IsDormant(const Enemy *e)
+    {
+        return e->getRoom() && !e->getRoom()->IsAwake();
+    }
+
+    BoundingBox BoundsAround(const Vector3 &min, const Vector3 &max, float reach)
+    {
+        Vector3 r = {reach, reach, reach};
+        return {Vector3Subtract(min, r), Vector3Add(max, r)};
+    }
+}
+
 void EnemyManager::RemoveEnemy(Enemy *e)
 {
-    int found = -1;
-    for (int i = 0; i < this->enemies.size(); i++)
+    if (e && this->enemies.Get(e->getHandle()) == e)
+    {
+        this->RemoveEnemy(e->getHandle());
+    }
+}
+
+void EnemyManager::RemoveEnemy(EntityHandle handle)
+{
+    // Inside an EnemyRange only hide the enemy; it is deleted when iteration ends.
+    if (this->iterationDepth > 0)
     {
-        if (this->enemies[i] == e)
+        Enemy *e = this->enemies.Get(handle);
+        if (e && this->enemies.MarkForRemoval(handle))
         {
-            found = i;
-            break;
+            this->enemiesByType[e->getType()].MarkForRemoval(e->getTypeHandle());
+            this->grid.Remove(e);
+            if (e->getRoom())
+            {
+                e->getRoom()->OnEnemyRemoved();
+            }
         }
+        return;
+    }
+
+    Enemy *e = this->enemies.Remove(handle);
+    if (e)
+    {
+        if (e->getRoom())
+        {
+            e->getRoom()->OnEnemyRemoved();
+        }
+        this->enemiesByType[e->getType()].Remove(e->getTypeHandle());
+        this->grid.Remove(e);
+        this->DestroyEnemy(e);
+    }
+}
+
+void EnemyManager::TrackRoom(Enemy *e, UpdateContext &uc)
+{
+    // Still inside its room is the common case and needs no lookup
+    Room *room = e->getRoom();
+    if ((room && room->Contains(e->pos())) || !uc.scene)
+        return;
+
+    // Outside every room (e.g. knocked up over a wall) keeps the old binding
+    Room *entered = uc.scene->GetRoomContainingPosition(e->pos());
+    if (!entered || entered == room)
+        return;
+
+    if (room)
+    {
+        room->OnEnemyRemoved();
+    }
+    entered->OnEnemyAdded();
+    e->setRoom(entered);
+}
+
+void EnemyManager::FinishUpdate(Enemy *e, UpdateContext &uc)
+{
+    this->TrackRoom(e, uc);
+    if (e->getRoom() && e->hasLiveProjectiles())
+    {
+        e->getRoom()->KeepAwake();
+    }
+}
+
+bool EnemyManager::StageBody(Enemy *e, const KinematicsStore::Body &body)
+{
+    if (!this->stagingBodies)
+        return false;
+
+    EntityHandle handle = e->getKinematicsBody();
+    if (this->bodies.Contains(handle))
+    {
+        this->bodies.Set(handle, body);
+    }
+    else
+    {
+        e->setKinematicsBody(this->bodies.Add(body));
+    }
+    this->staged.push_back(e);
+    return true;
+}
+
+void EnemyManager::FinishStagedBodies(UpdateContext &uc)
+{
+    if (this->staged.empty())
+        return;
+
+    this->bodies.Integrate(uc.deltaTime);
+    for (Enemy *e : this->staged)
+    {
+        e->FinishStagedMovement(uc, this->bodies);
+        this->FinishUpdate(e, uc);
+    }
+    this->staged.clear();
+}
+
+void EnemyManager::DeleteRemovedEnemies()
+{
+    for (EntityRegistry<Enemy> &list : this->enemiesByType)
+    {
+        list.RemoveMarked([](Enemy *) {});
+    }
+    this->enemies.RemoveMarked([this](Enemy *e) { this->DestroyEnemy(e); });
+}
+
+void EnemyManager::DestroyEnemy(Enemy *e)
+{
+    this->bodies.Remove(e->getKinematicsBody());
+    if (DialogBox *dialog = e->detachHealthDialog())
+    {
+        this->dialogPool.Release(dialog);
+    }
+
+    switch (e->getType())
+    {
+    case ENEMY_MINION:
+        this->ReleaseToPool<MinionEnemy>(e);
+        break;
+    case ENEMY_CHARGING:
+        this->ReleaseToPool<ChargingEnemy>(e);
+        break;
+    case ENEMY_SHOOTER:
+        this->ReleaseToPool<ShooterEnemy>(e);
+        break;
+    case ENEMY_SUMMONER:
+        this->ReleaseToPool<SummonerEnemy>(e);
+        break;
+    case ENEMY_SUPPORT:
+        this->ReleaseToPool<SupportEnemy>(e);
+        break;
+    case ENEMY_VANGUARD:
+        this->ReleaseToPool<VanguardEnemy>(e);
+        break;
+    default:
+        TraceLog(LOG_ERROR, "EnemyManager: enemy with unknown type %d", (int)e->getType());
+        break;
     }
-    if (found != -1)
+}
+
+EnemyManager::EnemyRange::EnemyRange(EnemyManager &owner, const EntityRegistry<Enemy> &list) : EntityView<Enemy>(list), owner(owner)
+{
+    ++this->owner.iterationDepth;
+}
+
+EnemyManager::EnemyRange::~EnemyRange()
+{
+    if (--this->owner.iterationDepth == 0)
     {
-        delete this->enemies[found];
-        this->enemies.erase(this->enemies.begin() + found);
+        this->owner.DeleteRemovedEnemies();
     }
 }
+
 EnemyManager::~EnemyManager()
 {
-    for (auto &e : this->enemies)
-        delete e;
-    this->enemies.clear();
+    this->clear();
 }
-void EnemyManager::addEnemy(Enemy *e)
+
+EntityHandle EnemyManager::addEnemy(Enemy *e)
 {
-    if (e)
-        this->enemies.push_back(e);
+    if (!e)
+        return EntityHandle{};
+    EntityHandle handle = this->enemies.Insert(e);
+    e->setHandle(handle);
+    e->setTypeHandle(this->enemiesByType[e->getType()].Insert(e));
+    this->grid.Insert(e);
+    if (e->getRoom())
+    {
+        e->getRoom()->OnEnemyAdded();
+    }
+    return handle;
+}
+
+namespace
+{
+    unsigned int HashThinkSeed(unsigned int tickSeed, unsigned int index, unsigned int generation)
+    {
+        unsigned int h = tickSeed ^ (index * 0x9E3779B1u) ^ (generation * 0x85EBCA77u);
+        h ^= h >> 16;
+        h *= 0x7FEB352Du;
+        h ^= h >> 15;
+        return h;
+    }
 }
 
 void EnemyManager::update(UpdateContext &uc)
 {
-    // Iterate using an index over a snapshot of the original size
-    // to avoid iterator/reference invalidation when enemies are added
-    // (e.g., Summoner spawning Minions during UpdateBody).
-    size_t originalCount = this->enemies.size();
-    for (size_t i = 0; i < originalCount; ++i)
     {
-        Enemy *e = this->enemies[i];
-        if (e)
-            e->UpdateBody(uc);
+        // Removals are deferred until every type has updated. Spawns go
+        // through Scene::events and join after this update, so the lists
+        // do not grow while they are walked.
+        EnemyRange updating = this->getEnemies();
+
+        // Think phase: nothing moves, spawns or dies until every enemy has
+        // decided. Seeds come from the main thread's RNG and each enemy's
+        // handle, so results do not depend on how the work is split.
+        this->thinking.clear();
+        for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+        {
+            for (Enemy *e : this->enemiesByType[type].View())
+            {
+                if (!IsDormant(e))
+                {
+                    this->thinking.push_back(e);
+                }
+            }
+        }
+        unsigned int tickSeed = (unsigned int)GetRandomValue(0, 0x7FFFFFFF);
+        uc.jobs->ParallelFor("enemy think", this->thinking.size(), 1, [&](size_t first, size_t end)
+        {
+            for (size_t i = first; i < end; ++i)
+            {
+                Enemy *e = this->thinking[i];
+                EntityHandle handle = e->getHandle();
+                ThinkContext tc(uc, HashThinkSeed(tickSeed, handle.index, handle.generation));
+                e->Think(tc);
+            }
+        });
+
+        // Apply phase, serial. One type at a time, so every iteration of a
+        // loop runs the same UpdateBody. Enemies with batched movement stage
+        // their body and finish once the whole type has been integrated.
+        this->stagingBodies = true;
+        for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+        {
+            for (Enemy *e : this->enemiesByType[type].View())
+            {
+                if (IsDormant(e))
+                    continue;
+                e->UpdateBody(uc);
+                if (!e->isMovementStaged())
+                {
+                    this->FinishUpdate(e, uc);
+                }
+            }
+            this->FinishStagedBodies(uc);
+        }
+        this->stagingBodies = false;
     }
+
+    // Re-bin after everyone has moved so the attacks and the player's next
+    // step query up-to-date cells. Sleeping rooms stay out of the grid.
+    this->binned.clear();
+    for (Enemy *e : this->enemies.Items())
+    {
+        if (!IsDormant(e))
+        {
+            this->binned.push_back(e);
+        }
+    }
+    this->grid.Rebuild(this->binned);
 }
 
-std::vector<Object *> EnemyManager::getObjects() const
+void EnemyManager::visitObjects(Visitor<Object> visit) const
 {
-    std::vector<Object *> os;
-    for (auto &e : this->enemies)
+    for (Enemy *e : this->enemies.View())
     {
-        if (!e)
-            continue;
-        e->gatherObjects(os);
+        e->visitObjects(visit);
     }
-    return os;
 }
 
 void EnemyManager::damage(Enemy *enemy, DamageResult &dResult, UpdateContext &uc)
@@ -70,31 +299,120 @@ void EnemyManager::damage(Enemy *enemy, DamageResult &dResult, UpdateContext &uc
     {
         TraceLog(LOG_ERROR, "enemy died\n");
         // Call virtual OnDeath handler for special cleanup (e.g., Summoner minion cleanup)
-        SummonerEnemy *summoner = dynamic_cast<SummonerEnemy*>(enemy);
-        if (summoner)
-        {
-            summoner->OnDeath(uc);
-        }
+        enemy->OnDeath(uc);
         this->RemoveEnemy(enemy);
     }
 }
 
-std::vector<Entity *> EnemyManager::getEntities(EntityCategory cat) const
+void EnemyManager::QuerySphere(const Vector3 &center, float radius, std::vector<Enemy *> &out) const
 {
-    std::vector<Entity *> r;
-    if (cat == ENTITY_ENEMY || cat == ENTITY_ALL)
+    out.clear();
+    const float radiusSq = radius * radius;
+    this->grid.Query(BoundsAround(center, center, radius), [&](Entity *e)
     {
-        for (auto &e : this->enemies)
-            r.push_back(e);
-    }
-    return r;
+        if (Vector3DistanceSqr(center, e->pos()) <= radiusSq)
+            out.push_back(static_cast<Enemy *>(e));
+    });
+}
+
+void EnemyManager::QueryCylinder(const Vector3 &center, float radius, std::vector<Enemy *> &out) const
+{
+    out.clear();
+    const float radiusSq = radius * radius;
+    BoundingBox bounds = BoundsAround(center, center, radius);
+    bounds.min.y = -INFINITY;
+    bounds.max.y = INFINITY;
+    this->grid.Query(bounds, [&](Entity *e)
+    {
+        float dx = e->pos().x - center.x;
+        float dz = e->pos().z - center.z;
+        if (dx * dx + dz * dz <= radiusSq)
+            out.push_back(static_cast<Enemy *>(e));
+    });
+}
+
+void EnemyManager::QueryCapsule(const Vector3 &start, const Vector3 &end, float radius, std::vector<Enemy *> &out) const
+{
+    out.clear();
+    const float radiusSq = radius * radius;
+    const Vector3 segment = Vector3Subtract(end, start);
+    const float lengthSq = Vector3LengthSqr(segment);
+    this->grid.Query(BoundsAround(Vector3Min(start, end), Vector3Max(start, end), radius), [&](Entity *e)
+    {
+        Vector3 toEnemy = Vector3Subtract(e->pos(), start);
+        float t = lengthSq > 1e-8f ? Clamp(Vector3DotProduct(toEnemy, segment) / lengthSq, 0.0f, 1.0f) : 0.0f;
+        Vector3 closest = Vector3Add(start, Vector3Scale(segment, t));
+        if (Vector3DistanceSqr(closest, e->pos()) <= radiusSq)
+            out.push_back(static_cast<Enemy *>(e));
+    });
+}
+
+void EnemyManager::QueryOBB(Object &volume, std::vector<Enemy *> &out) const
+{
+    out.clear();
+    this->grid.Query(OBB_GetBoundingBox(&volume.obb), [&](Entity *e)
+    {
+        if (Object::collided(volume, e->obj()).collided)
+            out.push_back(static_cast<Enemy *>(e));
+    });
+}
+
+void EnemyManager::QueryNearest(const Vector3 &center, float radius, size_t k, std::vector<Enemy *> &out, const Entity *exclude) const
+{
+    out.clear();
+    if (k == 0)
+        return;
+
+    // Bounded insertion sort; k is small for every caller
+    const float radiusSq = radius * radius;
+    auto closer = [&center](const Enemy *a, float distSq) { return Vector3DistanceSqr(center, a->pos()) <= distSq; };
+    this->grid.Query(BoundsAround(center, center, radius), [&](Entity *e)
+    {
+        if (e == exclude)
+            return;
+        float distSq = Vector3DistanceSqr(center, e->pos());
+        if (distSq > radiusSq)
+            return;
+        if (out.size() == k)
+        {
+            if (closer(out.back(), distSq))
+                return;
+            out.pop_back();
+        }
+        auto at = std::partition_point(out.begin(), out.end(), [&](const Enemy *a) { return closer(a, distSq); });
+        out.insert(at, static_cast<Enemy *>(e));
+    });
+}
+
+Enemy *EnemyManager::QueryNearest(const Vector3 &center, float radius, const Entity *exclude) const
+{
+    Enemy *nearest = nullptr;
+    float bestSq = radius * radius;
+    this->grid.Query(BoundsAround(center, center, radius), [&](Entity *e)
+    {
+        if (e == exclude)
+            return;
+        float distSq = Vector3DistanceSqr(center, e->pos());
+        if (distSq <= bestSq)
+        {
+            bestSq = distSq;
+            nearest = static_cast<Enemy *>(e);
+        }
+    });
+    return nearest;
 }
 
 void EnemyManager::clear()
 {
-    for (auto &e : this->enemies)
+    for (Enemy *e : this->enemies.Items())
+    {
+        this->DestroyEnemy(e);
+    }
+    this->enemies.Clear();
+    for (EntityRegistry<Enemy> &list : this->enemiesByType)
     {
-        delete e;
+        list.Clear();
     }
-    this->enemies.clear();
+    this->grid.Clear();
+    this->bodies.Clear();
 }
@@ -0,0 +1,232 @@
+#include "jobSystem.hpp"
+#include <algorithm>
+
+namespace
+{
+    // Queue of the calling thread in the JobSystem that owns it
+    thread_local const JobSystem *currentSystem = nullptr;
+    thread_local unsigned int currentQueue = 0;
+}
+
+JobSystem::JobSystem(int workerCount)
+{
+    if (workerCount < 0)
+    {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? (int)hardware - 1 : 0;
+    }
+
+    currentSystem = this;
+    currentQueue = 0;
+
+    for (int i = 0; i <= workerCount; ++i)
+    {
+        this->queues.push_back(std::make_unique<WorkQueue>());
+    }
+    this->threads.reserve(workerCount);
+    for (int i = 1; i <= workerCount; ++i)
+    {
+        this->threads.emplace_back(&JobSystem::WorkerMain, this, (unsigned int)i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+    for (std::thread &t : this->threads)
+    {
+        t.join();
+    }
+    if (currentSystem == this)
+    {
+        currentSystem = nullptr;
+    }
+}
+
+unsigned int JobSystem::CurrentQueue() const
+{
+    // Threads the system does not know share the creating thread's queue
+    return currentSystem == this ? currentQueue : 0;
+}
+
+void JobSystem::Run(const Job &job)
+{
+    if (job.counter)
+    {
+        job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    this->Submit(job);
+}
+
+void JobSystem::RunAfter(JobCounter &dependency, const Job &job)
+{
+    if (job.counter)
+    {
+        job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+        if (dependency.pending.load(std::memory_order_acquire) != 0)
+        {
+            dependency.continuations.push_back(job);
+            return;
+        }
+    }
+    this->Submit(job);
+}
+
+void JobSystem::Submit(const Job &job)
+{
+    WorkQueue &queue = *this->queues[this->CurrentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    this->queuedJobs.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this against a worker checking queuedJobs before it sleeps.
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+    }
+    this->wake.notify_one();
+}
+
+bool JobSystem::TryRunOne(unsigned int self)
+{
+    Job job;
+    bool found = false;
+
+    // Own queue first, newest job (its data is most likely still in cache)
+    {
+        WorkQueue &own = *this->queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+
+    // Then steal the oldest job of another thread
+    for (size_t i = 1; !found && i < this->queues.size(); ++i)
+    {
+        WorkQueue &victim = *this->queues[(self + i) % this->queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    this->queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    this->Execute(job, self);
+    return true;
+}
+
+void JobSystem::Execute(const Job &job, unsigned int self)
+{
+    if (this->hooks.onJobBegin)
+    {
+        this->hooks.onJobBegin(this->hooks.user, job.name, self);
+    }
+    job.function(job.context, job.first, job.end);
+    if (this->hooks.onJobEnd)
+    {
+        this->hooks.onJobEnd(this->hooks.user, job.name, self);
+    }
+    this->Finish(job.counter);
+}
+
+void JobSystem::Finish(JobCounter *counter)
+{
+    if (!counter)
+        return;
+
+    // The last decrement happens under the lock so WaitFor() can tell when
+    // this thread has let go of the counter.
+    std::vector<Job> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            ready.swap(counter->continuations);
+        }
+    }
+    for (const Job &job : ready)
+    {
+        this->Submit(job);
+    }
+}
+
+void JobSystem::WaitFor(JobCounter &counter)
+{
+    unsigned int self = this->CurrentQueue();
+    while (!counter.IsDone())
+    {
+        if (!this->TryRunOne(self))
+        {
+            std::this_thread::yield();
+        }
+    }
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+void JobSystem::RunChunks(const char *name, size_t count, size_t grain, void (*fn)(void *, size_t, size_t), void *context)
+{
+    if (count == 0)
+        return;
+
+    // A few chunks per thread balance uneven work without flooding the queues.
+    size_t maxChunks = this->queues.size() * 4;
+    grain = std::max(grain, std::max<size_t>(1, (count + maxChunks - 1) / maxChunks));
+    size_t chunkCount = (count + grain - 1) / grain;
+
+    JobCounter counter;
+    counter.pending.store((int)chunkCount, std::memory_order_relaxed);
+
+    Job job;
+    job.function = fn;
+    job.context = context;
+    job.name = name;
+    job.counter = &counter;
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+    {
+        job.first = chunk * grain;
+        job.end = std::min(count, job.first + grain);
+        this->Submit(job);
+    }
+
+    // Run the first chunk here while the others are being picked up
+    job.first = 0;
+    job.end = std::min(count, grain);
+    this->Execute(job, this->CurrentQueue());
+    this->WaitFor(counter);
+}
+
+void JobSystem::WorkerMain(unsigned int index)
+{
+    currentSystem = this;
+    currentQueue = index;
+
+    for (;;)
+    {
+        if (this->TryRunOne(index))
+            continue;
+
+        std::unique_lock<std::mutex> lock(this->sleepMutex);
+        this->wake.wait(lock, [this] { return this->stopping || this->queuedJobs.load(std::memory_order_acquire) > 0; });
+        if (this->stopping)
+            return;
+    }
+}
@@ -0,0 +1,377 @@
+#include "kinematicsStore.hpp"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KINEMATICS_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+#ifdef KINEMATICS_USE_SSE
+    // mask ? a : b
+    inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+#endif
+}
+
+void KinematicsStore::IntegrateVelocity(Vector3 &velocity, const Vector3 &direction, bool grounded, float gravity, float decel,
+                                        float zeroThresholdSq, float maxSpeed, float maxAccel, float delta)
+{
+    // 1. Gravity
+    if (!grounded)
+    {
+        velocity.y -= gravity * delta;
+    }
+
+    // 2. Friction or air drag on the horizontal velocity
+    float hx = velocity.x * decel;
+    float hz = velocity.z * decel;
+
+    // 3. Zero small horizontal velocity
+    if (hx * hx + hz * hz < zeroThresholdSq)
+    {
+        hx = 0.0f;
+        hz = 0.0f;
+    }
+
+    // 4. Accelerate along the direction, never past maxSpeed
+    if (maxAccel > 0.0f)
+    {
+        float speed = hx * direction.x + hz * direction.z;
+        float accel = fminf(fmaxf(maxSpeed - speed, 0.0f), maxAccel * delta);
+        hx += direction.x * accel;
+        hz += direction.z * accel;
+    }
+
+    velocity.x = hx;
+    velocity.z = hz;
+}
+
+void KinematicsStore::SnapToFloor(Vector3 &position, Vector3 &velocity, bool &grounded, float floorY)
+{
+    if (position.y <= floorY)
+    {
+        position.y = floorY;
+        velocity.y = 0.0f;
+        grounded = true;
+    }
+    else if (grounded && velocity.y < floorY + 0.01f)
+    {
+        grounded = false;
+    }
+}
+
+template <typename Fn>
+void KinematicsStore::ForEachColumn(Fn &&fn)
+{
+    std::vector<float> *columns[] = {
+        &this->posX, &this->posY, &this->posZ,
+        &this->velX, &this->velY, &this->velZ,
+        &this->dirX, &this->dirZ, &this->grounded, &this->gravity,
+        &this->decelGround, &this->decelAir, &this->maxSpeed, &this->maxAccel,
+        &this->floorY, &this->zeroThresholdSq, &this->decelGroundStep, &this->decelAirStep};
+    for (std::vector<float> *column : columns)
+    {
+        fn(*column);
+    }
+}
+
+EntityHandle KinematicsStore::Add(const Body &body)
+{
+    unsigned int slotIndex;
+    if (this->freeHead != NO_SLOT)
+    {
+        slotIndex = this->freeHead;
+        this->freeHead = this->slots[slotIndex].nextFree;
+    }
+    else
+    {
+        slotIndex = (unsigned int)this->slots.size();
+        this->slots.push_back(Slot{});
+    }
+
+    Slot &slot = this->slots[slotIndex];
+    slot.dense = (unsigned int)this->posX.size();
+    slot.nextFree = NO_SLOT;
+    this->denseToSlot.push_back(slotIndex);
+
+    float threshold = ResolveZeroThreshold(body.zeroThreshold, body.maxSpeed);
+    this->posX.push_back(body.position.x);
+    this->posY.push_back(body.position.y);
+    this->posZ.push_back(body.position.z);
+    this->velX.push_back(body.velocity.x);
+    this->velY.push_back(body.velocity.y);
+    this->velZ.push_back(body.velocity.z);
+    this->dirX.push_back(body.direction.x);
+    this->dirZ.push_back(body.direction.z);
+    this->grounded.push_back(body.grounded ? 1.0f : 0.0f);
+    this->gravity.push_back(body.useGravity ? body.gravity : 0.0f);
+    this->decelGround.push_back(body.decelGround);
+    this->decelAir.push_back(body.decelAir);
+    this->maxSpeed.push_back(body.maxSpeed);
+    this->maxAccel.push_back(body.maxAccel);
+    this->floorY.push_back(body.floorY);
+    this->zeroThresholdSq.push_back(threshold * threshold);
+    this->decelGroundStep.push_back(1.0f);
+    this->decelAirStep.push_back(1.0f);
+    if (this->stepDelta >= 0.0f)
+    {
+        this->UpdateStepFactors(slot.dense);
+    }
+    return EntityHandle{slotIndex, slot.generation};
+}
+
+void KinematicsStore::Set(EntityHandle handle, const Body &body)
+{
+    int index = this->DenseIndex(handle);
+    if (index < 0)
+        return;
+
+    float threshold = ResolveZeroThreshold(body.zeroThreshold, body.maxSpeed);
+    this->posX[index] = body.position.x;
+    this->posY[index] = body.position.y;
+    this->posZ[index] = body.position.z;
+    this->velX[index] = body.velocity.x;
+    this->velY[index] = body.velocity.y;
+    this->velZ[index] = body.velocity.z;
+    this->dirX[index] = body.direction.x;
+    this->dirZ[index] = body.direction.z;
+    this->grounded[index] = body.grounded ? 1.0f : 0.0f;
+    this->gravity[index] = body.useGravity ? body.gravity : 0.0f;
+    this->maxSpeed[index] = body.maxSpeed;
+    this->maxAccel[index] = body.maxAccel;
+    this->floorY[index] = body.floorY;
+    this->zeroThresholdSq[index] = threshold * threshold;
+    if (this->decelGround[index] != body.decelGround || this->decelAir[index] != body.decelAir)
+    {
+        this->decelGround[index] = body.decelGround;
+        this->decelAir[index] = body.decelAir;
+        if (this->stepDelta >= 0.0f)
+        {
+            this->UpdateStepFactors(index);
+        }
+    }
+}
+
+void KinematicsStore::Remove(EntityHandle handle)
+{
+    int index = this->DenseIndex(handle);
+    if (index < 0)
+        return;
+
+    // Swap-and-pop every column so the arrays stay dense.
+    size_t last = this->posX.size() - 1;
+    this->ForEachColumn([&](std::vector<float> &column)
+    {
+        column[index] = column[last];
+        column.pop_back();
+    });
+    if ((size_t)index != last)
+    {
+        this->denseToSlot[index] = this->denseToSlot[last];
+        this->slots[this->denseToSlot[index]].dense = (unsigned int)index;
+    }
+    this->denseToSlot.pop_back();
+
+    Slot &slot = this->slots[handle.index];
+    if (++slot.generation == 0)
+        slot.generation = 1;
+    slot.nextFree = this->freeHead;
+    this->freeHead = handle.index;
+}
+
+bool KinematicsStore::Contains(EntityHandle handle) const
+{
+    return this->DenseIndex(handle) >= 0;
+}
+
+void KinematicsStore::Clear()
+{
+    while (!this->denseToSlot.empty())
+    {
+        unsigned int slotIndex = this->denseToSlot.back();
+        this->Remove(EntityHandle{slotIndex, this->slots[slotIndex].generation});
+    }
+}
+
+void KinematicsStore::Reserve(size_t count)
+{
+    this->ForEachColumn([&](std::vector<float> &column) { column.reserve(count); });
+    this->denseToSlot.reserve(count);
+    this->slots.reserve(count);
+}
+
+int KinematicsStore::DenseIndex(EntityHandle handle) const
+{
+    if (handle.index >= this->slots.size())
+        return -1;
+    // Removal bumps the generation, so a free slot never matches a handle.
+    const Slot &slot = this->slots[handle.index];
+    if (slot.generation != handle.generation)
+        return -1;
+    return (int)slot.dense;
+}
+
+void KinematicsStore::SetDirection(EntityHandle handle, Vector3 direction)
+{
+    int index = this->DenseIndex(handle);
+    if (index < 0)
+        return;
+    this->dirX[index] = direction.x;
+    this->dirZ[index] = direction.z;
+}
+
+void KinematicsStore::SetVelocity(EntityHandle handle, Vector3 velocity)
+{
+    int index = this->DenseIndex(handle);
+    if (index < 0)
+        return;
+    this->velX[index] = velocity.x;
+    this->velY[index] = velocity.y;
+    this->velZ[index] = velocity.z;
+}
+
+void KinematicsStore::SetFloorY(EntityHandle handle, float floorY)
+{
+    int index = this->DenseIndex(handle);
+    if (index >= 0)
+        this->floorY[index] = floorY;
+}
+
+Vector3 KinematicsStore::GetPosition(EntityHandle handle) const
+{
+    int index = this->DenseIndex(handle);
+    if (index < 0)
+        return {0.0f, 0.0f, 0.0f};
+    return {this->posX[index], this->posY[index], this->posZ[index]};
+}
+
+Vector3 KinematicsStore::GetVelocity(EntityHandle handle) const
+{
+    int index = this->DenseIndex(handle);
+    if (index < 0)
+        return {0.0f, 0.0f, 0.0f};
+    return {this->velX[index], this->velY[index], this->velZ[index]};
+}
+
+bool KinematicsStore::IsGrounded(EntityHandle handle) const
+{
+    int index = this->DenseIndex(handle);
+    return index >= 0 && this->grounded[index] > 0.5f;
+}
+
+void KinematicsStore::UpdateStepFactors(size_t index)
+{
+    // Same per-step drag as ApplyPhysics; powf only runs when the step length changes.
+    this->decelGroundStep[index] = powf(this->decelGround[index], this->stepDelta * PHYSICS_REFERENCE_HZ);
+    this->decelAirStep[index] = powf(this->decelAir[index], this->stepDelta * PHYSICS_REFERENCE_HZ);
+}
+
+void KinematicsStore::Integrate(float delta)
+{
+    if (delta != this->stepDelta)
+    {
+        this->stepDelta = delta;
+        for (size_t i = 0; i < this->posX.size(); ++i)
+        {
+            this->UpdateStepFactors(i);
+        }
+    }
+
+    size_t count = this->posX.size();
+    size_t vectorEnd = 0;
+#ifdef KINEMATICS_USE_SSE
+    vectorEnd = count - count % LANES;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 dt = _mm_set1_ps(delta);
+    const __m128 liftOff = _mm_set1_ps(0.01f);
+    for (size_t i = 0; i < vectorEnd; i += LANES)
+    {
+        __m128 px = _mm_loadu_ps(&this->posX[i]);
+        __m128 py = _mm_loadu_ps(&this->posY[i]);
+        __m128 pz = _mm_loadu_ps(&this->posZ[i]);
+        __m128 vx = _mm_loadu_ps(&this->velX[i]);
+        __m128 vy = _mm_loadu_ps(&this->velY[i]);
+        __m128 vz = _mm_loadu_ps(&this->velZ[i]);
+        __m128 dx = _mm_loadu_ps(&this->dirX[i]);
+        __m128 dz = _mm_loadu_ps(&this->dirZ[i]);
+        __m128 onGround = _mm_cmpgt_ps(_mm_loadu_ps(&this->grounded[i]), half);
+        __m128 floor = _mm_loadu_ps(&this->floorY[i]);
+
+        // 1. Gravity for airborne bodies
+        vy = _mm_sub_ps(vy, _mm_andnot_ps(onGround, _mm_mul_ps(_mm_loadu_ps(&this->gravity[i]), dt)));
+
+        // 2. Drag
+        __m128 decel = Select(onGround, _mm_loadu_ps(&this->decelGroundStep[i]), _mm_loadu_ps(&this->decelAirStep[i]));
+        __m128 hx = _mm_mul_ps(vx, decel);
+        __m128 hz = _mm_mul_ps(vz, decel);
+
+        // 3. Cutoff
+        __m128 speedSq = _mm_add_ps(_mm_mul_ps(hx, hx), _mm_mul_ps(hz, hz));
+        __m128 stop = _mm_cmplt_ps(speedSq, _mm_loadu_ps(&this->zeroThresholdSq[i]));
+        hx = _mm_andnot_ps(stop, hx);
+        hz = _mm_andnot_ps(stop, hz);
+
+        // 4. Acceleration clamped to [0, maxAccel * dt]
+        __m128 maxAccel = _mm_loadu_ps(&this->maxAccel[i]);
+        __m128 speed = _mm_add_ps(_mm_mul_ps(hx, dx), _mm_mul_ps(hz, dz));
+        __m128 accel = _mm_min_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&this->maxSpeed[i]), speed), zero), _mm_mul_ps(maxAccel, dt));
+        accel = _mm_and_ps(_mm_cmpgt_ps(maxAccel, zero), accel);
+        vx = _mm_add_ps(hx, _mm_mul_ps(dx, accel));
+        vz = _mm_add_ps(hz, _mm_mul_ps(dz, accel));
+
+        // 5. Integrate
+        px = _mm_add_ps(px, _mm_mul_ps(vx, dt));
+        py = _mm_add_ps(py, _mm_mul_ps(vy, dt));
+        pz = _mm_add_ps(pz, _mm_mul_ps(vz, dt));
+
+        // 8. Floor snap (step numbers follow ApplyPhysics)
+        __m128 below = _mm_cmple_ps(py, floor);
+        __m128 leaving = _mm_andnot_ps(below, _mm_and_ps(onGround, _mm_cmplt_ps(vy, _mm_add_ps(floor, liftOff))));
+        py = Select(below, floor, py);
+        vy = _mm_andnot_ps(below, vy);
+        onGround = _mm_andnot_ps(leaving, _mm_or_ps(below, onGround));
+
+        _mm_storeu_ps(&this->posX[i], px);
+        _mm_storeu_ps(&this->posY[i], py);
+        _mm_storeu_ps(&this->posZ[i], pz);
+        _mm_storeu_ps(&this->velX[i], vx);
+        _mm_storeu_ps(&this->velY[i], vy);
+        _mm_storeu_ps(&this->velZ[i], vz);
+        _mm_storeu_ps(&this->grounded[i], _mm_and_ps(onGround, one));
+    }
+#endif
+    this->IntegrateRange(vectorEnd, count, delta);
+}
+
+void KinematicsStore::IntegrateRange(size_t first, size_t end, float delta)
+{
+    for (size_t i = first; i < end; ++i)
+    {
+        Vector3 position = {this->posX[i], this->posY[i], this->posZ[i]};
+        Vector3 velocity = {this->velX[i], this->velY[i], this->velZ[i]};
+        Vector3 direction = {this->dirX[i], 0.0f, this->dirZ[i]};
+        bool onGround = this->grounded[i] > 0.5f;
+        float decel = onGround ? this->decelGroundStep[i] : this->decelAirStep[i];
+
+        IntegrateVelocity(velocity, direction, onGround, this->gravity[i], decel, this->zeroThresholdSq[i],
+                          this->maxSpeed[i], this->maxAccel[i], delta);
+        position.x += velocity.x * delta;
+        position.y += velocity.y * delta;
+        position.z += velocity.z * delta;
+        SnapToFloor(position, velocity, onGround, this->floorY[i]);
+
+        this->posX[i] = position.x;
+        this->posY[i] = position.y;
+        this->posZ[i] = position.z;
+        this->velX[i] = velocity.x;
+        this->velY[i] = velocity.y;
+        this->velZ[i] = velocity.z;
+        this->grounded[i] = onGround ? 1.0f : 0.0f;
+    }
+}
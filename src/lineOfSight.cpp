@@ -0,0 +1,160 @@
+#include "lineOfSight.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr int CELL_BITS = 21;
+constexpr int64_t CELL_BIAS = int64_t(1) << (CELL_BITS - 1);
+constexpr uint64_t CELL_MASK = (uint64_t(1) << CELL_BITS) - 1;
+
+uint64_t PackAxis(float scaled)
+{
+    return (uint64_t)((int64_t)floorf(scaled) + CELL_BIAS) & CELL_MASK;
+}
+
+uint64_t Mix(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+size_t NextPowerOfTwo(size_t n)
+{
+    size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+}
+
+LineOfSightCache::LineOfSightCache(float cellSize, size_t capacity)
+    : invCellSize(1.0f / cellSize)
+{
+    size_t size = NextPowerOfTwo(std::max<size_t>(capacity, 1));
+    this->mask = size - 1;
+    this->entries.resize(size);
+}
+
+void LineOfSightCache::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (++this->generation == 0)
+    {
+        // Wrapped: stale entries could match again, so empty them for real
+        std::fill(this->entries.begin(), this->entries.end(), Entry{});
+        this->generation = 1;
+    }
+}
+
+void LineOfSightCache::SyncRevision(unsigned int revision)
+{
+    if (revision == this->revision)
+        return;
+    this->revision = revision;
+    this->Invalidate();
+}
+
+uint64_t LineOfSightCache::CellKey(const Vector3 &p) const
+{
+    return PackAxis(p.x * this->invCellSize) |
+           (PackAxis(p.y * this->invCellSize) << CELL_BITS) |
+           (PackAxis(p.z * this->invCellSize) << (2 * CELL_BITS));
+}
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(const Vector3 &start, const Vector3 &end, float radius, float ignoreDistance) const
+{
+    Key key;
+    key.from = this->CellKey(start);
+    key.to = this->CellKey(end);
+    key.radius = radius;
+    key.ignoreDistance = ignoreDistance;
+    return key;
+}
+
+size_t LineOfSightCache::SlotOf(const Key &key) const
+{
+    return (size_t)Mix(key.from * 31 + Mix(key.to)) & this->mask;
+}
+
+bool LineOfSightCache::Lookup(const Key &key, bool &outBlocked)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    const Entry &entry = this->entries[this->SlotOf(key)];
+    if (entry.generation != this->generation || entry.key.from != key.from || entry.key.to != key.to ||
+        entry.key.radius != key.radius || entry.key.ignoreDistance != key.ignoreDistance)
+    {
+        return false;
+    }
+    outBlocked = entry.blocked;
+    return true;
+}
+
+void LineOfSightCache::Store(const Key &key, bool blocked)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Entry &entry = this->entries[this->SlotOf(key)];
+    entry.key = key;
+    entry.generation = this->generation;
+    entry.blocked = blocked;
+}
+
+void VisibilityField::BeginBuild(const BoundingBox &area, float cellSize, float sampleHeight)
+{
+    this->originX = area.min.x;
+    this->originZ = area.min.z;
+    this->cellSize = cellSize;
+    this->invCellSize = 1.0f / cellSize;
+    this->sampleHeight = sampleHeight;
+    this->columns = std::max(1, (int)ceilf((area.max.x - area.min.x) * this->invCellSize));
+    this->rows = std::max(1, (int)ceilf((area.max.z - area.min.z) * this->invCellSize));
+
+    const size_t count = (size_t)this->CellCount();
+    this->bits.assign((count * count + 63) / 64, 0);
+    for (size_t cell = 0; cell < count; ++cell)
+    {
+        const size_t bit = cell * count + cell;
+        this->bits[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+}
+
+Vector3 VisibilityField::CellCenter(int cell) const
+{
+    const int column = cell % this->columns;
+    const int row = cell / this->columns;
+    return {this->originX + (column + 0.5f) * this->cellSize,
+            this->sampleHeight,
+            this->originZ + (row + 0.5f) * this->cellSize};
+}
+
+int VisibilityField::CellOf(const Vector3 &p) const
+{
+    const int column = (int)floorf((p.x - this->originX) * this->invCellSize);
+    const int row = (int)floorf((p.z - this->originZ) * this->invCellSize);
+    if (column < 0 || column >= this->columns || row < 0 || row >= this->rows)
+        return -1;
+    return row * this->columns + column;
+}
+
+void VisibilityField::SetVisible(int a, int b)
+{
+    const size_t count = (size_t)this->CellCount();
+    const size_t ab = (size_t)a * count + b;
+    const size_t ba = (size_t)b * count + a;
+    this->bits[ab >> 6] |= uint64_t(1) << (ab & 63);
+    this->bits[ba >> 6] |= uint64_t(1) << (ba & 63);
+}
+
+bool VisibilityField::MayBeVisible(const Vector3 &a, const Vector3 &b) const
+{
+    if (!this->IsBuilt())
+        return true;
+
+    const int cellA = this->CellOf(a);
+    const int cellB = this->CellOf(b);
+    if (cellA < 0 || cellB < 0)
+        return true;
+    return this->TestBit((size_t)cellA * this->CellCount() + cellB);
+}
@@ -7,6 +7,8 @@
 #include "uiManager.hpp"
 #include "resource_dir.hpp"
 #include "updateContext.hpp"
+#include "simulationClock.hpp"
+#include "jobSystem.hpp"
 
 int main(void)
 {
@@ -18,6 +20,10 @@ int main(void)
     
     // Load shared resources for enemies
     VanguardEnemy::LoadSharedResources();
+    SummonerEnemy::LoadSharedResources();
+
+    // Worker threads for per-frame work; lives until the game exits
+    JobSystem jobs;
 
     Me player;
     Scene scene;
@@ -33,6 +39,8 @@ int main(void)
     SetTargetFPS(60); // Set our game to run at 60 frames-per-second
 
     bool gamePaused = false;
+    SimulationClock simClock;
+    bool jumpQueued = false; // Held until the next simulation tick consumes it
     struct SlotBinding
     {
         enum class Type
@@ -55,6 +63,8 @@ int main(void)
             break;
         }
 
+        const float frameTime = GetFrameTime();
+
         if (IsKeyPressed(KEY_ESCAPE))
         {
             gamePaused = !gamePaused;
@@ -124,7 +134,8 @@ int main(void)
 
             sideway = (IsKeyDown(KEY_D) - IsKeyDown(KEY_A));
             forward = (IsKeyDown(KEY_W) - IsKeyDown(KEY_S));
-            jumpPressed = IsKeyPressed(KEY_SPACE);
+            jumpQueued = jumpQueued || IsKeyPressed(KEY_SPACE);
+            jumpPressed = jumpQueued;
             crouching = IsKeyDown(KEY_LEFT_CONTROL);
         }
         else
@@ -135,7 +146,7 @@ int main(void)
         
         PlayerInput frameInput(sideway, forward, jumpPressed, crouching);
 
-        UpdateContext uc(&scene, &player, frameInput, &uiManager);
+        UpdateContext uc(&scene, &player, frameInput, &uiManager, frameTime, &jobs);
 
         if (!gamePaused)
         {
@@ -269,9 +280,20 @@ int main(void)
                 }
             }
 
-            player.UpdateBody(uc);
-            player.UpdateCamera(uc);
-            scene.Update(uc); // Pass the player to the scene update
+            // Simulate in fixed ticks so results do not depend on the render rate
+            int ticks = simClock.Advance(frameTime);
+            for (int tick = 0; tick < ticks; ++tick)
+            {
+                PlayerInput tickInput(sideway, forward, jumpQueued && tick == 0, crouching);
+                UpdateContext tickContext(&scene, &player, tickInput, &uiManager, simClock.Step(), &jobs);
+                scene.StorePreviousPositions(&player);
+                player.UpdateBody(tickContext);
+                scene.Update(tickContext);
+            }
+            if (ticks > 0)
+            {
+                jumpQueued = false;
+            }
         }
 
         // Briefcase menu update: UIManager queries Scene for activation/state
@@ -289,6 +311,7 @@ int main(void)
         if (uiManager.consumeRespawnRequest())
         {
             player.respawn(player.getSpawnPosition());
+            player.storePreviousPosition(); // Do not blend across the teleport
             uiManager.setGameOverVisible(false);
             gamePaused = false;
             uiManager.setPauseMenuVisible(false);
@@ -309,6 +332,13 @@ int main(void)
             break;
         }
 
+        // Draw between the last two ticks; the camera follows the blended player position
+        scene.BeginRenderInterpolation(&player, simClock.Alpha());
+        if (!gamePaused)
+        {
+            player.UpdateCamera(uc);
+        }
+
         // Draw-----------------------------------------------------------------------------
         BeginDrawing();
 
@@ -386,6 +416,7 @@ int main(void)
         }
         
         EndDrawing();
+        scene.EndRenderInterpolation();
         //----------------------------------------------------------------------------------
     }
 
@@ -397,6 +428,7 @@ int main(void)
     
     // Cleanup shared resources
     VanguardEnemy::UnloadSharedResources();
+    SummonerEnemy::UnloadSharedResources();
     
     CloseWindow(); // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
@@ -3,6 +3,7 @@
 #include "constant.hpp"
 #include "raymath.h"
 #include "attack.hpp"
+#include "kinematicsStore.hpp"
 #include <iostream>
 
 // Updates the player's state based on user input and physics
@@ -16,7 +17,7 @@ void Me::applyPlayerMovement(UpdateContext &uc)
     if ((uc.playerInput.side != 0) && (uc.playerInput.forward != 0))
         input = Vector2Normalize(input);
 
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
 
     bool knockedBack = this->knockbackTimer > 0.0f;
     if (knockedBack)
@@ -99,12 +100,12 @@ void Me::UpdateBody(UpdateContext &uc)
     this->applyPlayerMovement(uc);
     if (this->meleeSwingTimer > 0.0f)
     {
-        float delta = GetFrameTime();
+        float delta = uc.deltaTime;
         this->meleeSwingTimer = fmaxf(0.0f, this->meleeSwingTimer - delta);
     }
     
     // Update damage visual timers
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     if (this->damageFlashTimer > 0.0f)
     {
         this->damageFlashTimer = fmaxf(0.0f, this->damageFlashTimer - delta);
@@ -115,14 +116,12 @@ void Me::UpdateBody(UpdateContext &uc)
         // Animate damage number floating upward
         this->damageNumberY += 120.0f * delta;
     }
-    
-    this->UpdateCamera(uc);
 }
 
 // Updates the camera's position and orientation based on player movement
 void Me::UpdateCamera(UpdateContext &uc)
 {
-    this->camera.UpdateCamera(uc.playerInput.side, uc.playerInput.forward, uc.playerInput.crouchHold, this->position, this->getColliderHalfHeight(), this->grounded, this->getMeleeSwingAmount());
+    this->camera.UpdateCamera(uc.deltaTime, uc.playerInput.side, uc.playerInput.forward, uc.playerInput.crouchHold, this->position, this->getColliderHalfHeight(), this->grounded, this->getMeleeSwingAmount());
 }
 
 void Me::triggerMeleeSwing(float durationSeconds)
@@ -271,22 +270,12 @@ void Projectile::UpdateBody(UpdateContext &uc)
 
     Entity::ApplyPhysics(this, uc, params);
 
-    // Do projectile-specific collision handling (damage to enemies and models)
-    auto results = Object::collided(this->o, uc.scene);
+    // Do projectile-specific collision handling (damage to enemies); static hits are left to the physics
+    auto results = Object::collided(this->o, uc.scene, COLLISION_LAYER_ENEMY);
     for (auto &result : results)
     {
-        if (result.with && result.with->category() == ENTITY_ENEMY)
-        {
-            Enemy *e = static_cast<Enemy *>(result.with);
-            auto dResult = DamageResult(10, result);
-            uc.scene->em.damage(e, dResult, uc);
-        }
-        // Player projectiles also collide with static model objects (decorations)
-        else if (!result.with && result.collided)
-        {
-            // Hit a static decoration/model; projectile should stop/destroy
-            // For now, we let the physics handle it; could add removal logic here
-        }
+        Enemy *e = static_cast<Enemy *>(result.with);
+        uc.scene->events.Damage(e, 10);
     }
 }
 
@@ -295,99 +284,116 @@ EntityCategory Projectile::category() const
     return ENTITY_PROJECTILE;
 }
 
-void Entity::resolveCollision(Entity *e, UpdateContext &uc)
+void Entity::applyContactDisplacement(const Vector3 &displacement)
 {
-    for (int i = 0; i < 5; i++)
+    this->contactPending = false;
+    Vector3 corrected = Vector3Add(this->position, displacement);
+    if (corrected.y < this->contactFloorY)
     {
-        std::vector<CollisionResult> results = Object::collided(e->o, uc.scene);
-        if (e != uc.player)
-        {
-            auto playerResult = Object::collided(e->o, uc.player->obj());
-            if (playerResult.collided)
-                results.push_back(playerResult);
-        }
-        if (results.size() == 0)
-            break;
-        for (auto &result : results)
-        {
-            if (result.with == e)
-                continue;
-            e->position = Vector3Add(e->position, Vector3Scale(result.normal, result.penetration));
-            e->o.pos = e->position;
-            e->o.UpdateOBB();
-
-            float dot = Vector3DotProduct(e->velocity, result.normal);
-            if (dot < 0)
-            {
-                e->velocity = Vector3Subtract(e->velocity, Vector3Scale(result.normal, dot));
-            }
-            // if (fabs(result.normal.y) > 0.7f && result.normal.y > 0)
-            // {
-            //     e->grounded = true;
-            // }
-        }
+        corrected.y = this->contactFloorY;
+        this->velocity.y = fmaxf(this->velocity.y, 0.0f);
+        this->grounded = true;
     }
+    this->o.pos = Vector3Add(this->o.pos, Vector3Subtract(corrected, this->position));
+    this->position = corrected;
+    this->o.UpdateOBB();
 }
 
 void Entity::ApplyPhysics(Entity *e, UpdateContext &uc, const PhysicsParams &p)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
 
-    // 1. Gravity
-    if (p.useGravity && !e->grounded)
-    {
-        e->velocity.y -= p.gravity * delta;
-    }
+    // 1-4. Gravity, friction or air drag (factors are tuned per reference step),
+    // zeroing of small horizontal velocity and acceleration along entity direction.
+    // Shared with KinematicsStore so both integrators stay in lockstep.
+    float decel = powf(e->grounded ? p.decelGround : p.decelAir, delta * PHYSICS_REFERENCE_HZ);
+    float threshold = KinematicsStore::ResolveZeroThreshold(p.zeroThreshold, p.maxSpeed);
+    KinematicsStore::IntegrateVelocity(e->velocity, e->direction, e->grounded, p.useGravity ? p.gravity : 0.0f, decel,
+                                       threshold * threshold, p.maxSpeed, p.maxAccel, delta);
 
-    // 2. Apply friction or air drag to horizontal velocity
-    float decel = (e->grounded ? p.decelGround : p.decelAir);
-    Vector3 hvel = {e->velocity.x * decel, 0.0f, e->velocity.z * decel};
+    IntegratePosition(e, uc, p);
+}
 
-    // 3. Zero small horizontal velocity
-    float threshold = (p.zeroThreshold > 0.0f) ? p.zeroThreshold : (p.maxSpeed > 0.0f ? p.maxSpeed * 0.01f : MAX_SPEED * 0.01f);
-    if (Vector3Length(hvel) < threshold)
+void Entity::ApplyBatchedPhysics(Entity *e, UpdateContext &uc, const PhysicsParams &p, const KinematicsStore &bodies, EntityHandle body)
+{
+    float delta = uc.deltaTime;
+
+    // Steps 1-4 changed y only by gravity and the floor snap changed only y,
+    // so this is the velocity ApplyPhysics() moves the entity by.
+    Vector3 velocity = bodies.GetVelocity(body);
+    velocity.y = e->velocity.y;
+    if (!e->grounded)
     {
-        hvel = {0, 0, 0};
+        velocity.y -= (p.useGravity ? p.gravity : 0.0f) * delta;
     }
 
-    // 4. Optionally apply acceleration along entity direction
-    if (p.maxAccel > 0.0f)
+    if (uc.scene)
     {
-        float speed = Vector3DotProduct(hvel, e->direction);
-        float accel = Clamp(p.maxSpeed - speed, 0.f, p.maxAccel * delta);
-        hvel.x += e->direction.x * accel;
-        hvel.z += e->direction.z * accel;
+        OBB moving = e->o.obb;
+        moving.center = e->position;
+        if (OBB_MotionNeedsSweep(&moving, Vector3Scale(velocity, delta)))
+        {
+            // The store moved straight through; redo the move with the sweep
+            e->velocity = velocity;
+            IntegratePosition(e, uc, p);
+            return;
+        }
     }
 
-    e->velocity.x = hvel.x;
-    e->velocity.z = hvel.z;
+    e->position = bodies.GetPosition(body);
+    e->velocity = bodies.GetVelocity(body);
+    e->grounded = bodies.IsGrounded(body);
+    e->o.pos = e->position;
+    e->o.UpdateOBB();
+    e->contactPending = p.iterativeCollisionResolve && uc.scene;
+    e->contactFloorY = p.floorY;
+}
 
-    // 5. Integrate position
-    e->position.x += e->velocity.x * delta;
-    e->position.y += e->velocity.y * delta;
-    e->position.z += e->velocity.z * delta;
+KinematicsStore::Body Entity::BodyFor(const PhysicsParams &p) const
+{
+    KinematicsStore::Body body;
+    body.position = this->position;
+    body.velocity = this->velocity;
+    body.direction = this->direction;
+    body.grounded = this->grounded;
+    body.useGravity = p.useGravity;
+    body.gravity = p.gravity;
+    body.decelGround = p.decelGround;
+    body.decelAir = p.decelAir;
+    body.maxSpeed = p.maxSpeed;
+    body.maxAccel = p.maxAccel;
+    body.floorY = p.floorY;
+    body.zeroThreshold = p.zeroThreshold;
+    return body;
+}
+
+void Entity::IntegratePosition(Entity *e, UpdateContext &uc, const PhysicsParams &p)
+{
+    float delta = uc.deltaTime;
+
+    // 5. Integrate position, sweeping when one step could tunnel through a wall
+    Vector3 displacement = Vector3Scale(e->velocity, delta);
+    if (uc.scene)
+    {
+        OBB moving = e->o.obb;
+        moving.center = e->position;
+        if (OBB_MotionNeedsSweep(&moving, displacement))
+        {
+            displacement = uc.scene->SlideOBB(moving, displacement, e, &e->velocity);
+        }
+    }
+    e->position = Vector3Add(e->position, displacement);
 
     // 6. Update object and OBB
     e->o.pos = e->position;
     e->o.UpdateOBB();
 
-    // 7. Optional iterative collision resolution
-    if (p.iterativeCollisionResolve)
-    {
-        Entity::resolveCollision(e, uc);
-    }
+    // 7. Overlaps are resolved for all entities at once by the scene's contact solver
+    e->contactPending = p.iterativeCollisionResolve && uc.scene;
+    e->contactFloorY = p.floorY;
 
     // 8. Floor collision (using provided floorY)
-    if (e->position.y <= p.floorY)
-    {
-        e->position.y = p.floorY;
-        e->velocity.y = 0.0f;
-        e->grounded = true;
-    }
-    else if (e->grounded && e->velocity.y < p.floorY + 0.01f)
-    {
-        e->grounded = false;
-    }
+    KinematicsStore::SnapToFloor(e->position, e->velocity, e->grounded, p.floorY);
 
     // 9. Final OBB update after any positional corrections
     e->o.pos = e->position;
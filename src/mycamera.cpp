@@ -2,9 +2,9 @@
 #include <raylib.h>
 #include <raymath.h>
 #include <cmath>
-void MyCamera::UpdateCamera(char sideway, char forward, bool crouching, Vector3 playerCenter, float colliderHalfHeight, bool isGrounded, float swingAmount)
+void MyCamera::UpdateCamera(float deltaSeconds, char sideway, char forward, bool crouching, Vector3 playerCenter, float colliderHalfHeight, bool isGrounded, float swingAmount)
 {
-    float delta = GetFrameTime();
+    float delta = deltaSeconds;
     this->headLerp = Lerp(this->headLerp, (crouching ? CROUCH_HEIGHT : STAND_HEIGHT), 20.0f * delta);
     float footY = playerCenter.y - colliderHalfHeight;
     this->camera.position = {
@@ -0,0 +1,307 @@
+#include "obbBatch.hpp"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OBB_BATCH_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+// Padding lanes sit far away with zero extents so every axis separates them.
+constexpr float PADDING_CENTER = 1.0e18f;
+constexpr float CROSS_AXIS_EPSILON = 0.0001f; // Same threshold as GetCollisionOBBvsOBB
+
+#ifdef OBB_BATCH_USE_SSE
+struct Lanes3
+{
+    __m128 x, y, z;
+};
+
+inline Lanes3 Splat(const Vector3 &v)
+{
+    return {_mm_set1_ps(v.x), _mm_set1_ps(v.y), _mm_set1_ps(v.z)};
+}
+
+inline Lanes3 Load(const std::vector<float> (&src)[3], size_t offset)
+{
+    return {_mm_loadu_ps(&src[0][offset]), _mm_loadu_ps(&src[1][offset]), _mm_loadu_ps(&src[2][offset])};
+}
+
+inline __m128 Dot(const Lanes3 &a, const Lanes3 &b)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+}
+
+inline Lanes3 Cross(const Lanes3 &a, const Lanes3 &b)
+{
+    return {_mm_sub_ps(_mm_mul_ps(a.y, b.z), _mm_mul_ps(a.z, b.y)),
+            _mm_sub_ps(_mm_mul_ps(a.z, b.x), _mm_mul_ps(a.x, b.z)),
+            _mm_sub_ps(_mm_mul_ps(a.x, b.y), _mm_mul_ps(a.y, b.x))};
+}
+
+inline __m128 Abs(__m128 v)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+inline __m128 Select(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+{
+    return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+inline __m128 ProjectRadius(const Lanes3 axes[3], const __m128 half[3], const Lanes3 &axis)
+{
+    __m128 r = _mm_add_ps(_mm_mul_ps(Abs(Dot(axes[0], axis)), half[0]),
+                          _mm_mul_ps(Abs(Dot(axes[1], axis)), half[1]));
+    return _mm_add_ps(r, _mm_mul_ps(Abs(Dot(axes[2], axis)), half[2]));
+}
+
+/**
+ * Per-block SAT state. Lanes that already found a separating axis keep
+ * running (results are discarded) until every lane has separated.
+ */
+struct BlockSAT
+{
+    Lanes3 centerA, centerB;
+    Lanes3 axesA[3], axesB[3];
+    __m128 halfA[3], halfB[3];
+    __m128 separated = _mm_setzero_ps();
+    __m128 penetration = _mm_set1_ps(INFINITY);
+    Lanes3 normal = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+
+    // Returns true once all four lanes are separated.
+    bool TestAxis(const Lanes3 &axis, __m128 valid)
+    {
+        __m128 centerProjA = Dot(this->centerA, axis);
+        __m128 radiusA = ProjectRadius(this->axesA, this->halfA, axis);
+        __m128 centerProjB = Dot(this->centerB, axis);
+        __m128 radiusB = ProjectRadius(this->axesB, this->halfB, axis);
+
+        __m128 minA = _mm_sub_ps(centerProjA, radiusA);
+        __m128 maxA = _mm_add_ps(centerProjA, radiusA);
+        __m128 minB = _mm_sub_ps(centerProjB, radiusB);
+        __m128 maxB = _mm_add_ps(centerProjB, radiusB);
+
+        __m128 sep = _mm_or_ps(_mm_cmplt_ps(maxA, minB), _mm_cmplt_ps(maxB, minA));
+        this->separated = _mm_or_ps(this->separated, _mm_and_ps(sep, valid));
+
+        __m128 overlap = _mm_sub_ps(_mm_min_ps(maxA, maxB), _mm_max_ps(minA, minB));
+        __m128 better = _mm_and_ps(_mm_cmplt_ps(overlap, this->penetration), valid);
+        this->penetration = Select(better, overlap, this->penetration);
+        this->normal.x = Select(better, axis.x, this->normal.x);
+        this->normal.y = Select(better, axis.y, this->normal.y);
+        this->normal.z = Select(better, axis.z, this->normal.z);
+
+        return _mm_movemask_ps(this->separated) == 0xF;
+    }
+};
+
+bool RunBlockSAT(BlockSAT &sat)
+{
+    const __m128 allLanes = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (sat.TestAxis(sat.axesA[i], allLanes))
+            return false;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        if (sat.TestAxis(sat.axesB[i], allLanes))
+            return false;
+    }
+
+    const __m128 epsilon = _mm_set1_ps(CROSS_AXIS_EPSILON);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            Lanes3 cross = Cross(sat.axesA[i], sat.axesB[j]);
+            __m128 lengthSqr = Dot(cross, cross);
+            __m128 valid = _mm_cmpgt_ps(lengthSqr, epsilon);
+            if (_mm_movemask_ps(valid) == 0)
+                continue;
+
+            // Invalid lanes divide by a tiny length; their results are masked out.
+            __m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(lengthSqr, epsilon)));
+            Lanes3 axis = {_mm_mul_ps(cross.x, invLength), _mm_mul_ps(cross.y, invLength), _mm_mul_ps(cross.z, invLength)};
+            if (sat.TestAxis(axis, valid))
+                return false;
+        }
+    }
+    return true;
+}
+#endif
+}
+
+namespace
+{
+void CollideRangeScalar(const OBB *a, const OBBBatch &batch, size_t first, size_t count, CollisionResult *out)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        OBB b = batch.Get(first + i);
+        out[i] = GetCollisionOBBvsOBB(a, &b);
+        if (!out[i].collided)
+            out[i] = {nullptr, false, 0.0f, {0.0f, 0.0f, 0.0f}};
+    }
+}
+}
+
+void OBBBatch::Clear()
+{
+    this->count = 0;
+    for (int c = 0; c < 3; ++c)
+    {
+        this->center[c].clear();
+        this->halfExtents[c].clear();
+        for (int a = 0; a < 3; ++a)
+            this->axes[a][c].clear();
+    }
+    this->rotations.clear();
+}
+
+void OBBBatch::AppendEntry(const OBB &obb)
+{
+    const float *centerComponents = &obb.center.x;
+    const float *halfComponents = &obb.halfExtents.x;
+    for (int c = 0; c < 3; ++c)
+    {
+        this->center[c].push_back(centerComponents[c]);
+        this->halfExtents[c].push_back(halfComponents[c]);
+        for (int a = 0; a < 3; ++a)
+            this->axes[a][c].push_back((&obb.axes[a].x)[c]);
+    }
+}
+
+void OBBBatch::AppendPadding()
+{
+    for (int c = 0; c < 3; ++c)
+    {
+        this->center[c].push_back(PADDING_CENTER);
+        this->halfExtents[c].push_back(0.0f);
+        for (int a = 0; a < 3; ++a)
+            this->axes[a][c].push_back(a == c ? 1.0f : 0.0f);
+    }
+}
+
+void OBBBatch::Add(const OBB &obb)
+{
+    // Drop the padding tail, append, then pad back to a full lane group.
+    size_t padded = this->center[0].size();
+    for (size_t i = this->count; i < padded; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            this->center[c].pop_back();
+            this->halfExtents[c].pop_back();
+            for (int a = 0; a < 3; ++a)
+                this->axes[a][c].pop_back();
+        }
+    }
+
+    this->AppendEntry(obb);
+    this->rotations.push_back(obb.rotation);
+    ++this->count;
+
+    while (this->center[0].size() % LANES != 0)
+        this->AppendPadding();
+}
+
+void OBBBatch::AlignToLanes()
+{
+    // The padding tail already exists; promote it to real (never-colliding) entries.
+    while (this->count % LANES != 0)
+    {
+        this->rotations.push_back(QuaternionIdentity());
+        ++this->count;
+    }
+}
+
+OBB OBBBatch::Get(size_t index) const
+{
+    OBB obb;
+    obb.center = {this->center[0][index], this->center[1][index], this->center[2][index]};
+    obb.halfExtents = {this->halfExtents[0][index], this->halfExtents[1][index], this->halfExtents[2][index]};
+    obb.rotation = this->rotations[index];
+    for (int a = 0; a < 3; ++a)
+        obb.axes[a] = {this->axes[a][0][index], this->axes[a][1][index], this->axes[a][2][index]};
+    return obb;
+}
+
+void GetCollisionOBBvsOBBBatchScalar(const OBB *a, const OBBBatch &batch, std::vector<CollisionResult> &out)
+{
+    out.resize(batch.size());
+    CollideRangeScalar(a, batch, 0, batch.size(), out.data());
+}
+
+void GetCollisionOBBvsOBBBatch(const OBB *a, const OBBBatch &batch, std::vector<CollisionResult> &out)
+{
+    out.resize(batch.size());
+    if (!batch.empty())
+        GetCollisionOBBvsOBBBatch(a, batch, 0, batch.size(), out.data());
+}
+
+void GetCollisionOBBvsOBBBatch(const OBB *a, const OBBBatch &batch, size_t first, size_t count, CollisionResult *out)
+{
+#ifdef OBB_BATCH_USE_SSE
+    size_t end = first + count;
+    for (size_t base = first; base < end; base += OBBBatch::LANES)
+    {
+        BlockSAT sat;
+        sat.centerA = Splat(a->center);
+        sat.halfA[0] = _mm_set1_ps(a->halfExtents.x);
+        sat.halfA[1] = _mm_set1_ps(a->halfExtents.y);
+        sat.halfA[2] = _mm_set1_ps(a->halfExtents.z);
+        sat.centerB = Load(batch.center, base);
+        for (int i = 0; i < 3; ++i)
+        {
+            sat.axesA[i] = Splat(a->axes[i]);
+            sat.axesB[i] = Load(batch.axes[i], base);
+            sat.halfB[i] = _mm_loadu_ps(&batch.halfExtents[i][base]);
+        }
+
+        size_t laneCount = end - base;
+        if (laneCount > (size_t)OBBBatch::LANES)
+            laneCount = OBBBatch::LANES;
+
+        if (!RunBlockSAT(sat))
+        {
+            for (size_t lane = 0; lane < laneCount; ++lane)
+                out[base - first + lane] = {nullptr, false, 0.0f, {0.0f, 0.0f, 0.0f}};
+            continue;
+        }
+
+        alignas(16) float penetration[4], nx[4], ny[4], nz[4];
+        _mm_store_ps(penetration, sat.penetration);
+        _mm_store_ps(nx, sat.normal.x);
+        _mm_store_ps(ny, sat.normal.y);
+        _mm_store_ps(nz, sat.normal.z);
+
+        int separatedMask = _mm_movemask_ps(sat.separated);
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            CollisionResult &result = out[base - first + lane];
+            if (separatedMask & (1 << lane))
+            {
+                result = {nullptr, false, 0.0f, {0.0f, 0.0f, 0.0f}};
+                continue;
+            }
+
+            Vector3 normal = {nx[lane], ny[lane], nz[lane]};
+            Vector3 toCenter = {batch.center[0][base + lane] - a->center.x,
+                                batch.center[1][base + lane] - a->center.y,
+                                batch.center[2][base + lane] - a->center.z};
+            if (Vector3DotProduct(toCenter, normal) > 0)
+            {
+                normal = Vector3Negate(normal);
+            }
+            result = {nullptr, true, penetration[lane], normal};
+        }
+    }
+#else
+    CollideRangeScalar(a, batch, first, count, out);
+#endif
+}
@@ -1,19 +1,18 @@
 #include "object.hpp"
 #include "scene.hpp"
 #include "me.hpp"
+#include "bulletProxy.hpp"
 #include <cmath>
 namespace
 {
 Vector3 ClosestPointOnOBB(const OBB &obb, Vector3 point)
 {
-    Vector3 local = Vector3Subtract(point, obb.center);
-    Quaternion invRot = QuaternionInvert(obb.rotation);
-    local = Vector3RotateByQuaternion(local, invRot);
+    Vector3 local = OBB_ToLocal(&obb, Vector3Subtract(point, obb.center));
     Vector3 clamped = {
         Clamp(local.x, -obb.halfExtents.x, obb.halfExtents.x),
         Clamp(local.y, -obb.halfExtents.y, obb.halfExtents.y),
         Clamp(local.z, -obb.halfExtents.z, obb.halfExtents.z)};
-    Vector3 world = Vector3RotateByQuaternion(clamped, obb.rotation);
+    Vector3 world = OBB_ToWorld(&obb, clamped);
     return Vector3Add(world, obb.center);
 }
 
@@ -98,18 +97,33 @@ CollisionResult CollideSphereBox(Object &sphereObj, Object &boxObj, bool sphereF
 }
 }
 
+BulletProxySlot::~BulletProxySlot()
+{
+    BulletProxy::Retire(this->proxy);
+}
+
+void BulletProxySlot::reset(BulletProxy *newProxy)
+{
+    if (newProxy != this->proxy)
+    {
+        BulletProxy::Retire(this->proxy);
+        this->proxy = newProxy;
+    }
+}
+
 void Object::UpdateOBB()
 {
     this->obb.center = this->pos;
     if (this->shape == ObjectShape::Sphere)
     {
         this->obb.halfExtents = {this->sphereRadius, this->sphereRadius, this->sphereRadius};
-        this->obb.rotation = QuaternionIdentity();
+        OBB_SetRotation(&this->obb, QuaternionIdentity());
     }
     else
     {
         this->obb.halfExtents = Vector3Scale(this->size, 0.5f);
-        this->obb.rotation = this->rotation;
+        // Axes are only rebuilt when the rotation actually changed.
+        OBB_SetRotation(&this->obb, this->rotation);
     }
 }
 
@@ -157,22 +171,55 @@ CollisionResult Object::collided(Object &thiso, Object &other)
 }
 
 std::vector<CollisionResult> Object::collided(Object &thiso, Scene *scene)
+{
+    return Object::collided(thiso, scene, thiso.collisionMask);
+}
+
+std::vector<CollisionResult> Object::collided(Object &thiso, Scene *scene, unsigned int mask)
 {
     std::vector<CollisionResult> r;
+    Object::collided(thiso, scene, mask, r);
+    return r;
+}
+
+void Object::collided(Object &thiso, Scene *scene, unsigned int mask, std::vector<CollisionResult> &r)
+{
     thiso.UpdateOBB();
-    for (auto &o : scene->getStaticObjects())
+    bool touchesCollider = false;
+    if (mask & COLLISION_LAYER_WALL)
     {
-        CollisionResult cr = Object::collided(thiso, *o);
-        if (cr.collided)
-            r.push_back(cr);
+        if (thiso.shape == ObjectShape::Box)
+        {
+            // Static objects are all boxes: the BVH tests each nearby leaf four at a time.
+            scene->GetStaticWorld().OverlapOBB(thiso.obb, r, &touchesCollider);
+        }
+        else
+        {
+            scene->GetStaticWorld().OverlapSphere(thiso.pos, thiso.getSphereRadius(), [&](Object *o)
+            {
+                CollisionResult cr = Object::collided(thiso, *o);
+                if (cr.collided)
+                    r.push_back(cr);
+            }, &touchesCollider);
+        }
     }
-    for (auto &e : scene->getEntities())
+    else
     {
-        CollisionResult cr = Object::collided(thiso, e->obj());
-        cr.with = e;
-        if (cr.collided)
-            r.push_back(cr);
+        // Without the wall query there are no BVH bounds to gate Bullet with.
+        touchesCollider = true;
     }
-    scene->CollectDecorationCollisions(thiso, r);
-    return r;
+    if (mask & (COLLISION_LAYER_PLAYER | COLLISION_LAYER_ENEMY | COLLISION_LAYER_PROJECTILE))
+    {
+        scene->QueryCollisionCandidates(OBB_GetBoundingBox(&thiso.obb), [&](Entity *e)
+        {
+            if (!(e->obj().collisionLayer & mask))
+                return;
+            CollisionResult cr = Object::collided(thiso, e->obj());
+            cr.with = e;
+            if (cr.collided)
+                r.push_back(cr);
+        }, mask);
+    }
+    if (touchesCollider && (mask & COLLISION_LAYER_DECORATION))
+        scene->CollectDecorationCollisions(thiso, r);
 }
@@ -1,4 +1,5 @@
 #include "particle.hpp"
+#include "constant.hpp"
 
 ParticleSystem::ParticleSystem() {
     // Pre-allocate memory to avoid lag spikes during gameplay
@@ -24,7 +25,12 @@ void ParticleSystem::init() {
 }
 
 void ParticleSystem::update(float dt) {
-    for (auto& p : particles) {
+    updateRange(dt, 0, particles.size());
+}
+
+void ParticleSystem::updateRange(float dt, size_t first, size_t end) {
+    for (size_t i = first; i < end; ++i) {
+        Particle& p = particles[i];
         if (!p.active) continue;
 
         // 1. Movement
@@ -34,7 +40,7 @@ void ParticleSystem::update(float dt) {
         p.velocity.y -= p.gravity * dt; 
 
         // 3. Drag/Friction (Slow down over time)
-        p.velocity = Vector3Scale(p.velocity, 0.95f);
+        p.velocity = Vector3Scale(p.velocity, powf(0.95f, dt * PHYSICS_REFERENCE_HZ));
 
         // 4. Aging
         p.life -= dt;
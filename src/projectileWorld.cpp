@@ -0,0 +1,513 @@
+#include "projectileWorld.hpp"
+#include <algorithm>
+#include <cmath>
+#include <raymath.h>
+#include "jobSystem.hpp"
+#include "me.hpp"
+#include "scene.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PROJECTILES_USE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    void EmitBurst(ParticleSystem &particles, const ProjectileBurst &burst, const Vector3 &position)
+    {
+        if (burst.count > 0)
+        {
+            particles.spawnExplosion(position, burst.count, burst.color, burst.size, burst.speed, burst.spread);
+        }
+    }
+
+    // Slide the kept runs of one column down over the removed entries
+    template <typename T>
+    void CompactColumn(std::vector<T> &column, const std::vector<std::pair<size_t, size_t>> &keptRuns, size_t write)
+    {
+        for (const auto &run : keptRuns)
+        {
+            std::move(column.begin() + run.first, column.begin() + run.second, column.begin() + write);
+            write += run.second - run.first;
+        }
+        column.resize(write);
+    }
+}
+
+ProjectileKindId ProjectileWorld::RegisterKind(const ProjectileKind &kind)
+{
+    this->kinds.push_back(kind);
+    this->steering = this->steering || kind.homingBlend > 0.0f || kind.wiggleAmplitude != 0.0f;
+    return (ProjectileKindId)this->kinds.size() - 1;
+}
+
+template <typename Fn>
+void ProjectileWorld::ForEachFloatColumn(Fn &&fn)
+{
+    std::vector<float> *columns[] = {
+        &this->posX, &this->posY, &this->posZ,
+        &this->prevX, &this->prevY, &this->prevZ,
+        &this->velX, &this->velY, &this->velZ,
+        &this->wiggleX, &this->wiggleY, &this->wiggleZ,
+        &this->gravity, &this->life, &this->damage, &this->phase};
+    for (std::vector<float> *column : columns)
+    {
+        fn(*column);
+    }
+}
+
+void ProjectileWorld::Spawn(ProjectileKindId kindId, const ProjectileSpawn &spawn)
+{
+    if (kindId < 0 || kindId >= (ProjectileKindId)this->kinds.size())
+        return;
+    const ProjectileKind &k = this->kinds[kindId];
+
+    Vector3 axis = {0.0f, 1.0f, 0.0f};
+    if (!k.wiggleVertical)
+    {
+        axis = Vector3CrossProduct(spawn.velocity, {0.0f, 1.0f, 0.0f});
+        axis = Vector3LengthSqr(axis) < 1e-4f ? Vector3{1.0f, 0.0f, 0.0f} : Vector3Normalize(axis);
+    }
+
+    this->posX.push_back(spawn.position.x);
+    this->posY.push_back(spawn.position.y);
+    this->posZ.push_back(spawn.position.z);
+    this->prevX.push_back(spawn.position.x);
+    this->prevY.push_back(spawn.position.y);
+    this->prevZ.push_back(spawn.position.z);
+    this->velX.push_back(spawn.velocity.x);
+    this->velY.push_back(spawn.velocity.y);
+    this->velZ.push_back(spawn.velocity.z);
+    this->wiggleX.push_back(0.0f);
+    this->wiggleY.push_back(0.0f);
+    this->wiggleZ.push_back(0.0f);
+    this->gravity.push_back(k.gravity);
+    this->life.push_back(k.lifetime);
+    this->damage.push_back(spawn.damage);
+    this->phase.push_back(0.0f);
+
+    this->kind.push_back(kindId);
+    this->wiggleAxis.push_back(axis);
+    this->owner.push_back(spawn.owner);
+    this->target.push_back(spawn.target);
+    bool hasRegion = spawn.sourceRect.width > 0.0f && spawn.sourceRect.height > 0.0f;
+    this->sourceRect.push_back(hasRegion ? spawn.sourceRect : k.sourceRect);
+}
+
+void ProjectileWorld::Reserve(size_t count)
+{
+    this->ForEachFloatColumn([count](std::vector<float> &column) { column.reserve(count); });
+    this->kind.reserve(count);
+    this->wiggleAxis.reserve(count);
+    this->owner.reserve(count);
+    this->target.reserve(count);
+    this->sourceRect.reserve(count);
+    this->hitType.reserve(count);
+    this->hitFraction.reserve(count);
+    this->hitEntity.reserve(count);
+    this->removed.reserve(count);
+    this->keptRuns.reserve(count / 2 + 1);
+    this->hazard.reserve((size_t)MAX_HAZARD_CELLS * MAX_HAZARD_CELLS);
+}
+
+Vector3 ProjectileWorld::RenderPosition(size_t i, float alpha) const
+{
+    return {
+        this->prevX[i] + (this->posX[i] - this->prevX[i]) * alpha,
+        this->prevY[i] + (this->posY[i] - this->prevY[i]) * alpha,
+        this->prevZ[i] + (this->posZ[i] - this->prevZ[i]) * alpha};
+}
+
+void ProjectileWorld::Update(UpdateContext &uc)
+{
+    if (!uc.scene || this->posX.empty())
+        return;
+
+    float delta = uc.deltaTime;
+    this->Steer(uc, delta);
+    this->Integrate(delta);
+
+    // Hooks may spawn more projectiles while resolving; those wait for the next tick
+    size_t count = this->posX.size();
+    this->hitType.assign(count, HIT_NONE);
+    this->hitFraction.assign(count, 1.0f);
+    this->hitEntity.assign(count, nullptr);
+    this->BuildHazardGrid(uc, count);
+    uc.jobs->ParallelFor("projectile collide", count, COLLISION_GRAIN, [&](size_t first, size_t end)
+    {
+        this->Collide(uc, first, end);
+    });
+
+    this->Resolve(uc, count);
+    this->Compact();
+}
+
+void ProjectileWorld::Steer(UpdateContext &uc, float delta)
+{
+    if (!this->steering)
+        return;
+
+    EnemyManager &em = uc.scene->em;
+    for (size_t i = 0; i < this->posX.size(); ++i)
+    {
+        const ProjectileKind &k = this->kinds[this->kind[i]];
+
+        if (k.homingBlend > 0.0f)
+        {
+            Vector3 pos = {this->posX[i], this->posY[i], this->posZ[i]};
+            Enemy *goal = em.Get(this->target[i]);
+            if (!goal)
+            {
+                goal = em.QueryNearest(pos, k.homingRange);
+                this->target[i] = goal ? goal->getHandle() : EntityHandle{};
+            }
+
+            Vector3 vel = {this->velX[i], this->velY[i], this->velZ[i]};
+            float speed = Vector3Length(vel);
+            Vector3 toGoal = goal ? Vector3Subtract(goal->pos(), pos) : Vector3Zero();
+            if (speed > 1e-4f && Vector3LengthSqr(toGoal) > 1e-6f)
+            {
+                Vector3 heading = Vector3Lerp(Vector3Scale(vel, 1.0f / speed), Vector3Normalize(toGoal), k.homingBlend);
+                if (Vector3LengthSqr(heading) > 1e-6f)
+                {
+                    vel = Vector3Scale(Vector3Normalize(heading), speed);
+                    this->velX[i] = vel.x;
+                    this->velY[i] = vel.y;
+                    this->velZ[i] = vel.z;
+                }
+            }
+        }
+
+        if (k.wiggleAmplitude != 0.0f)
+        {
+            this->phase[i] += k.wiggleFrequency * delta;
+            float offset = sinf(this->phase[i]) * k.wiggleAmplitude;
+            this->wiggleX[i] = this->wiggleAxis[i].x * offset;
+            this->wiggleY[i] = this->wiggleAxis[i].y * offset;
+            this->wiggleZ[i] = this->wiggleAxis[i].z * offset;
+        }
+    }
+}
+
+void ProjectileWorld::Integrate(float delta)
+{
+    size_t count = this->posX.size();
+    size_t i = 0;
+
+#ifdef PROJECTILES_USE_SSE
+    const __m128 dt = _mm_set1_ps(delta);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 px = _mm_loadu_ps(&this->posX[i]);
+        __m128 py = _mm_loadu_ps(&this->posY[i]);
+        __m128 pz = _mm_loadu_ps(&this->posZ[i]);
+        _mm_storeu_ps(&this->prevX[i], px);
+        _mm_storeu_ps(&this->prevY[i], py);
+        _mm_storeu_ps(&this->prevZ[i], pz);
+
+        __m128 vx = _mm_loadu_ps(&this->velX[i]);
+        __m128 vy = _mm_sub_ps(_mm_loadu_ps(&this->velY[i]), _mm_mul_ps(_mm_loadu_ps(&this->gravity[i]), dt));
+        __m128 vz = _mm_loadu_ps(&this->velZ[i]);
+        _mm_storeu_ps(&this->velY[i], vy);
+
+        px = _mm_add_ps(px, _mm_mul_ps(_mm_add_ps(vx, _mm_loadu_ps(&this->wiggleX[i])), dt));
+        py = _mm_add_ps(py, _mm_mul_ps(_mm_add_ps(vy, _mm_loadu_ps(&this->wiggleY[i])), dt));
+        pz = _mm_add_ps(pz, _mm_mul_ps(_mm_add_ps(vz, _mm_loadu_ps(&this->wiggleZ[i])), dt));
+        _mm_storeu_ps(&this->posX[i], px);
+        _mm_storeu_ps(&this->posY[i], py);
+        _mm_storeu_ps(&this->posZ[i], pz);
+
+        _mm_storeu_ps(&this->life[i], _mm_sub_ps(_mm_loadu_ps(&this->life[i]), dt));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        this->prevX[i] = this->posX[i];
+        this->prevY[i] = this->posY[i];
+        this->prevZ[i] = this->posZ[i];
+        this->velY[i] -= this->gravity[i] * delta;
+        this->posX[i] += (this->velX[i] + this->wiggleX[i]) * delta;
+        this->posY[i] += (this->velY[i] + this->wiggleY[i]) * delta;
+        this->posZ[i] += (this->velZ[i] + this->wiggleZ[i]) * delta;
+        this->life[i] -= delta;
+    }
+}
+
+void ProjectileWorld::BuildHazardGrid(UpdateContext &uc, size_t count)
+{
+    // Cover every start position, and find how far any projectile can reach from its start this tick
+    float minX = INFINITY, minZ = INFINITY, maxX = -INFINITY, maxZ = -INFINITY;
+    float maxMotionSqr = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        minX = std::min(minX, this->prevX[i]);
+        maxX = std::max(maxX, this->prevX[i]);
+        minZ = std::min(minZ, this->prevZ[i]);
+        maxZ = std::max(maxZ, this->prevZ[i]);
+        float dx = this->posX[i] - this->prevX[i];
+        float dy = this->posY[i] - this->prevY[i];
+        float dz = this->posZ[i] - this->prevZ[i];
+        maxMotionSqr = std::max(maxMotionSqr, dx * dx + dy * dy + dz * dz);
+    }
+    float maxRadius = 0.0f;
+    for (const ProjectileKind &k : this->kinds)
+        maxRadius = fmaxf(maxRadius, k.radius);
+    // Walls grow by the radius along their own axes, up to sqrt(3) times it in world space
+    float reach = sqrtf(maxMotionSqr) + maxRadius * 1.7320508f;
+
+    // Cells sit on a lattice of the snapped cell size so the wall layer lines up from tick to tick.
+    // The extra cell of margin keeps the far edge inside the grid.
+    const StaticWorldBVH &world = uc.scene->GetStaticWorld();
+    HazardLayout &layout = this->hazardLayout;
+    float cellSize = fmaxf(HAZARD_CELL_SIZE, fmaxf(maxX - minX, maxZ - minZ) / (MAX_HAZARD_CELLS - 2));
+    layout.cellSize = ceilf(cellSize / HAZARD_SNAP) * HAZARD_SNAP;
+    layout.originX = floorf(minX / layout.cellSize) * layout.cellSize;
+    layout.originZ = floorf(minZ / layout.cellSize) * layout.cellSize;
+    layout.reach = ceilf(reach / HAZARD_SNAP) * HAZARD_SNAP;
+    layout.columns = std::min((int)((maxX - layout.originX) / layout.cellSize) + 1, MAX_HAZARD_CELLS);
+    layout.rows = std::min((int)((maxZ - layout.originZ) / layout.cellSize) + 1, MAX_HAZARD_CELLS);
+    layout.wallRevision = world.GetRevision();
+
+    HazardLayout &kept = this->staticHazardLayout;
+    int column0 = (int)lroundf((layout.originX - kept.originX) / layout.cellSize);
+    int row0 = (int)lroundf((layout.originZ - kept.originZ) / layout.cellSize);
+    bool reuse = kept.cellSize == layout.cellSize && kept.reach == layout.reach && kept.wallRevision == layout.wallRevision &&
+                 column0 >= 0 && row0 >= 0 && column0 + layout.columns <= kept.columns && row0 + layout.rows <= kept.rows;
+    if (!reuse)
+    {
+        kept = layout;
+        kept.originX -= HAZARD_PADDING * layout.cellSize;
+        kept.originZ -= HAZARD_PADDING * layout.cellSize;
+        kept.columns += 2 * HAZARD_PADDING;
+        kept.rows += 2 * HAZARD_PADDING;
+        this->staticHazard.assign((size_t)kept.columns * kept.rows, 0);
+        for (int r = 0; r < kept.rows; ++r)
+        {
+            for (int c = 0; c < kept.columns; ++c)
+            {
+                float x = kept.originX + c * kept.cellSize;
+                float z = kept.originZ + r * kept.cellSize;
+                BoundingBox area = {{x - kept.reach, 0.0f, z - kept.reach},
+                                    {x + kept.cellSize + kept.reach, 0.0f, z + kept.cellSize + kept.reach}};
+                this->staticHazard[(size_t)r * kept.columns + c] = world.MayTouch(area) ? NEAR_STATIC : 0;
+            }
+        }
+        column0 = HAZARD_PADDING;
+        row0 = HAZARD_PADDING;
+    }
+
+    this->hazard.resize((size_t)layout.columns * layout.rows);
+    for (int r = 0; r < layout.rows; ++r)
+    {
+        const unsigned char *from = &this->staticHazard[(size_t)(row0 + r) * kept.columns + column0];
+        std::copy(from, from + layout.columns, &this->hazard[(size_t)r * layout.columns]);
+    }
+
+    // Bodies move every tick anyway, so they use the exact reach
+    auto mark = [&](const BoundingBox &body, unsigned char flag)
+    {
+        int c0 = std::max((int)floorf((body.min.x - reach - layout.originX) / layout.cellSize), 0);
+        int c1 = std::min((int)floorf((body.max.x + reach - layout.originX) / layout.cellSize), layout.columns - 1);
+        int r0 = std::max((int)floorf((body.min.z - reach - layout.originZ) / layout.cellSize), 0);
+        int r1 = std::min((int)floorf((body.max.z + reach - layout.originZ) / layout.cellSize), layout.rows - 1);
+        for (int r = r0; r <= r1; ++r)
+        {
+            for (int c = c0; c <= c1; ++c)
+                this->hazard[(size_t)r * layout.columns + c] |= flag;
+        }
+    };
+    for (Enemy *e : uc.scene->em.viewEnemies())
+        mark(OBB_GetBoundingBox(&e->obj().obb), NEAR_ENEMY);
+    if (uc.player)
+        mark(OBB_GetBoundingBox(&uc.player->obj().obb), NEAR_PLAYER);
+}
+
+unsigned char ProjectileWorld::HazardAt(size_t i) const
+{
+    const HazardLayout &layout = this->hazardLayout;
+    int c = (int)((this->prevX[i] - layout.originX) / layout.cellSize);
+    int r = (int)((this->prevZ[i] - layout.originZ) / layout.cellSize);
+    c = std::min(c, layout.columns - 1); // Rounding can push the furthest start one cell out
+    r = std::min(r, layout.rows - 1);
+    return this->hazard[(size_t)r * layout.columns + c];
+}
+
+void ProjectileWorld::Collide(UpdateContext &uc, size_t first, size_t end)
+{
+    Scene &scene = *uc.scene;
+    for (size_t i = first; i < end; ++i)
+    {
+        const ProjectileKind &k = this->kinds[this->kind[i]];
+        Vector3 start = {this->prevX[i], this->prevY[i], this->prevZ[i]};
+        Vector3 stop = {this->posX[i], this->posY[i], this->posZ[i]};
+        Vector3 motion = Vector3Subtract(stop, start);
+
+        unsigned char type = HIT_NONE;
+        float fraction = 1.0f;
+        Entity *with = nullptr;
+
+        unsigned char nearby = this->HazardAt(i);
+        if ((k.collidesWith & (COLLISION_MASK_STATIC | COLLISION_LAYER_ENEMY)) && (nearby & (NEAR_STATIC | NEAR_ENEMY)))
+        {
+            const Entity *ignore = scene.em.Get(this->owner[i]);
+            bool enemies = (k.collidesWith & COLLISION_LAYER_ENEMY) && (nearby & NEAR_ENEMY);
+            SweepHit hit = scene.SweepSphere(start, motion, k.radius, ignore, enemies);
+            if (hit.hit)
+            {
+                fraction = hit.fraction;
+                with = hit.with;
+                type = (with && (k.damages & COLLISION_LAYER_ENEMY)) ? HIT_TARGET : HIT_BLOCKED;
+            }
+        }
+
+        if ((k.collidesWith & COLLISION_LAYER_PLAYER) && (nearby & NEAR_PLAYER))
+        {
+            const OBB *body = &uc.player->obj().obb;
+            float playerFraction = 1.0f;
+            Vector3 normal;
+            bool touched = SweepCenterVsOBB(start, motion, {k.radius, k.radius, k.radius}, body, &playerFraction, &normal);
+            if (touched && (type == HIT_NONE || playerFraction < fraction))
+            {
+                fraction = playerFraction;
+                with = uc.player;
+                type = (k.damages & COLLISION_LAYER_PLAYER) ? HIT_TARGET : HIT_BLOCKED;
+            }
+        }
+
+        if (k.hitsGround && stop.y <= k.groundHeight)
+        {
+            float drop = start.y - stop.y;
+            float groundFraction = (drop > 1e-6f) ? Clamp((start.y - k.groundHeight) / drop, 0.0f, 1.0f) : 0.0f;
+            if (type == HIT_NONE || groundFraction < fraction)
+            {
+                fraction = groundFraction;
+                with = nullptr;
+                type = HIT_GROUND;
+            }
+        }
+
+        this->hitType[i] = type;
+        this->hitFraction[i] = fraction;
+        this->hitEntity[i] = with;
+    }
+}
+
+void ProjectileWorld::Resolve(UpdateContext &uc, size_t count)
+{
+    Scene &scene = *uc.scene;
+    this->removed.assign(count, 0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        unsigned char type = this->hitType[i];
+        if (type == HIT_NONE && this->life[i] > 0.0f)
+            continue;
+        this->removed[i] = 1;
+
+        // Copied out: the hook below may spawn and grow the columns
+        const ProjectileKind k = this->kinds[this->kind[i]];
+        ProjectileImpact impact;
+        impact.kind = this->kind[i];
+        impact.velocity = {this->velX[i], this->velY[i], this->velZ[i]};
+        impact.damage = this->damage[i];
+        impact.owner = this->owner[i];
+        impact.hit = this->hitEntity[i];
+        Vector3 start = {this->prevX[i], this->prevY[i], this->prevZ[i]};
+        Vector3 stop = {this->posX[i], this->posY[i], this->posZ[i]};
+        impact.position = Vector3Lerp(start, stop, this->hitFraction[i]);
+
+        switch (type)
+        {
+        case HIT_TARGET:
+        {
+            impact.reason = ProjectileImpact::Reason::Hit;
+            if (impact.hit && impact.hit->category() == ENTITY_PLAYER)
+            {
+                Me *player = static_cast<Me *>(impact.hit);
+                Vector3 pushDir = Vector3LengthSqr(impact.velocity) > 1e-4f ? Vector3Normalize(impact.velocity) : Vector3{0.0f, 0.0f, 1.0f};
+                CollisionResult contact{player, true, 0.0f, Vector3Negate(pushDir)};
+                DamageResult hit(impact.damage, contact);
+                player->damage(hit);
+                if (k.knockbackDuration > 0.0f)
+                {
+                    player->applyKnockback(Vector3Scale(pushDir, k.knockbackSpeed), k.knockbackDuration, 0.0f);
+                }
+            }
+            else if (impact.hit)
+            {
+                Enemy *enemy = static_cast<Enemy *>(impact.hit);
+                scene.events.Damage(enemy, impact.damage);
+                if (k.knockbackDuration > 0.0f)
+                {
+                    Vector3 away = Vector3Subtract(enemy->pos(), impact.position);
+                    Vector3 pushDir = Vector3LengthSqr(away) > 1e-6f ? Vector3Normalize(away) : Vector3Zero();
+                    scene.events.Knockback(enemy, Vector3Scale(pushDir, k.knockbackSpeed), k.knockbackDuration, 0.0f);
+                }
+            }
+            EmitBurst(scene.particles, k.hitBurst, impact.position);
+            break;
+        }
+        case HIT_BLOCKED:
+            impact.reason = ProjectileImpact::Reason::Blocked;
+            EmitBurst(scene.particles, k.stopBurst, impact.position);
+            break;
+        case HIT_GROUND:
+            impact.reason = ProjectileImpact::Reason::Ground;
+            EmitBurst(scene.particles, k.stopBurst, impact.position);
+            break;
+        default:
+            impact.reason = ProjectileImpact::Reason::Expired;
+            impact.position = stop;
+            break;
+        }
+
+        if (k.onImpact)
+        {
+            k.onImpact(k.user, impact, uc);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const ProjectileBurst &trail = this->kinds[this->kind[i]].trail;
+        if (!this->removed[i] && trail.count > 0)
+        {
+            EmitBurst(scene.particles, trail, {this->posX[i], this->posY[i], this->posZ[i]});
+        }
+    }
+}
+
+void ProjectileWorld::Compact()
+{
+    // Stable, so projectiles keep their spawn order; anything spawned by a hook is past `removed` and kept.
+    // Removals are few, so each column is moved as a handful of contiguous runs.
+    size_t total = this->posX.size();
+    size_t first = 0;
+    while (first < this->removed.size() && !this->removed[first])
+        ++first;
+    if (first == this->removed.size())
+        return;
+
+    this->keptRuns.clear();
+    for (size_t read = first; read < total;)
+    {
+        if (read < this->removed.size() && this->removed[read])
+        {
+            ++read;
+            continue;
+        }
+        size_t end = read + 1;
+        while (end < total && !(end < this->removed.size() && this->removed[end]))
+            ++end;
+        this->keptRuns.push_back({read, end});
+        read = end;
+    }
+
+    this->ForEachFloatColumn([&](std::vector<float> &column) { CompactColumn(column, this->keptRuns, first); });
+    CompactColumn(this->kind, this->keptRuns, first);
+    CompactColumn(this->wiggleAxis, this->keptRuns, first);
+    CompactColumn(this->owner, this->keptRuns, first);
+    CompactColumn(this->target, this->keptRuns, first);
+    CompactColumn(this->sourceRect, this->keptRuns, first);
+}
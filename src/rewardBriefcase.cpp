@@ -41,7 +41,7 @@ RewardBriefcase::~RewardBriefcase()
 
 void RewardBriefcase::Update(UpdateContext &uc)
 {
-    float delta = GetFrameTime();
+    float delta = uc.deltaTime;
     this->bobTimer += delta * 2.0f;
 }
 
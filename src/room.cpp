@@ -137,9 +137,31 @@ void Door::DisableCollision()
         this->bulletWorld->removeCollisionObject(object);
     }
     this->collisionEnabled = false;
+    ++this->collisionRevision;
+}
+
+void Door::EnableCollision()
+{
+    if (this->collisionEnabled || !this->bulletWorld || !this->collider)
+    {
+        return;
+    }
+
+    if (btCollisionObject *object = this->collider->GetBulletObject())
+    {
+        this->bulletWorld->addCollisionObject(object, COLLISION_LAYER_DECORATION, COLLISION_MASK_ALL);
+        this->collisionEnabled = true;
+        ++this->collisionRevision;
+    }
 }
 
 void Door::Update(float deltaSeconds)
+{
+    this->Animate(deltaSeconds);
+    this->SyncCollision();
+}
+
+void Door::Animate(float deltaSeconds)
 {
     if (!this->opening || this->openComplete)
     {
@@ -168,6 +190,13 @@ void Door::Update(float deltaSeconds)
     if (this->openProgress >= 1.0f)
     {
         this->openComplete = true;
+    }
+}
+
+void Door::SyncCollision()
+{
+    if (this->openComplete)
+    {
         this->DisableCollision();
     }
 }
@@ -205,16 +234,8 @@ void Door::Close()
     {
         this->rightLeaf.currentAngleDeg = 0.0f;
     }
-    
-    // Re-enable collision
-    if (!this->collisionEnabled && this->bulletWorld && this->collider)
-    {
-        if (btCollisionObject *object = this->collider->GetBulletObject())
-        {
-            this->bulletWorld->addCollisionObject(object);
-            this->collisionEnabled = true;
-        }
-    }
+
+    this->EnableCollision();
 }
 
 bool Door::IsPlayerNearby(const Vector3 &playerPos, float maxDistance) const
@@ -309,55 +330,49 @@ void Room::AttachDoor(Door *door)
     }
 }
 
-void Room::Update(const std::vector<Entity *> &enemies)
+bool Room::Update()
 {
-    if (this->type == RoomType::Start || this->completed)
-    {
-        return;
-    }
-
-    bool hasEnemy = false;
-    for (Entity *entity : enemies)
+    if (this->type == RoomType::Start || this->completed || !this->awake)
     {
-        if (!entity || entity->category() != ENTITY_ENEMY)
-        {
-            continue;
-        }
-        if (this->ContainsEnemy(entity))
-        {
-            hasEnemy = true;
-            this->hadEnemies = true;
-            break;
-        }
+        return false;
     }
 
-    if (!hasEnemy && this->hadEnemies)
+    if (this->enemyCount == 0 && this->hadEnemies)
     {
         this->completed = true;
         this->TryOpenDoors();
+        return true;
     }
+    return false;
 }
 
-bool Room::ContainsEnemy(const Entity *entity) const
+void Room::UpdateActivity(bool playerInside)
 {
-    if (!entity)
+    this->awake = playerInside || this->keepAwake;
+    this->keepAwake = false;
+}
+
+void Room::OnEnemyAdded()
+{
+    ++this->enemyCount;
+    this->hadEnemies = true;
+}
+
+void Room::OnEnemyRemoved()
+{
+    if (this->enemyCount > 0)
     {
-        return false;
+        --this->enemyCount;
     }
+}
 
-    const Vector3 pos = entity->obj().getPos();
+bool Room::Contains(const Vector3 &pos) const
+{
     return pos.x >= this->bounds.min.x && pos.x <= this->bounds.max.x &&
            pos.y >= this->bounds.min.y && pos.y <= this->bounds.max.y &&
            pos.z >= this->bounds.min.z && pos.z <= this->bounds.max.z;
 }
 
-bool Room::IsPlayerInside(const Vector3 &playerPos) const
-{
-    return playerPos.x >= this->bounds.min.x && playerPos.x <= this->bounds.max.x &&
-           playerPos.y >= this->bounds.min.y && playerPos.y <= this->bounds.max.y &&
-           playerPos.z >= this->bounds.min.z && playerPos.z <= this->bounds.max.z;
-}
-
 void Room::TryOpenDoors()
 {
     for (Door *door : this->doors)
@@ -0,0 +1,105 @@
+#include "roomGrid.hpp"
+#include "room.hpp"
+#include <algorithm>
+#include <cmath>
+
+RoomGrid::RoomGrid(float cellSize)
+    : cellSize(cellSize), invCellSize(1.0f / cellSize)
+{
+}
+
+void RoomGrid::Clear()
+{
+    this->columns = 0;
+    this->rows = 0;
+    this->cellStart.clear();
+    this->cellRooms.clear();
+}
+
+bool RoomGrid::CellOf(float x, float z, int &outColumn, int &outRow) const
+{
+    outColumn = (int)floorf((x - this->originX) * this->invCellSize);
+    outRow = (int)floorf((z - this->originZ) * this->invCellSize);
+    return outColumn >= 0 && outColumn < this->columns && outRow >= 0 && outRow < this->rows;
+}
+
+void RoomGrid::Build(const std::vector<std::unique_ptr<Room>> &rooms)
+{
+    this->Clear();
+
+    bool any = false;
+    float minX = 0.0f, minZ = 0.0f, maxX = 0.0f, maxZ = 0.0f;
+    for (const auto &room : rooms)
+    {
+        if (!room)
+            continue;
+        const BoundingBox &b = room->GetBounds();
+        minX = any ? std::min(minX, b.min.x) : b.min.x;
+        minZ = any ? std::min(minZ, b.min.z) : b.min.z;
+        maxX = any ? std::max(maxX, b.max.x) : b.max.x;
+        maxZ = any ? std::max(maxZ, b.max.z) : b.max.z;
+        any = true;
+    }
+    if (!any)
+        return;
+
+    this->originX = minX;
+    this->originZ = minZ;
+    this->columns = (int)floorf((maxX - minX) * this->invCellSize) + 1;
+    this->rows = (int)floorf((maxZ - minZ) * this->invCellSize) + 1;
+    const size_t cellCount = (size_t)this->columns * (size_t)this->rows;
+
+    // Two passes over the rooms: count per cell, then fill in room order
+    auto forEachCell = [&](const Room &room, auto &&fn)
+    {
+        const BoundingBox &b = room.GetBounds();
+        int c0, r0, c1, r1;
+        this->CellOf(b.min.x, b.min.z, c0, r0);
+        this->CellOf(b.max.x, b.max.z, c1, r1);
+        c1 = std::min(c1, this->columns - 1);
+        r1 = std::min(r1, this->rows - 1);
+        for (int r = r0; r <= r1; ++r)
+        {
+            for (int c = c0; c <= c1; ++c)
+            {
+                fn((size_t)r * this->columns + c);
+            }
+        }
+    };
+
+    this->cellStart.assign(cellCount + 1, 0);
+    for (const auto &room : rooms)
+    {
+        if (room)
+            forEachCell(*room, [&](size_t cell) { ++this->cellStart[cell + 1]; });
+    }
+    for (size_t i = 0; i < cellCount; ++i)
+    {
+        this->cellStart[i + 1] += this->cellStart[i];
+    }
+
+    this->cellRooms.assign(this->cellStart[cellCount], nullptr);
+    std::vector<unsigned int> cursor(this->cellStart.begin(), this->cellStart.end() - 1);
+    for (const auto &room : rooms)
+    {
+        if (room)
+            forEachCell(*room, [&](size_t cell) { this->cellRooms[cursor[cell]++] = room.get(); });
+    }
+}
+
+Room *RoomGrid::Find(const Vector3 &pos) const
+{
+    int column, row;
+    if (!this->CellOf(pos.x, pos.z, column, row))
+        return nullptr;
+
+    size_t cell = (size_t)row * this->columns + column;
+    for (unsigned int i = this->cellStart[cell]; i < this->cellStart[cell + 1]; ++i)
+    {
+        if (this->cellRooms[i]->Contains(pos))
+        {
+            return this->cellRooms[i];
+        }
+    }
+    return nullptr;
+}
@@ -14,6 +14,7 @@
 #include <cfloat>
 #include <string>
 #include "Inventory.hpp"
+#include "jobSystem.hpp"
 
 namespace
 {
@@ -22,6 +23,15 @@ namespace
     constexpr float doorOpenDuration = 1.35f;
     constexpr float doorTargetHeight = 18.0f;
     constexpr float boundingAxisEpsilon = 0.0001f;
+    constexpr int maxSlideIterations = 4;
+    constexpr float slideSkin = 0.01f;
+
+    // Remove the part of `v` that points into a plane with normal `n`.
+    Vector3 ClipAgainstPlane(Vector3 v, Vector3 n)
+    {
+        float into = Vector3DotProduct(v, n);
+        return (into < 0.0f) ? Vector3Subtract(v, Vector3Scale(n, into)) : v;
+    }
 
     float RandomRange(float minValue, float maxValue)
     {
@@ -150,6 +160,7 @@ Scene::~Scene()
     this->RemoveDecorationColliders();
     this->decorations.clear();
     this->doors.clear();
+    this->roomGrid.Clear();
     this->rooms.clear();
 
     // Unload shared briefcase model
@@ -177,6 +188,11 @@ Scene::~Scene()
             UnloadTexture(this->glowTexture);
             this->glowTexture.id = 0;
         }
+        if (this->enemyBulletTexture.id != 0)
+        {
+            UnloadTexture(this->enemyBulletTexture);
+            this->enemyBulletTexture.id = 0;
+        }
     }
     this->damageIndicators.Clear();
     this->ShutdownBulletWorld();
@@ -192,6 +208,7 @@ void Scene::InitializeBulletWorld()
     this->bulletDispatcher = std::make_unique<btCollisionDispatcher>(this->bulletConfig.get());
     this->bulletBroadphase = std::make_unique<btDbvtBroadphase>();
     this->bulletWorld = std::make_unique<btCollisionWorld>(this->bulletDispatcher.get(), this->bulletBroadphase.get(), this->bulletConfig.get());
+    this->entityProxies.Attach(this->bulletWorld.get());
 }
 
 void Scene::ShutdownBulletWorld()
@@ -200,6 +217,7 @@ void Scene::ShutdownBulletWorld()
     {
         return;
     }
+    this->entityProxies.Detach();
     this->RemoveDecorationColliders();
     this->bulletWorld.reset();
     this->bulletBroadphase.reset();
@@ -252,6 +270,8 @@ namespace
         explicit DecorationContactCallback(std::vector<CollisionResult> &results) : hits(results)
         {
             this->m_closestDistanceThreshold = 0.0f;
+            // Skip entity ghosts; only decorations and doors count.
+            this->m_collisionFilterMask = COLLISION_LAYER_DECORATION;
         }
 
         btScalar addSingleResult(btManifoldPoint &cp,
@@ -289,6 +309,18 @@ void Scene::AppendDecorationCollisions(const Object &obj, std::vector<CollisionR
         return;
     }
 
+    if (BulletProxy *proxy = this->entityProxies.Bind(obj))
+    {
+        if (!proxy->MatchesShape(obj))
+        {
+            proxy->SetShape(Scene::CreateShapeFromObject(obj), obj);
+        }
+        proxy->SetTransform(Scene::BuildBtTransform(obj));
+        proxy->AppendContacts(out);
+        return;
+    }
+
+    // Objects without a persistent proxy (one-off probes) fall back to a temporary shape.
     std::unique_ptr<btCollisionShape> tempShape(Scene::CreateShapeFromObject(obj));
     if (!tempShape)
     {
@@ -327,9 +359,13 @@ bool Scene::CheckDecorationSweep(const Vector3 &start, const Vector3 &end, float
     to.setOrigin(btVector3(end.x, end.y, end.z));
 
     btCollisionWorld::ClosestConvexResultCallback callback(from.getOrigin(), to.getOrigin());
-    callback.m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
-    callback.m_collisionFilterMask = btBroadphaseProxy::AllFilter;
-    this->bulletWorld->convexSweepTest(&sphere, from, to, callback);
+    callback.m_collisionFilterGroup = COLLISION_MASK_ALL;
+    callback.m_collisionFilterMask = COLLISION_LAYER_DECORATION;
+    {
+        // Called from Enemy::Think() on worker threads
+        std::lock_guard<std::mutex> lock(this->bulletQueryMutex);
+        this->bulletWorld->convexSweepTest(&sphere, from, to, callback);
+    }
     if (!callback.hasHit())
     {
         return false;
@@ -351,6 +387,176 @@ bool Scene::CheckDecorationSweep(const Vector3 &start, const Vector3 &end, float
     return true;
 }
 
+bool Scene::CheckStaticSweep(const Vector3 &start, const Vector3 &end, float radius, float ignoreDistance) const
+{
+    bool touchesCollider = false;
+    if (this->staticWorld.SweepSphere(start, end, radius, ignoreDistance, &touchesCollider))
+    {
+        return true;
+    }
+    return touchesCollider && this->CheckDecorationSweep(start, end, radius);
+}
+
+bool Scene::CheckStaticSweepCached(const Vector3 &start, const Vector3 &end, float radius, float ignoreDistance) const
+{
+    return this->lineOfSight.IsBlocked(start, end, radius, ignoreDistance,
+                                       [&] { return this->CheckStaticSweep(start, end, radius, ignoreDistance); });
+}
+
+SweepHit Scene::SweepSphere(Vector3 start, Vector3 delta, float radius, const Entity *ignore, bool includeEnemies)
+{
+    return this->Sweep(start, delta, nullptr, radius, ignore, includeEnemies);
+}
+
+SweepHit Scene::SweepOBB(const OBB &box, Vector3 delta, const Entity *ignore, bool includeEnemies)
+{
+    return this->Sweep(box.center, delta, &box, Vector3Length(box.halfExtents), ignore, includeEnemies);
+}
+
+SweepHit Scene::Sweep(Vector3 start, Vector3 delta, const OBB *box, float radius, const Entity *ignore, bool includeEnemies)
+{
+    bool touchesCollider = false;
+    SweepHit closest = box ? this->staticWorld.CastOBB(*box, delta, &touchesCollider)
+                           : this->staticWorld.CastSphere(start, delta, radius, &touchesCollider);
+    if (touchesCollider)
+    {
+        this->SweepDecorations(start, delta, box, radius, closest);
+    }
+
+    if (includeEnemies)
+    {
+        // Bounds of the whole motion so the grid returns everything along the path.
+        Vector3 end = Vector3Add(start, delta);
+        Vector3 reach = {radius, radius, radius};
+        BoundingBox swept = {Vector3Subtract(Vector3Min(start, end), reach), Vector3Add(Vector3Max(start, end), reach)};
+        this->em.QueryCandidates(swept, [&](Entity *e)
+        {
+            if (e == ignore)
+            {
+                return;
+            }
+            const OBB &target = e->obj().obb;
+            // The grid pads its answer by whole cells; skip bodies whose bounding sphere misses the path.
+            Vector3 nearest = Vector3Max(swept.min, Vector3Min(target.center, swept.max));
+            if (Vector3DistanceSqr(nearest, target.center) > Vector3LengthSqr(target.halfExtents))
+            {
+                return;
+            }
+            Vector3 margin = box ? OBB_ExtentsAlongAxes(box, &target) : Vector3{radius, radius, radius};
+            float fraction = 0.0f;
+            Vector3 normal;
+            if (SweepCenterVsOBB(start, delta, margin, &target, &fraction, &normal, box != nullptr) && fraction < closest.fraction)
+            {
+                closest = {e, true, fraction, normal};
+            }
+        });
+    }
+    return closest;
+}
+
+Vector3 Scene::SlideOBB(const OBB &box, Vector3 delta, const Entity *ignore, Vector3 *velocity)
+{
+    OBB moving = box;
+    Vector3 remaining = delta;
+    Vector3 planes[maxSlideIterations];
+    int planeCount = 0;
+
+    for (int i = 0; i < maxSlideIterations && Vector3LengthSqr(remaining) > 1e-8f; ++i)
+    {
+        SweepHit hit = this->SweepOBB(moving, remaining, ignore, false);
+        if (!hit.hit)
+        {
+            moving.center = Vector3Add(moving.center, remaining);
+            break;
+        }
+
+        // Stop at the contact and step off the surface so the next cast starts outside it.
+        moving.center = Vector3Add(moving.center, Vector3Scale(remaining, hit.fraction));
+        moving.center = Vector3Add(moving.center, Vector3Scale(hit.normal, slideSkin));
+        Vector3 leftover = Vector3Scale(remaining, 1.0f - hit.fraction);
+        planes[planeCount++] = hit.normal;
+
+        remaining = ClipAgainstPlane(leftover, hit.normal);
+        if (velocity)
+        {
+            *velocity = ClipAgainstPlane(*velocity, hit.normal);
+        }
+
+        // Sliding along this plane must not push back into an earlier one; if it does, follow their crease.
+        for (int p = 0; p < planeCount - 1; ++p)
+        {
+            if (Vector3DotProduct(remaining, planes[p]) >= 0.0f)
+            {
+                continue;
+            }
+            Vector3 crease = Vector3CrossProduct(planes[p], hit.normal);
+            if (Vector3LengthSqr(crease) < 1e-6f)
+            {
+                continue;
+            }
+            crease = Vector3Normalize(crease);
+            remaining = Vector3Scale(crease, Vector3DotProduct(leftover, crease));
+            if (velocity)
+            {
+                *velocity = Vector3Scale(crease, Vector3DotProduct(*velocity, crease));
+            }
+            break;
+        }
+
+        // Never let clipping turn the move back against the requested direction.
+        if (Vector3DotProduct(remaining, delta) <= 0.0f)
+        {
+            break;
+        }
+    }
+
+    return Vector3Subtract(moving.center, box.center);
+}
+
+void Scene::SweepDecorations(Vector3 start, Vector3 delta, const OBB *box, float radius, SweepHit &closest) const
+{
+    if (!this->bulletWorld)
+    {
+        return;
+    }
+
+    std::unique_ptr<btConvexShape> shape;
+    btTransform from;
+    from.setIdentity();
+    from.setOrigin(ToBtVector(start));
+    if (box)
+    {
+        shape = std::make_unique<btBoxShape>(ToBtVector(box->halfExtents));
+        from.setRotation(ToBtQuaternion(box->rotation));
+    }
+    else
+    {
+        shape = std::make_unique<btSphereShape>(radius);
+    }
+    btTransform to = from;
+    to.setOrigin(ToBtVector(Vector3Add(start, delta)));
+
+    btCollisionWorld::ClosestConvexResultCallback callback(from.getOrigin(), to.getOrigin());
+    callback.m_collisionFilterGroup = COLLISION_MASK_ALL;
+    callback.m_collisionFilterMask = COLLISION_LAYER_DECORATION;
+    {
+        std::lock_guard<std::mutex> lock(this->bulletQueryMutex);
+        this->bulletWorld->convexSweepTest(shape.get(), from, to, callback);
+    }
+    if (!callback.hasHit() || callback.m_closestHitFraction >= closest.fraction)
+    {
+        return;
+    }
+
+    // Contacts the shape is already leaving are left to discrete resolution.
+    btVector3 hitNormal = callback.m_hitNormalWorld;
+    Vector3 normal = Vector3Normalize({hitNormal.x(), hitNormal.y(), hitNormal.z()});
+    if (Vector3DotProduct(normal, delta) < 0.0f)
+    {
+        closest = {nullptr, true, callback.m_closestHitFraction, normal};
+    }
+}
+
 void Scene::ApplyFullTexture(Object &obj, Texture2D &texture)
 {
     if (texture.id == 0)
@@ -445,7 +651,7 @@ CollidableModel *Scene::AddDecoration(const char *modelPath, Vector3 desiredPosi
         auto *bulletObject = decoration->GetBulletObject();
         if (this->bulletWorld && bulletObject)
         {
-            this->bulletWorld->addCollisionObject(bulletObject);
+            this->bulletWorld->addCollisionObject(bulletObject, COLLISION_LAYER_DECORATION, COLLISION_MASK_ALL);
         }
     }
 
@@ -515,6 +721,7 @@ void Scene::ConfigureDoorPlacement(CollidableModel *door, const Vector3 &desired
 void Scene::InitializeRooms(float roomWidth, float roomLength, float wallHeight,
                             const std::vector<Vector3> &centers)
 {
+    this->roomGrid.Clear();
     this->rooms.clear();
     this->rooms.reserve(centers.size());
 
@@ -528,6 +735,7 @@ void Scene::InitializeRooms(float roomWidth, float roomLength, float wallHeight,
         std::string name = (i == 0) ? "Spawn Room" : "Room " + std::to_string(i + 1);
         this->rooms.push_back(std::make_unique<Room>(name, bounds, type));
     }
+    this->roomGrid.Build(this->rooms);
 }
 
 void Scene::BuildDoorNetwork(const std::vector<Vector3> &roomCenters, float roomWidth, float roomLength, float wallThickness)
@@ -645,6 +853,7 @@ void Scene::SpawnEnemiesForRoom(Room *room, const Vector3 &roomCenter)
         Vector3 position = {center.x + offset.x, floorY + tileSize.y * 0.5f, center.z + offset.y};
         enemy->obj().pos = position;
         enemy->setPosition(position);
+        enemy->setRoom(room);
         this->em.addEnemy(enemy);
     };
 
@@ -687,25 +896,33 @@ void Scene::SpawnEnemiesForRoom(Room *room, const Vector3 &roomCenter)
         const Vector2 &offset = entry.second;
         if (type == "sniper")
         {
-            placeEnemy(new ShooterEnemy(), roomCenter, offset);
+            placeEnemy(this->em.createEnemy<ShooterEnemy>(), roomCenter, offset);
         }
         else if (type == "tank")
         {
-            placeEnemy(new ChargingEnemy(), roomCenter, offset);
+            placeEnemy(this->em.createEnemy<ChargingEnemy>(), roomCenter, offset);
         }
         else if (type == "summoner")
         {
-            placeEnemy(new SummonerEnemy(), roomCenter, offset);
+            placeEnemy(this->em.createEnemy<SummonerEnemy>(), roomCenter, offset);
         }
         else if (type == "support")
         {
-            placeEnemy(new SupportEnemy(), roomCenter, offset);
+            placeEnemy(this->em.createEnemy<SupportEnemy>(), roomCenter, offset);
         }
         else if (type == "vanguard")
         {
-            placeEnemy(new VanguardEnemy(), roomCenter, offset);
+            placeEnemy(this->em.createEnemy<VanguardEnemy>(), roomCenter, offset);
         }
     }
+
+    // Warm the pools for this fight (two minion waves per summoner) so that
+    // summons and kills reuse memory and health-bar textures from here on.
+    size_t summoners = (size_t)std::count_if(composition.begin(), composition.end(),
+                                             [](const auto &entry) { return entry.first == "summoner"; });
+    size_t minions = summoners * SummonerEnemy::MINION_GROUP_SIZE * 2;
+    this->em.reserveEnemies<MinionEnemy>(minions);
+    this->em.reserveHealthDialogs(composition.size() + minions);
 }
 
 void Scene::AssignEnemyTextures(UIManager *uiManager)
@@ -714,69 +931,87 @@ void Scene::AssignEnemyTextures(UIManager *uiManager)
         return;
 
     // Assign tile textures based on each enemy's associated tile type
-    std::vector<Entity *> enemies = this->em.getEntities(ENTITY_ENEMY);
-    for (Entity *entity : enemies)
+    for (Enemy *enemy : this->em.viewEnemies())
     {
-        if (Enemy *enemy = dynamic_cast<Enemy *>(entity))
-        {
-            TileType type = enemy->getTileType();
-            enemy->obj().texture = &uiManager->muim.getSpriteSheet();
-            enemy->obj().sourceRect = uiManager->muim.getTile(type);
-            enemy->obj().useTexture = true;
-        }
+        TileType type = enemy->getTileType();
+        enemy->obj().texture = &uiManager->muim.getSpriteSheet();
+        enemy->obj().sourceRect = uiManager->muim.getTile(type);
+        enemy->obj().useTexture = true;
     }
 }
 
-void Scene::UpdateRooms(const std::vector<Entity *> &enemies)
+void Scene::UpdateIndependentSystems(UpdateContext &uc)
 {
-    for (auto &room : this->rooms)
+    JobSystem &jobs = *uc.jobs;
+    const float deltaSeconds = uc.deltaTime;
+
+    auto animateDoors = [&]
     {
-        if (room)
+        for (auto &door : this->doors)
         {
-            bool wasCompleted = room->IsCompleted();
-            room->Update(enemies);
-
-            // Spawn briefcase when room is newly completed
-            if (!wasCompleted && room->IsCompleted() && room->GetType() == RoomType::Enemy)
+            if (door)
             {
-                // Calculate room center
-                BoundingBox bounds = room->GetBounds();
-                Vector3 center = {
-                    (bounds.min.x + bounds.max.x) * 0.5f,
-                    bounds.min.y + 1.0f, // Spawn slightly above floor
-                    (bounds.min.z + bounds.max.z) * 0.5f};
-
-                // Generate 3-5 reward tiles with random stats
-                Inventory inv;
-                auto &tiles = inv.getTiles();
-                int tileCount = 3 + (rand() % 3); // 3-5 tiles
-                for (int i = 0; i < tileCount; ++i)
-                {
-                    TileType type = (TileType)(rand() % (int)TileType::TILE_COUNT);
-                    float damage = 10.0f + (float)(rand() % 8);
-                    float fireRate = 0.9f + ((float)(rand() % 7) / 10.0f);
-                    tiles.emplace_back(TileStats(damage, fireRate), type);
-                }
-
-                // Create briefcase
-                this->rewardBriefcases.push_back(std::make_unique<RewardBriefcase>(center, std::move(inv)));
+                door->Animate(deltaSeconds);
             }
         }
+    };
+    auto updateDamageIndicators = [&] { this->damageIndicators.Update(deltaSeconds); };
+    JobCounter done;
+    jobs.Run(done, "doors", animateDoors);
+    jobs.Run(done, "damage indicators", updateDamageIndicators);
+    jobs.ParallelFor("particles", this->particles.count(), 256, [&](size_t first, size_t end)
+    {
+        this->particles.updateRange(deltaSeconds, first, end);
+    });
+    jobs.WaitFor(done);
+
+    // Bullet and the briefcase list are not thread-safe, so finish here
+    for (auto &door : this->doors)
+    {
+        if (door)
+        {
+            door->SyncCollision();
+        }
+    }
+    // Rooms keep their own head count, so completion is a counter check
+    for (auto &room : this->rooms)
+    {
+        // Spawn briefcase when room is newly completed
+        if (room && room->Update() && room->GetType() == RoomType::Enemy)
+        {
+            this->SpawnRoomReward(*room);
+        }
     }
 }
 
-Room *Scene::GetRoomContainingPosition(const Vector3 &pos) const
+void Scene::SpawnRoomReward(const Room &room)
 {
-    for (const auto &rptr : this->rooms)
+    // Calculate room center
+    BoundingBox bounds = room.GetBounds();
+    Vector3 center = {
+        (bounds.min.x + bounds.max.x) * 0.5f,
+        bounds.min.y + 1.0f, // Spawn slightly above floor
+        (bounds.min.z + bounds.max.z) * 0.5f};
+
+    // Generate 3-5 reward tiles with random stats
+    Inventory inv;
+    auto &tiles = inv.getTiles();
+    int tileCount = 3 + (rand() % 3); // 3-5 tiles
+    for (int i = 0; i < tileCount; ++i)
     {
-        if (!rptr) continue;
-        const BoundingBox &b = rptr->GetBounds();
-        if (pos.x >= b.min.x && pos.x <= b.max.x && pos.y >= b.min.y && pos.y <= b.max.y && pos.z >= b.min.z && pos.z <= b.max.z)
-        {
-            return rptr.get();
-        }
+        TileType type = (TileType)(rand() % (int)TileType::TILE_COUNT);
+        float damage = 10.0f + (float)(rand() % 8);
+        float fireRate = 0.9f + ((float)(rand() % 7) / 10.0f);
+        tiles.emplace_back(TileStats(damage, fireRate), type);
     }
-    return nullptr;
+
+    // Create briefcase
+    this->rewardBriefcases.push_back(std::make_unique<RewardBriefcase>(center, std::move(inv)));
+}
+
+Room *Scene::GetRoomContainingPosition(const Vector3 &pos) const
+{
+    return this->roomGrid.Find(pos);
 }
 
 void Scene::DrawDoors() const
@@ -926,26 +1161,54 @@ void Scene::DrawRectangle(const Object &o) const
 
 void Scene::DrawSphereObject(const Object &o) const
 {
-    float radius = o.getSphereRadius();
+    const Texture2D *texture = (o.useTexture && o.texture != nullptr) ? o.texture : nullptr;
+    this->DrawSphereModel(o.pos, o.getSphereRadius(), texture, o.tint);
+}
+
+void Scene::DrawSphereModel(const Vector3 &position, float radius, const Texture2D *texture, Color tint) const
+{
     // Draw textured or solid sphere using the sphere model
     Vector3 scale = {radius * 2.0f, radius * 2.0f, radius * 2.0f};
 
-    if (o.useTexture && o.texture != nullptr)
+    if (texture != nullptr)
     {
         // Create a temporary material with the texture for this draw call
         Material tempMat = this->sphereModel.materials[0];
-        tempMat.maps[MATERIAL_MAP_DIFFUSE].texture = *o.texture;
+        tempMat.maps[MATERIAL_MAP_DIFFUSE].texture = *texture;
 
         // Temporarily replace material, draw, then restore
         Material originalMat = this->sphereModel.materials[0];
         const_cast<Scene *>(this)->sphereModel.materials[0] = tempMat;
-        DrawModelEx(this->sphereModel, o.pos, {0.0f, 1.0f, 0.0f}, 0.0f, scale, o.tint);
+        DrawModelEx(this->sphereModel, position, {0.0f, 1.0f, 0.0f}, 0.0f, scale, tint);
         const_cast<Scene *>(this)->sphereModel.materials[0] = originalMat;
     }
     else
     {
         // Use the shared sphere model with the lighting shader
-        DrawModelEx(this->sphereModel, o.pos, {0.0f, 1.0f, 0.0f}, 0.0f, scale, o.tint);
+        DrawModelEx(this->sphereModel, position, {0.0f, 1.0f, 0.0f}, 0.0f, scale, tint);
+    }
+}
+
+void Scene::DrawProjectiles() const
+{
+    for (size_t i = 0; i < this->projectiles.size(); ++i)
+    {
+        const ProjectileKind &kind = this->projectiles.GetKind(this->projectiles.KindOf(i));
+        Vector3 pos = this->projectiles.RenderPosition(i, this->renderAlpha);
+        if (kind.shape == ProjectileKind::Shape::Sphere)
+        {
+            this->DrawSphereModel(pos, kind.radius, kind.texture, kind.tint);
+        }
+        else if (kind.texture != nullptr)
+        {
+            // Same transform as DrawRectangle, spinning about Y
+            rlPushMatrix();
+            rlTranslatef(pos.x, pos.y, pos.z);
+            rlRotatef(fmodf(this->projectiles.Age(i) * kind.spinSpeed, 360.0f), 0.0f, 1.0f, 0.0f);
+            DrawCubeTextureRec(*kind.texture, this->projectiles.SourceRect(i), {0.0f, 0.0f, 0.0f},
+                               kind.tileSize.x, kind.tileSize.y, kind.tileSize.z, kind.tint);
+            rlPopMatrix();
+        }
     }
 }
 
@@ -953,8 +1216,6 @@ void Scene::DrawSphereObject(const Object &o) const
 void Scene::DrawScene(Camera camera) const
 {
     const float floorTop = this->GetFloorTop();
-    auto enemyObjects = this->em.getObjects();
-    auto projectileObjects = this->am.getObjects();
 
     // Begin shader mode once for all lit objects
     if (this->lightingShader.id != 0)
@@ -984,36 +1245,22 @@ void Scene::DrawScene(Camera camera) const
         }
     }
 
-    int debugBulletCount = 0;
-    for (auto *obj : enemyObjects)
+    auto drawSolid = [&](Object *o)
     {
-        if (!obj || !obj->isVisible())
-            continue;
-        if (obj->isSphere())
-            debugBulletCount++;
-        DrawRectangle(*obj);
-    }
+        if (o && o->isVisible())
+            DrawRectangle(*o);
+    };
+    this->em.visitObjects(drawSolid);
 
     // Draw custom enemy visuals (particles, glows, etc.)
-    std::vector<Entity *> enemies = this->em.getEntities(ENTITY_ENEMY);
-    for (Entity *entity : enemies)
+    for (Enemy *enemy : this->em.viewEnemies())
     {
-        if (entity)
-        {
-            Enemy *enemy = dynamic_cast<Enemy *>(entity);
-            if (enemy)
-            {
-                enemy->Draw();
-            }
-        }
+        enemy->Draw();
     }
 
     // Draw all projectiles managed by the AttackManager (solid core)
-    for (const auto &o : projectileObjects)
-    {
-        if (o && o->isVisible())
-            DrawRectangle(*o);
-    }
+    this->am.visitObjects(drawSolid);
+    this->DrawProjectiles();
 
     // End shader mode
     if (this->lightingShader.id != 0)
@@ -1025,20 +1272,21 @@ void Scene::DrawScene(Camera camera) const
     if (this->glowTexture.id != 0)
     {
         BeginBlendMode(BLEND_ADDITIVE);
-        for (const auto &o : projectileObjects)
+        auto drawGlow = [&](Object *o)
         {
             if (o && o->isVisible() && o->isSphere())
             {
                 // Draw a billboard slightly larger than the projectile
                 DrawBillboard(camera, this->glowTexture, o->getPos(), 1.2f, Color{255, 150, 100, 200});
             }
-        }
-        // Also draw glow for enemy bullets
-        for (auto *obj : enemyObjects)
+        };
+        this->am.visitObjects(drawGlow);
+        this->em.visitObjects(drawGlow);
+        for (size_t i = 0; i < this->projectiles.size(); ++i)
         {
-            if (obj && obj->isVisible() && obj->isSphere())
+            if (this->projectiles.GetKind(this->projectiles.KindOf(i)).glow)
             {
-                DrawBillboard(camera, this->glowTexture, obj->getPos(), 1.2f, Color{255, 150, 100, 200});
+                DrawBillboard(camera, this->glowTexture, this->projectiles.RenderPosition(i, this->renderAlpha), 1.2f, Color{255, 150, 100, 200});
             }
         }
         EndBlendMode();
@@ -1053,18 +1301,8 @@ void Scene::DrawScene(Camera camera) const
 
 void Scene::DrawEnemyHealthDialogs(const Camera &camera) const
 {
-    const std::vector<Entity *> enemies = this->em.getEntities(ENTITY_ENEMY);
-    if (enemies.empty())
-        return;
-    for (Entity *entity : enemies)
+    for (Enemy *enemy : this->em.viewEnemies())
     {
-        if (!entity || entity->category() != ENTITY_ENEMY)
-            continue;
-
-        Enemy *enemy = static_cast<Enemy *>(entity);
-        if (!enemy)
-            continue;
-
         DialogBox *dlg = enemy->getHealthDialog();
         if (!dlg)
             continue;
@@ -1097,20 +1335,19 @@ void Scene::EmitDamageIndicator(const Enemy &enemy, float damageAmount)
 // Updates all entities and attacks in the scene
 void Scene::Update(UpdateContext &uc)
 {
-    const float deltaSeconds = GetFrameTime();
-    
-    // Update particle system
-    this->particles.update(deltaSeconds);
+    // Drop ghost pairs that stopped overlapping since last frame
+    this->entityProxies.PrunePairs();
 
     // Check if player entered a new room and spawn enemies on first entry
     Room *previousRoom = this->currentPlayerRoom;
-    this->currentPlayerRoom = nullptr;
+    this->currentPlayerRoom = this->roomGrid.Find(uc.player->pos());
+
+    // Only the player's room, and rooms whose bullets are still flying, simulate this tick
     for (auto &room : this->rooms)
     {
-        if (room && room->IsPlayerInside(uc.player->pos()))
+        if (room)
         {
-            this->currentPlayerRoom = room.get();
-            break;
+            room->UpdateActivity(room.get() == this->currentPlayerRoom);
         }
     }
 
@@ -1147,21 +1384,20 @@ void Scene::Update(UpdateContext &uc)
         }
     }
 
+    // Cached sight lines are stale once a door has opened or closed
+    unsigned int doorRevision = 0;
+    for (const auto &door : this->doors)
+    {
+        doorRevision += door->GetCollisionRevision();
+    }
+    this->lineOfSight.SyncRevision(doorRevision);
+
     // Update all entities in the scene
     this->em.update(uc);
+    this->events.Flush(uc);
 
-    // Monitor room completion after enemies update so door logic is in sync
-    const std::vector<Entity *> enemies = this->em.getEntities(ENTITY_ENEMY);
-    this->UpdateRooms(enemies);
-
-    // Advance any active door animations
-    for (auto &door : this->doors)
-    {
-        if (door)
-        {
-            door->Update(deltaSeconds);
-        }
-    }
+    // Push apart everything that moved this tick (the player updated before the scene)
+    this->contactSolver.Solve(*this, uc.player, this->em.viewEnemies());
 
     // Update all reward briefcases
     for (auto &briefcase : this->rewardBriefcases)
@@ -1172,10 +1408,14 @@ void Scene::Update(UpdateContext &uc)
         }
     }
 
-    // Update all attacks managed by the AttackManager
+    // Update all attacks managed by the AttackManager, then everything they and the enemies fired
     this->am.update(uc);
+    this->projectiles.Update(uc);
+    this->events.Flush(uc);
 
-    this->damageIndicators.Update(deltaSeconds);
+    // Nothing spawns, moves or dies past this point, so the systems that only
+    // touch their own state advance side by side on the job system.
+    this->UpdateIndependentSystems(uc);
 }
 
 // Constructor initializes the scene with default objects
@@ -1192,6 +1432,9 @@ Scene::Scene()
     this->particles.globalSizeMultiplier = 0.5f;
     this->particles.globalIntensityMultiplier = 1.5f;
 
+    // Room for a busy fight's bullets, so firing them does not grow the projectile columns
+    this->projectiles.Reserve(512);
+
     // const Vector3 towerSize = {16.0f, 32.0f, 16.0f}; // Size of the towers
     // const Color towerColor = {150, 200, 200, 255};   // Color of the towers
 
@@ -1372,6 +1615,13 @@ Scene::Scene()
     this->glowTexture = LoadTextureFromImage(glowImg);
     UnloadImage(glowImg);
 
+    this->enemyBulletTexture = LoadTexture("sun.png");
+    if (this->enemyBulletTexture.id == 0)
+    {
+        TraceLog(LOG_WARNING, "Scene: Failed to load sun.png");
+    }
+    ShooterEnemy::RegisterBulletKind(this->projectiles, this->enemyBulletTexture.id != 0 ? &this->enemyBulletTexture : nullptr);
+
     this->InitializeLighting();
 
     // Apply lighting shader to walls after InitializeLighting
@@ -1402,6 +1652,63 @@ Scene::Scene()
     this->AddDecoration("decorations/tables/pool_table/scene.gltf", {24.0f, 0.0f, -6.0f}, 4.5f, 12.0f);
     this->AddDecoration("decorations/lights/floor_lamp/scene.gltf", {50.0f, 0.0f, -32.0f}, 13.0f, -25.0f);
     this->AddDecoration("decorations/lights/neon_cactus_lamp/scene.gltf", {-42.0f, 0.0f, -28.0f}, 9.0f, 0.0f);
+
+    // Walls, doors and decorations never move after this point, so index them once.
+    std::vector<const btCollisionObject *> staticColliders;
+    for (const auto &door : this->doors)
+    {
+        if (door && door->collider && door->collider->GetBulletObject())
+        {
+            staticColliders.push_back(door->collider->GetBulletObject());
+        }
+    }
+    for (const auto &decoration : this->decorations)
+    {
+        const btCollisionObject *bulletObject = decoration->GetBulletObject();
+        if (bulletObject && bulletObject->getBroadphaseHandle())
+        {
+            staticColliders.push_back(bulletObject);
+        }
+    }
+    this->staticWorld.Build(this->objects, staticColliders);
+    this->BuildRoomVisibility();
+}
+
+void Scene::BuildRoomVisibility()
+{
+    // Shooter muzzles and the player's eyes both sit about this high.
+    const float cellSize = 6.0f;
+    const float sampleHeight = 3.0f;
+    const float probeRadius = 0.1f;
+
+    // Sweep with every door open: doors only ever add blockers, so a pair the
+    // field rules out stays blocked whichever doors close later.
+    std::vector<Door *> closedDoors;
+    for (auto &door : this->doors)
+    {
+        if (door && door->collisionEnabled)
+        {
+            door->DisableCollision();
+            closedDoors.push_back(door.get());
+        }
+    }
+
+    double startTime = GetTime();
+    int cellCount = 0;
+    for (auto &room : this->rooms)
+    {
+        if (!room)
+            continue;
+        room->GetVisibility().Build(room->GetBounds(), cellSize, sampleHeight,
+                                    [&](const Vector3 &a, const Vector3 &b)
+                                    { return this->CheckStaticSweep(a, b, probeRadius); });
+        cellCount += room->GetVisibility().CellCount();
+    }
+    for (Door *door : closedDoors)
+    {
+        door->EnableCollision();
+    }
+    TraceLog(LOG_INFO, "Scene: Built room visibility (%d cells) in %.1f ms", cellCount, (GetTime() - startTime) * 1000.0);
 }
 
 // Getter for the list of objects in the scene
@@ -1410,17 +1717,65 @@ std::vector<Object *> Scene::getStaticObjects() const
     return this->objects;
 }
 
-std::vector<Entity *> Scene::getEntities(EntityCategory cat)
+void Scene::visitEntities(EntityCategory cat, Visitor<Entity> visit)
 {
-    std::vector<Entity *> r;
     // Query attack manager for projectiles if requested
-    auto amEntities = this->am.getEntities(cat);
-    r.insert(r.end(), amEntities.begin(), amEntities.end());
+    this->am.visitEntities(cat, visit);
     // Query enemy manager for enemies if requested
-    auto emEntities = this->em.getEntities(cat);
-    r.insert(r.end(), emEntities.begin(), emEntities.end());
+    if (cat == ENTITY_ENEMY || cat == ENTITY_ALL)
+    {
+        for (Entity *e : this->em.getEnemies())
+        {
+            visit(e);
+        }
+    }
+}
+
+void Scene::QueryCollisionCandidates(const BoundingBox &bounds, Visitor<Entity> visit, unsigned int mask)
+{
+    if (mask & COLLISION_LAYER_PROJECTILE)
+    {
+        this->am.visitEntities(ENTITY_ALL, visit);
+    }
+    if (mask & COLLISION_LAYER_ENEMY)
+    {
+        this->em.QueryCandidates(bounds, visit);
+    }
+}
+
+void Scene::StorePreviousPositions(Entity *player)
+{
+    if (player)
+    {
+        player->storePreviousPosition();
+    }
+    this->visitEntities(ENTITY_ALL, [](Entity *e) { e->storePreviousPosition(); });
+}
 
-    return r;
+void Scene::BeginRenderInterpolation(Entity *player, float alpha)
+{
+    this->renderInterpolated.clear();
+    this->renderAlpha = alpha;
+    auto interpolate = [&](Entity *e)
+    {
+        this->renderInterpolated.push_back({e, e->pos()});
+        e->setPosition(e->interpolatedPos(alpha));
+    };
+    this->visitEntities(ENTITY_ALL, interpolate);
+    if (player)
+    {
+        interpolate(player);
+    }
+}
+
+void Scene::EndRenderInterpolation()
+{
+    for (auto &entry : this->renderInterpolated)
+    {
+        entry.first->setPosition(entry.second);
+    }
+    this->renderInterpolated.clear();
+    this->renderAlpha = 1.0f;
 }
 
 void Scene::SetViewPosition(const Vector3 &viewPosition)
@@ -1448,14 +1803,7 @@ std::vector<RewardBriefcase *> Scene::GetRewardBriefcases()
 void Scene::UpdateRoomDoors(const Vector3 &playerPos)
 {
     // Determine current player room
-    Room *newRoom = nullptr;
-    for (auto &room : this->rooms){
-        if (room && room->IsPlayerInside(playerPos))
-        {
-            newRoom = room.get();
-            break;
-        }
-    }
+    Room *newRoom = this->roomGrid.Find(playerPos);
 
     // If player changed rooms, close door behind them (unless both rooms are cleared)
     if (newRoom != this->currentPlayerRoom)
@@ -0,0 +1,34 @@
+#include "simulationClock.hpp"
+#include <cmath>
+
+SimulationClock::SimulationClock(float tickRateHz, int maxSubsteps)
+    : step(1.0f / (tickRateHz > 0.0f ? tickRateHz : SIMULATION_HZ))
+{
+    this->SetMaxSubsteps(maxSubsteps);
+}
+
+void SimulationClock::SetMaxSubsteps(int maxSubsteps)
+{
+    this->maxSubsteps = (maxSubsteps > 0) ? maxSubsteps : 1;
+}
+
+int SimulationClock::Advance(float frameSeconds)
+{
+    if (frameSeconds > 0.0f)
+    {
+        this->accumulator += frameSeconds;
+    }
+
+    int ticks = (int)(this->accumulator / this->step);
+    if (ticks > this->maxSubsteps)
+    {
+        // Drop the backlog but keep the sub-tick remainder so Alpha() stays in [0, 1).
+        ticks = this->maxSubsteps;
+        this->accumulator = fmodf(this->accumulator, this->step);
+    }
+    else
+    {
+        this->accumulator -= this->step * ticks;
+    }
+    return ticks;
+}
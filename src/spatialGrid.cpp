@@ -0,0 +1,165 @@
+#include "spatialGrid.hpp"
+#include "me.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize(cellSize), invCellSize(1.0f / cellSize), bucketStart(BUCKET_COUNT + 1, 0), occupancy(OCCUPANCY_SIZE, 0)
+{
+}
+
+int SpatialGrid::CellCoord(float v) const
+{
+    return (int)floorf(v * this->invCellSize);
+}
+
+unsigned int SpatialGrid::HashCell(int cellX, int cellZ)
+{
+    unsigned int h = (unsigned int)cellX * 73856093u ^ (unsigned int)cellZ * 19349663u;
+    return h & (BUCKET_COUNT - 1);
+}
+
+float SpatialGrid::HalfExtentOf(const Entity *e) const
+{
+    // Rotated boxes never reach further than their half-diagonal.
+    const Vector3 &h = e->obj().obb.halfExtents;
+    return sqrtf(h.x * h.x + h.y * h.y + h.z * h.z);
+}
+
+void SpatialGrid::BeginRebuild(size_t expectedCount)
+{
+    this->staged.clear();
+    this->staged.reserve(expectedCount);
+    this->pending.clear();
+    this->removed.clear();
+    this->maxHalfExtent = 0.0f;
+}
+
+void SpatialGrid::Stage(Entity *e)
+{
+    if (!e)
+        return;
+    const Vector3 &c = e->obj().obb.center;
+    this->staged.push_back({e, this->CellCoord(c.x), this->CellCoord(c.z)});
+    this->maxHalfExtent = fmaxf(this->maxHalfExtent, this->HalfExtentOf(e));
+}
+
+void SpatialGrid::EndRebuild()
+{
+    // Counting sort by bucket: count, prefix sum, scatter.
+    std::fill(this->bucketStart.begin(), this->bucketStart.end(), 0u);
+    for (const Entry &entry : this->staged)
+        this->bucketStart[HashCell(entry.cellX, entry.cellZ) + 1]++;
+    for (unsigned int i = 0; i < BUCKET_COUNT; ++i)
+        this->bucketStart[i + 1] += this->bucketStart[i];
+
+    this->minCellX = this->minCellZ = INT_MAX;
+    this->maxCellX = this->maxCellZ = INT_MIN;
+    std::fill(this->occupancy.begin(), this->occupancy.end(), 0u);
+    for (const Entry &entry : this->staged)
+    {
+        this->occupancy[entry.cellZ & (OCCUPANCY_SIZE - 1)] |= 1ull << (entry.cellX & (OCCUPANCY_SIZE - 1));
+        this->minCellX = std::min(this->minCellX, entry.cellX);
+        this->maxCellX = std::max(this->maxCellX, entry.cellX);
+        this->minCellZ = std::min(this->minCellZ, entry.cellZ);
+        this->maxCellZ = std::max(this->maxCellZ, entry.cellZ);
+    }
+
+    this->entries.resize(this->staged.size());
+    std::vector<unsigned int> &cursor = this->scatterCursor;
+    cursor.assign(this->bucketStart.begin(), this->bucketStart.end() - 1);
+    for (const Entry &entry : this->staged)
+        this->entries[cursor[HashCell(entry.cellX, entry.cellZ)]++] = entry;
+}
+
+void SpatialGrid::Insert(Entity *e)
+{
+    if (!e)
+        return;
+    this->pending.push_back(e);
+    // A new entity may reuse the address of one removed since the last rebuild.
+    // Its stale binned entry must go too, or Query() would report it twice.
+    auto stale = std::remove(this->removed.begin(), this->removed.end(), e);
+    if (stale != this->removed.end())
+    {
+        this->removed.erase(stale, this->removed.end());
+        for (Entry &entry : this->entries)
+        {
+            if (entry.entity == e)
+                entry.entity = nullptr;
+        }
+    }
+    this->maxHalfExtent = fmaxf(this->maxHalfExtent, this->HalfExtentOf(e));
+}
+
+void SpatialGrid::Remove(Entity *e)
+{
+    // Binned entries are filtered out by Query() until the next rebuild drops them.
+    this->removed.push_back(e);
+    this->pending.erase(std::remove(this->pending.begin(), this->pending.end(), e), this->pending.end());
+}
+
+void SpatialGrid::Clear()
+{
+    this->staged.clear();
+    this->entries.clear();
+    this->pending.clear();
+    this->removed.clear();
+    std::fill(this->bucketStart.begin(), this->bucketStart.end(), 0u);
+    std::fill(this->occupancy.begin(), this->occupancy.end(), 0u);
+    this->maxHalfExtent = 0.0f;
+    this->minCellX = this->minCellZ = 0;
+    this->maxCellX = this->maxCellZ = -1;
+}
+
+bool SpatialGrid::IsRemoved(const Entity *e) const
+{
+    return !this->removed.empty() && std::find(this->removed.begin(), this->removed.end(), e) != this->removed.end();
+}
+
+void SpatialGrid::Query(const BoundingBox &bounds, Visitor<Entity> visit) const
+{
+    float grow = this->maxHalfExtent;
+    int minX = this->CellCoord(bounds.min.x - grow) - 1;
+    int maxX = this->CellCoord(bounds.max.x + grow) + 1;
+    int minZ = this->CellCoord(bounds.min.z - grow) - 1;
+    int maxZ = this->CellCoord(bounds.max.z + grow) + 1;
+
+    if (maxX - minX >= MAX_QUERY_SPAN || maxZ - minZ >= MAX_QUERY_SPAN)
+    {
+        // Huge query volumes would touch every bucket anyway.
+        for (const Entry &entry : this->entries)
+        {
+            if (entry.entity && !this->IsRemoved(entry.entity) && entry.cellX >= minX && entry.cellX <= maxX && entry.cellZ >= minZ && entry.cellZ <= maxZ)
+                visit(entry.entity);
+        }
+    }
+    else
+    {
+        // Only the part of the query that overlaps binned entities needs hashing
+        minX = std::max(minX, this->minCellX);
+        maxX = std::min(maxX, this->maxCellX);
+        minZ = std::max(minZ, this->minCellZ);
+        maxZ = std::min(maxZ, this->maxCellZ);
+        for (int cx = minX; cx <= maxX; ++cx)
+        {
+            for (int cz = minZ; cz <= maxZ; ++cz)
+            {
+                if (!(this->occupancy[cz & (OCCUPANCY_SIZE - 1)] >> (cx & (OCCUPANCY_SIZE - 1)) & 1u))
+                    continue;
+                unsigned int bucket = HashCell(cx, cz);
+                for (unsigned int i = this->bucketStart[bucket]; i < this->bucketStart[bucket + 1]; ++i)
+                {
+                    const Entry &entry = this->entries[i];
+                    // Buckets are shared by hash collisions, so confirm the cell.
+                    if (entry.entity && entry.cellX == cx && entry.cellZ == cz && !this->IsRemoved(entry.entity))
+                        visit(entry.entity);
+                }
+            }
+        }
+    }
+
+    for (Entity *e : this->pending)
+        visit(e);
+}
@@ -0,0 +1,467 @@
+#include "staticWorldBVH.hpp"
+#include "object.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+BoundingBox EmptyBox()
+{
+    return {{INFINITY, INFINITY, INFINITY}, {-INFINITY, -INFINITY, -INFINITY}};
+}
+
+BoundingBox Merge(const BoundingBox &a, const BoundingBox &b)
+{
+    return {Vector3Min(a.min, b.min), Vector3Max(a.max, b.max)};
+}
+
+BoundingBox Grow(const BoundingBox &box, float amount)
+{
+    Vector3 pad = {amount, amount, amount};
+    return {Vector3Subtract(box.min, pad), Vector3Add(box.max, pad)};
+}
+
+bool BoxesOverlap(const BoundingBox &a, const BoundingBox &b)
+{
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+           a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+float AxisComponent(const Vector3 &v, int axis)
+{
+    return (&v.x)[axis];
+}
+
+/**
+ * Precomputed segment for repeated slab tests against node bounds.
+ */
+struct Segment
+{
+    Vector3 origin;
+    Vector3 end;
+    Vector3 invDir;
+    float length;
+
+    Segment(Vector3 start, Vector3 end)
+    {
+        Vector3 delta = Vector3Subtract(end, start);
+        this->origin = start;
+        this->end = end;
+        this->length = Vector3Length(delta);
+        Vector3 dir = (this->length > 0.0001f) ? Vector3Scale(delta, 1.0f / this->length) : Vector3{0.0f, 0.0f, 0.0f};
+        // A huge finite reciprocal avoids 0 * inf on axis-parallel segments.
+        this->invDir = {(dir.x != 0.0f) ? 1.0f / dir.x : 1.0e30f,
+                        (dir.y != 0.0f) ? 1.0f / dir.y : 1.0e30f,
+                        (dir.z != 0.0f) ? 1.0f / dir.z : 1.0e30f};
+    }
+
+    Segment(Ray ray, float maxDistance)
+        : Segment(ray.position, Vector3Add(ray.position, Vector3Scale(Vector3Normalize(ray.direction), maxDistance)))
+    {
+    }
+
+    BoundingBox Bounds(float padding) const
+    {
+        return Grow({Vector3Min(this->origin, this->end), Vector3Max(this->origin, this->end)}, padding);
+    }
+
+    bool Hits(const BoundingBox &box) const
+    {
+        float tMin = 0.0f;
+        float tMax = this->length;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float o = AxisComponent(this->origin, axis);
+            float inv = AxisComponent(this->invDir, axis);
+            float t0 = (AxisComponent(box.min, axis) - o) * inv;
+            float t1 = (AxisComponent(box.max, axis) - o) * inv;
+            if (t0 > t1)
+                std::swap(t0, t1);
+            tMin = fmaxf(tMin, t0);
+            tMax = fminf(tMax, t1);
+            if (tMin > tMax)
+                return false;
+        }
+        return true;
+    }
+};
+}
+
+void StaticWorldBVH::Clear()
+{
+    this->nodes.clear();
+    this->wallBatch.Clear();
+    this->wallObjects.clear();
+    this->colliders.clear();
+    this->columns = 0;
+    this->rows = 0;
+    this->occupied.clear();
+}
+
+void StaticWorldBVH::Build(const std::vector<Object *> &walls, const std::vector<const btCollisionObject *> &colliders)
+{
+    this->Clear();
+    ++this->revision;
+
+    std::vector<BuildItem> items;
+    items.reserve(walls.size() + colliders.size());
+    for (Object *wall : walls)
+    {
+        if (!wall)
+            continue;
+        wall->UpdateOBB();
+        BoundingBox bounds = OBB_GetBoundingBox(&wall->obb);
+        items.push_back({bounds, wall->obb.center, wall, nullptr});
+    }
+    for (const btCollisionObject *collider : colliders)
+    {
+        if (!collider || !collider->getCollisionShape())
+            continue;
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        collider->getCollisionShape()->getAabb(collider->getWorldTransform(), aabbMin, aabbMax);
+        BoundingBox bounds = {{aabbMin.x(), aabbMin.y(), aabbMin.z()}, {aabbMax.x(), aabbMax.y(), aabbMax.z()}};
+        items.push_back({bounds, Vector3Scale(Vector3Add(bounds.min, bounds.max), 0.5f), nullptr, collider});
+    }
+
+    if (items.empty())
+        return;
+
+    this->nodes.reserve(2 * items.size());
+    this->BuildRecursive(items, 0, (int)items.size());
+    this->BuildOccupancy(items);
+
+    TraceLog(LOG_INFO, "StaticWorldBVH: %d walls, %d colliders, %d nodes",
+             (int)walls.size(), (int)this->colliders.size(), (int)this->nodes.size());
+}
+
+int StaticWorldBVH::BuildRecursive(std::vector<BuildItem> &items, int begin, int end)
+{
+    int index = (int)this->nodes.size();
+    this->nodes.emplace_back();
+
+    BoundingBox bounds = EmptyBox();
+    BoundingBox centroidBounds = EmptyBox();
+    for (int i = begin; i < end; ++i)
+    {
+        bounds = Merge(bounds, items[i].bounds);
+        centroidBounds = Merge(centroidBounds, {items[i].centroid, items[i].centroid});
+    }
+    this->nodes[index].bounds = bounds;
+
+    if (end - begin <= LEAF_SIZE)
+    {
+        // Each leaf's walls start a fresh lane group so one SAT block covers them.
+        this->wallBatch.AlignToLanes();
+        this->wallObjects.resize(this->wallBatch.size(), nullptr);
+
+        Node &leaf = this->nodes[index];
+        leaf.firstWall = (int)this->wallBatch.size();
+        leaf.firstCollider = (int)this->colliders.size();
+        for (int i = begin; i < end; ++i)
+        {
+            if (items[i].wall)
+            {
+                this->wallBatch.Add(items[i].wall->obb);
+                this->wallObjects.push_back(items[i].wall);
+                ++leaf.wallCount;
+            }
+            else
+            {
+                this->colliders.push_back({items[i].bounds, items[i].collider});
+                ++leaf.colliderCount;
+            }
+        }
+        return index;
+    }
+
+    // Median split along the longest axis of the centroid bounds.
+    Vector3 extent = Vector3Subtract(centroidBounds.max, centroidBounds.min);
+    int axis = 0;
+    if (extent.y > AxisComponent(extent, axis))
+        axis = 1;
+    if (extent.z > AxisComponent(extent, axis))
+        axis = 2;
+
+    int mid = begin + (end - begin) / 2;
+    std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+                     [axis](const BuildItem &a, const BuildItem &b)
+                     { return AxisComponent(a.centroid, axis) < AxisComponent(b.centroid, axis); });
+
+    int left = this->BuildRecursive(items, begin, mid);
+    int right = this->BuildRecursive(items, mid, end);
+    this->nodes[index].left = left;
+    this->nodes[index].right = right;
+    return index;
+}
+
+void StaticWorldBVH::BuildOccupancy(const std::vector<BuildItem> &items)
+{
+    const BoundingBox &world = this->nodes[0].bounds;
+    this->originX = world.min.x;
+    this->originZ = world.min.z;
+    this->columns = (int)floorf((world.max.x - world.min.x) / OCCUPANCY_CELL_SIZE) + 1;
+    this->rows = (int)floorf((world.max.z - world.min.z) / OCCUPANCY_CELL_SIZE) + 1;
+    this->occupied.assign((size_t)this->columns * (size_t)this->rows, 0);
+
+    for (const BuildItem &item : items)
+    {
+        int c0, r0, c1, r1;
+        this->CellRange(item.bounds, c0, r0, c1, r1);
+        for (int r = r0; r <= r1; ++r)
+        {
+            for (int c = c0; c <= c1; ++c)
+                this->occupied[(size_t)r * this->columns + c] = 1;
+        }
+    }
+}
+
+bool StaticWorldBVH::CellRange(const BoundingBox &box, int &c0, int &r0, int &c1, int &r1) const
+{
+    // Truncating instead of floorf() only differs less than a cell before the origin,
+    // where the range is clamped to the first cell anyway.
+    const float invCellSize = 1.0f / OCCUPANCY_CELL_SIZE;
+    c0 = (int)((box.min.x - this->originX) * invCellSize);
+    r0 = (int)((box.min.z - this->originZ) * invCellSize);
+    c1 = (int)((box.max.x - this->originX) * invCellSize);
+    r1 = (int)((box.max.z - this->originZ) * invCellSize);
+    if (c1 < 0 || r1 < 0 || c0 >= this->columns || r0 >= this->rows)
+        return false;
+    c0 = std::max(c0, 0);
+    r0 = std::max(r0, 0);
+    c1 = std::min(c1, this->columns - 1);
+    r1 = std::min(r1, this->rows - 1);
+    return true;
+}
+
+bool StaticWorldBVH::MayTouch(const BoundingBox &query) const
+{
+    // Long rays and big boxes cover too many cells to be worth checking (and may not be finite).
+    const float maxExtent = (MAX_OCCUPANCY_SPAN - 1) * OCCUPANCY_CELL_SIZE;
+    if (!(query.max.x - query.min.x < maxExtent && query.max.z - query.min.z < maxExtent))
+        return true;
+
+    int c0, r0, c1, r1;
+    if (!this->CellRange(query, c0, r0, c1, r1))
+        return false; // Nothing static outside the world bounds
+
+    for (int r = r0; r <= r1; ++r)
+    {
+        for (int c = c0; c <= c1; ++c)
+        {
+            if (this->occupied[(size_t)r * this->columns + c])
+                return true;
+        }
+    }
+    return false;
+}
+
+template <typename OverlapFn, typename LeafFn>
+void StaticWorldBVH::Traverse(const BoundingBox &reach, OverlapFn &&overlaps, LeafFn &&visitLeaf) const
+{
+    if (this->nodes.empty() || !this->MayTouch(reach))
+        return;
+
+    // Median splits keep the tree balanced, so the depth stays far below MAX_DEPTH.
+    int stack[MAX_DEPTH];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+        const Node &node = this->nodes[stack[--top]];
+        if (!overlaps(node.bounds))
+            continue;
+
+        if (node.left < 0)
+        {
+            if (visitLeaf(node))
+                return;
+            continue;
+        }
+        stack[top++] = node.right;
+        stack[top++] = node.left;
+    }
+}
+
+bool StaticWorldBVH::TouchesEnabledCollider(const Node &leaf, const BoundingBox &query) const
+{
+    for (int i = 0; i < leaf.colliderCount; ++i)
+    {
+        const ColliderEntry &entry = this->colliders[leaf.firstCollider + i];
+        // Disabled colliders (open doors) are removed from the Bullet world.
+        if (entry.collider->getBroadphaseHandle() && BoxesOverlap(entry.bounds, query))
+            return true;
+    }
+    return false;
+}
+
+void StaticWorldBVH::OverlapOBB(const OBB &box, std::vector<CollisionResult> &wallHits, bool *touchesCollider) const
+{
+    BoundingBox query = OBB_GetBoundingBox(&box);
+    bool touched = false;
+    CollisionResult block[OBBBatch::LANES];
+
+    this->Traverse(query,
+                   [&query](const BoundingBox &bounds)
+                   { return BoxesOverlap(bounds, query); },
+                   [&](const Node &leaf)
+                   {
+                       if (leaf.wallCount > 0)
+                       {
+                           GetCollisionOBBvsOBBBatch(&box, this->wallBatch, leaf.firstWall, leaf.wallCount, block);
+                           for (int i = 0; i < leaf.wallCount; ++i)
+                           {
+                               if (block[i].collided)
+                                   wallHits.push_back(block[i]);
+                           }
+                       }
+                       if (!touched && leaf.colliderCount > 0)
+                           touched = this->TouchesEnabledCollider(leaf, query);
+                       return false;
+                   });
+
+    if (touchesCollider)
+        *touchesCollider = touched;
+}
+
+void StaticWorldBVH::OverlapSphere(Vector3 center, float radius, Visitor<Object> visitWall, bool *touchesCollider) const
+{
+    BoundingBox query = Grow({center, center}, radius);
+    bool touched = false;
+
+    this->Traverse(query,
+                   [&query](const BoundingBox &bounds)
+                   { return BoxesOverlap(bounds, query); },
+                   [&](const Node &leaf)
+                   {
+                       for (int i = 0; i < leaf.wallCount; ++i)
+                       {
+                           Object *wall = this->wallObjects[leaf.firstWall + i];
+                           if (CheckCollisionSphereVsOBB(center, radius, &wall->obb))
+                               visitWall(wall);
+                       }
+                       if (!touched && leaf.colliderCount > 0)
+                           touched = this->TouchesEnabledCollider(leaf, query);
+                       return false;
+                   });
+
+    if (touchesCollider)
+        *touchesCollider = touched;
+}
+
+bool StaticWorldBVH::SweepSphere(Vector3 start, Vector3 end, float radius, float ignoreDistance, bool *touchesCollider) const
+{
+    Segment segment(start, end);
+    bool blocked = false;
+    bool touched = false;
+    // CheckLineSegmentVsOBB grows the box along its own axes, whose world
+    // bounds can reach radius * sqrt(3) past the wall's AABB.
+    float nodePadding = radius * 1.7320508f;
+
+    this->Traverse(segment.Bounds(nodePadding),
+                   [&segment, nodePadding](const BoundingBox &bounds)
+                   { return segment.Hits(Grow(bounds, nodePadding)); },
+                   [&](const Node &leaf)
+                   {
+                       for (int i = 0; i < leaf.wallCount; ++i)
+                       {
+                           float hitDistance = 0.0f;
+                           Object *wall = this->wallObjects[leaf.firstWall + i];
+                           if (CheckLineSegmentVsOBB(start, end, radius, &wall->obb, &hitDistance) && hitDistance > ignoreDistance)
+                           {
+                               blocked = true;
+                               return true;
+                           }
+                       }
+                       for (int i = 0; !touched && i < leaf.colliderCount; ++i)
+                       {
+                           const ColliderEntry &entry = this->colliders[leaf.firstCollider + i];
+                           touched = entry.collider->getBroadphaseHandle() && segment.Hits(Grow(entry.bounds, radius));
+                       }
+                       return false;
+                   });
+
+    if (touchesCollider)
+        *touchesCollider = touched;
+    return blocked;
+}
+
+RayCollision StaticWorldBVH::Raycast(Ray ray, float maxDistance, bool *touchesCollider) const
+{
+    RayCollision closest = {};
+    closest.hit = false;
+    closest.distance = maxDistance;
+    bool touched = false;
+    ray.direction = Vector3Normalize(ray.direction);
+    Segment segment(ray, maxDistance);
+
+    this->Traverse(segment.Bounds(0.0f),
+                   [&segment](const BoundingBox &bounds)
+                   { return segment.Hits(bounds); },
+                   [&](const Node &leaf)
+                   {
+                       for (int i = 0; i < leaf.wallCount; ++i)
+                       {
+                           RayCollision hit = GetRayCollisionOBB(ray, &this->wallObjects[leaf.firstWall + i]->obb);
+                           if (hit.hit && hit.distance >= 0.0f && hit.distance <= closest.distance)
+                               closest = hit;
+                       }
+                       for (int i = 0; !touched && i < leaf.colliderCount; ++i)
+                       {
+                           const ColliderEntry &entry = this->colliders[leaf.firstCollider + i];
+                           touched = entry.collider->getBroadphaseHandle() && segment.Hits(entry.bounds);
+                       }
+                       return false;
+                   });
+
+    if (touchesCollider)
+        *touchesCollider = touched;
+    return closest;
+}
+
+SweepHit StaticWorldBVH::CastSphere(Vector3 start, Vector3 delta, float radius, bool *touchesCollider) const
+{
+    return this->Cast(start, delta, nullptr, radius, touchesCollider);
+}
+
+SweepHit StaticWorldBVH::CastOBB(const OBB &box, Vector3 delta, bool *touchesCollider) const
+{
+    return this->Cast(box.center, delta, &box, Vector3Length(box.halfExtents), touchesCollider);
+}
+
+SweepHit StaticWorldBVH::Cast(Vector3 start, Vector3 delta, const OBB *box, float radius, bool *touchesCollider) const
+{
+    SweepHit closest = {nullptr, false, 1.0f, {0.0f, 0.0f, 0.0f}};
+    Segment segment(start, Vector3Add(start, delta));
+    bool touched = false;
+    // Walls grow by the shape's margin along their own axes, which can reach
+    // sqrt(3) times the bounding radius past their AABB.
+    float nodePadding = radius * 1.7320508f;
+
+    this->Traverse(segment.Bounds(nodePadding),
+                   [&segment, nodePadding](const BoundingBox &bounds)
+                   { return segment.Hits(Grow(bounds, nodePadding)); },
+                   [&](const Node &leaf)
+                   {
+                       for (int i = 0; i < leaf.wallCount; ++i)
+                       {
+                           const OBB &wall = this->wallObjects[leaf.firstWall + i]->obb;
+                           Vector3 margin = box ? OBB_ExtentsAlongAxes(box, &wall) : Vector3{radius, radius, radius};
+                           float fraction = 0.0f;
+                           Vector3 normal;
+                           if (SweepCenterVsOBB(start, delta, margin, &wall, &fraction, &normal, box != nullptr) && fraction < closest.fraction)
+                               closest = {nullptr, true, fraction, normal};
+                       }
+                       for (int i = 0; !touched && i < leaf.colliderCount; ++i)
+                       {
+                           const ColliderEntry &entry = this->colliders[leaf.firstCollider + i];
+                           touched = entry.collider->getBroadphaseHandle() && segment.Hits(Grow(entry.bounds, radius));
+                       }
+                       return false;
+                   });
+
+    if (touchesCollider)
+        *touchesCollider = touched;
+    return closest;
+}
@@ -0,0 +1,152 @@
+#include "tileCombo.hpp"
+
+namespace
+{
+constexpr int Index(TileType tile) { return static_cast<int>(tile); }
+
+constexpr bool IsPlayable(TileType tile) { return Index(tile) >= 0 && Index(tile) < PLAYABLE_TILE_TYPES; }
+
+// The rules, written once over count vectors; every combo holds exactly three tiles
+constexpr TileCombo ClassifyCounts(const TileCounts &counts)
+{
+    const int dot = Index(TileType::DOT_1);
+    const int bamboo = Index(TileType::BAMBOO_1);
+    const int character = Index(TileType::CHARACTER_1);
+
+    if (counts[dot] == 3)
+        return TileCombo::GravityWell;
+    if (counts[dot + 1] == 3)
+        return TileCombo::OrbitalShield;
+    if (counts[dot] == 1 && counts[dot + 1] == 1 && counts[dot + 2] == 1)
+        return TileCombo::ChainLightning;
+    if (counts[bamboo] == 3)
+        return TileCombo::BambooTriple;
+    if (counts[bamboo + 1] == 3)
+        return TileCombo::BambooBomb;
+    if (counts[bamboo] == 1 && counts[bamboo + 1] == 1 && counts[bamboo + 2] == 1)
+        return TileCombo::FanShot;
+    if (counts[character + 1] == 3)
+        return TileCombo::SeismicSlam;
+    for (int v = 0; v < 9; ++v)
+    {
+        if (counts[character + v] == 3)
+            return TileCombo::Melee;
+    }
+    for (int v = 0; v + 2 < 9; ++v)
+    {
+        if (counts[character + v] == 1 && counts[character + v + 1] == 1 && counts[character + v + 2] == 1)
+            return TileCombo::Dash;
+    }
+    return TileCombo::None;
+}
+
+// Perfect hash of a sorted triple a <= b <= c onto [0, TRIPLE_COUNT)
+constexpr int TripleRank(int a, int b, int c)
+{
+    return a + (b + 1) * b / 2 + (c + 2) * (c + 1) * c / 6;
+}
+
+constexpr int TRIPLE_COUNT = TripleRank(PLAYABLE_TILE_TYPES - 1, PLAYABLE_TILE_TYPES - 1, PLAYABLE_TILE_TYPES - 1) + 1;
+
+constexpr std::array<TileCombo, TRIPLE_COUNT> BuildTripleTable()
+{
+    std::array<TileCombo, TRIPLE_COUNT> table{};
+    for (int c = 0; c < PLAYABLE_TILE_TYPES; ++c)
+    {
+        for (int b = 0; b <= c; ++b)
+        {
+            for (int a = 0; a <= b; ++a)
+            {
+                TileCounts counts{};
+                ++counts[a];
+                ++counts[b];
+                ++counts[c];
+                table[TripleRank(a, b, c)] = ClassifyCounts(counts);
+            }
+        }
+    }
+    return table;
+}
+
+constexpr std::array<TileCombo, TRIPLE_COUNT> TRIPLE_COMBOS = BuildTripleTable();
+
+constexpr TileCombo LookupTriple(TileType x, TileType y, TileType z)
+{
+    // Three-element sorting network; std::swap is not constexpr before C++20
+    int a = Index(x), b = Index(y), c = Index(z);
+    int lo = a < b ? a : b, hi = a < b ? b : a;
+    a = lo;
+    b = hi;
+    lo = b < c ? b : c;
+    hi = b < c ? c : b;
+    b = lo;
+    c = hi;
+    lo = a < b ? a : b;
+    hi = a < b ? b : a;
+    a = lo;
+    b = hi;
+    return TRIPLE_COMBOS[TripleRank(a, b, c)];
+}
+
+static_assert(TRIPLE_COUNT == PLAYABLE_TILE_TYPES * (PLAYABLE_TILE_TYPES + 1) * (PLAYABLE_TILE_TYPES + 2) / 6, "one entry per multiset of three tiles");
+static_assert(LookupTriple(TileType::DOT_1, TileType::DOT_1, TileType::DOT_1) == TileCombo::GravityWell, "");
+static_assert(LookupTriple(TileType::DOT_3, TileType::DOT_1, TileType::DOT_2) == TileCombo::ChainLightning, "");
+static_assert(LookupTriple(TileType::BAMBOO_2, TileType::BAMBOO_3, TileType::BAMBOO_1) == TileCombo::FanShot, "");
+static_assert(LookupTriple(TileType::CHARACTER_2, TileType::CHARACTER_2, TileType::CHARACTER_2) == TileCombo::SeismicSlam, "");
+static_assert(LookupTriple(TileType::CHARACTER_7, TileType::CHARACTER_7, TileType::CHARACTER_7) == TileCombo::Melee, "");
+static_assert(LookupTriple(TileType::CHARACTER_9, TileType::CHARACTER_7, TileType::CHARACTER_8) == TileCombo::Dash, "");
+static_assert(LookupTriple(TileType::CHARACTER_1, TileType::CHARACTER_2, TileType::CHARACTER_4) == TileCombo::None, "");
+static_assert(LookupTriple(TileType::DRAGON_RED, TileType::DRAGON_RED, TileType::DRAGON_RED) == TileCombo::None, "");
+}
+
+TileCombo ClassifyTileCombo(const std::vector<SlotTileEntry> &tiles)
+{
+    if (tiles.empty())
+        return TileCombo::None;
+
+    if (tiles.size() >= 3)
+    {
+        const SlotTileEntry &a = tiles[0];
+        const SlotTileEntry &b = tiles[1];
+        const SlotTileEntry &c = tiles[2];
+        if (a.isValid() && b.isValid() && c.isValid() && IsPlayable(a.tile) && IsPlayable(b.tile) && IsPlayable(c.tile))
+        {
+            TileCombo combo = LookupTriple(a.tile, b.tile, c.tile);
+            if (combo != TileCombo::None)
+                return combo;
+        }
+    }
+
+    // Default throw for single valid tile
+    return tiles.front().isValid() ? TileCombo::DefaultThrow : TileCombo::None;
+}
+
+const char *TileComboName(TileCombo combo)
+{
+    switch (combo)
+    {
+    case TileCombo::DefaultThrow:
+        return "DefaultThrow";
+    case TileCombo::GravityWell:
+        return "GravityWell";
+    case TileCombo::OrbitalShield:
+        return "OrbitalShield";
+    case TileCombo::ChainLightning:
+        return "ChainLightning";
+    case TileCombo::BambooTriple:
+        return "BambooTriple";
+    case TileCombo::BambooBomb:
+        return "BambooBomb";
+    case TileCombo::FanShot:
+        return "FanShot";
+    case TileCombo::SeismicSlam:
+        return "SeismicSlam";
+    case TileCombo::Melee:
+        return "Melee";
+    case TileCombo::Dash:
+        return "Dash";
+    case TileCombo::None:
+    default:
+        return "NA";
+    }
+}
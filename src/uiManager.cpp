@@ -3,7 +3,7 @@
 #include "rewardBriefcase.hpp"
 #include "Inventory.hpp"
 #include "scene.hpp"
-#include "attackManager.hpp"
+#include "tileCombo.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -436,6 +436,8 @@ void UIManager::ensureSlotSetup()
         return;
     for (auto &v : attackSlots)
         v.clear();
+    for (auto &r : slotRevisions)
+        ++r;
     for (auto &c : slotCooldowns)
         c = 1.0f; // Ready by default so HUD is not gray on start
     for (auto &v : slotValid)
@@ -498,6 +500,7 @@ void UIManager::beginTileDragFromSlot(int slotIndex, int tileIndex, const Vector
     draggingTile = attackSlots[slotIndex][tileIndex];
     // Remove from slot while dragging
     attackSlots[slotIndex].erase(attackSlots[slotIndex].begin() + tileIndex);
+    ++slotRevisions[slotIndex];
     draggingTilePos = mousePos;
 }
 
@@ -562,6 +565,7 @@ void UIManager::addTileToSlot(int slotIndex, const SlotTileEntry &entry)
             }
         }
         slot.push_back(entry);
+        ++slotRevisions[slotIndex];
     }
 }
 
@@ -610,8 +614,7 @@ void UIManager::updatePauseMenu(Inventory &playerInventory)
         else
         {
             // 3+ tiles: check if valid combo (not DefaultThrow or NA)
-            std::string attackType = AttackManager::classifyAttackType(attackSlots[s]);
-            slotValid[s] = (attackType != "NA" && attackType != "DefaultThrow");
+            slotValid[s] = IsSkillCombo(ClassifyTileCombo(attackSlots[s]));
         }
     }
     muim.update(playerInventory);
@@ -0,0 +1,244 @@
+#include "worldEvents.hpp"
+#include <algorithm>
+#include "me.hpp"
+#include "scene.hpp"
+
+ParticleRequest ParticleRequest::Explosion(Vector3 center, int count, Color color, float size, float speed, float spread)
+{
+    ParticleRequest r;
+    r.kind = Kind::Explosion;
+    r.center = center;
+    r.count = count;
+    r.color = color;
+    r.size = size;
+    r.speed = speed;
+    r.spread = spread;
+    return r;
+}
+
+ParticleRequest ParticleRequest::Directional(Vector3 center, Vector3 direction, int count, Color color, float speed, float spread)
+{
+    ParticleRequest r;
+    r.kind = Kind::Directional;
+    r.center = center;
+    r.direction = direction;
+    r.count = count;
+    r.color = color;
+    r.speed = speed;
+    r.spread = spread;
+    return r;
+}
+
+ParticleRequest ParticleRequest::Spiral(Vector3 center, float radius, int count, Color color, float height, float speed)
+{
+    ParticleRequest r;
+    r.kind = Kind::Spiral;
+    r.center = center;
+    r.radius = radius;
+    r.count = count;
+    r.color = color;
+    r.height = height;
+    r.speed = speed;
+    return r;
+}
+
+ParticleRequest ParticleRequest::Ring(Vector3 center, float radius, int count, Color color, float speed, bool upward)
+{
+    ParticleRequest r;
+    r.kind = Kind::Ring;
+    r.center = center;
+    r.radius = radius;
+    r.count = count;
+    r.color = color;
+    r.speed = speed;
+    r.upward = upward;
+    return r;
+}
+
+void WorldEventQueue::Batch::clear()
+{
+    this->effects.clear();
+    this->spawns.clear();
+    this->despawns.clear();
+    this->particles.clear();
+}
+
+void WorldEventQueue::RecordEffect(const Enemy *target, EnemyEffect effect)
+{
+    if (!target)
+        return;
+
+    effect.target = target->getHandle();
+    std::lock_guard<std::mutex> lock(this->mutex);
+    effect.sequence = this->nextSequence++;
+    this->pending.effects.push_back(effect);
+}
+
+void WorldEventQueue::Damage(const Enemy *target, float amount)
+{
+    EnemyEffect effect;
+    effect.damage = amount;
+    this->RecordEffect(target, effect);
+}
+
+void WorldEventQueue::Knockback(const Enemy *target, const Vector3 &push, float durationSeconds, float lift)
+{
+    EnemyEffect effect;
+    effect.push = push;
+    effect.knockbackDuration = durationSeconds;
+    effect.lift = lift;
+    this->RecordEffect(target, effect);
+}
+
+void WorldEventQueue::Stun(const Enemy *target, float durationSeconds)
+{
+    EnemyEffect effect;
+    effect.stun = durationSeconds;
+    this->RecordEffect(target, effect);
+}
+
+void WorldEventQueue::Electrocute(const Enemy *target, float durationSeconds)
+{
+    EnemyEffect effect;
+    effect.electrocute = durationSeconds;
+    this->RecordEffect(target, effect);
+}
+
+void WorldEventQueue::Spawn(Enemy *enemy)
+{
+    if (!enemy)
+        return;
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->pending.spawns.push_back(enemy);
+}
+
+void WorldEventQueue::Despawn(EntityHandle handle)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->pending.despawns.push_back(handle);
+}
+
+void WorldEventQueue::Particles(const ParticleRequest &request)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->pending.particles.push_back(request);
+}
+
+void WorldEventQueue::Flush(UpdateContext &uc)
+{
+    if (!uc.scene)
+        return;
+
+    for (int round = 0; round < MAX_FLUSH_ROUNDS; ++round)
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (this->pending.empty())
+                return;
+            std::swap(this->pending, this->applying);
+        }
+        this->Apply(uc);
+        this->applying.clear();
+    }
+
+    // Death handlers that keep recording events would otherwise never finish
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (!this->pending.empty())
+    {
+        TraceLog(LOG_WARNING, "WorldEventQueue: events still pending after %d flush rounds, applying next tick", MAX_FLUSH_ROUNDS);
+    }
+}
+
+void WorldEventQueue::Apply(UpdateContext &uc)
+{
+    EnemyManager &em = uc.scene->em;
+
+    // New enemies first, so effects recorded against them in the same tick land
+    for (Enemy *e : this->applying.spawns)
+    {
+        em.addEnemy(e);
+    }
+
+    // Group the effects per enemy; the sequence keeps the order stable
+    std::vector<EnemyEffect> &effects = this->applying.effects;
+    std::sort(effects.begin(), effects.end(), [](const EnemyEffect &a, const EnemyEffect &b) {
+        if (a.target.index != b.target.index)
+            return a.target.index < b.target.index;
+        if (a.target.generation != b.target.generation)
+            return a.target.generation < b.target.generation;
+        return a.sequence < b.sequence;
+    });
+
+    for (size_t first = 0; first < effects.size();)
+    {
+        EnemyEffect merged = effects[first];
+        size_t end = first + 1;
+        for (; end < effects.size() && effects[end].target == merged.target; ++end)
+        {
+            const EnemyEffect &e = effects[end];
+            merged.damage += e.damage;
+            merged.push = Vector3Add(merged.push, e.push);
+            merged.knockbackDuration = fmaxf(merged.knockbackDuration, e.knockbackDuration);
+            merged.lift = fmaxf(merged.lift, e.lift);
+            merged.stun = fmaxf(merged.stun, e.stun);
+            merged.electrocute = fmaxf(merged.electrocute, e.electrocute);
+        }
+        first = end;
+
+        Enemy *enemy = em.Get(merged.target);
+        if (!enemy)
+            continue;
+
+        if (merged.damage > 0.0f)
+        {
+            CollisionResult hit{};
+            DamageResult damage(merged.damage, hit);
+            em.damage(enemy, damage, uc);
+            enemy = em.Get(merged.target);
+            if (!enemy)
+                continue;
+        }
+
+        if (merged.knockbackDuration > 0.0f || merged.lift > 0.0f)
+        {
+            enemy->applyKnockback(merged.push, merged.knockbackDuration, merged.lift);
+        }
+        if (merged.stun > 0.0f)
+        {
+            enemy->applyStun(merged.stun);
+        }
+        if (merged.electrocute > 0.0f)
+        {
+            enemy->applyElectrocute(merged.electrocute);
+        }
+    }
+
+    for (EntityHandle handle : this->applying.despawns)
+    {
+        em.RemoveEnemy(handle);
+    }
+
+    ParticleSystem &particles = uc.scene->particles;
+    for (const ParticleRequest &r : this->applying.particles)
+    {
+        if (!r.ifAlive.isNull() && !em.Get(r.ifAlive))
+            continue;
+
+        switch (r.kind)
+        {
+        case ParticleRequest::Kind::Explosion:
+            particles.spawnExplosion(r.center, r.count, r.color, r.size, r.speed, r.spread);
+            break;
+        case ParticleRequest::Kind::Directional:
+            particles.spawnDirectional(r.center, r.direction, r.count, r.color, r.speed, r.spread);
+            break;
+        case ParticleRequest::Kind::Spiral:
+            particles.spawnSpiral(r.center, r.radius, r.count, r.color, r.height, r.speed);
+            break;
+        case ParticleRequest::Kind::Ring:
+            particles.spawnRing(r.center, r.radius, r.count, r.color, r.speed, r.upward);
+            break;
+        }
+    }
+}
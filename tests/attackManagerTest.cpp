@@ -0,0 +1,97 @@
+#include "check.hpp"
+#include "gameFixture.hpp"
+#include <algorithm>
+#include <typeinfo>
+#include <vector>
+
+// AttackManager keeps one controller slot per AttackKind and owner. Every
+// getter must land in its own slot and hand back a controller of its own
+// class, the same one each time. update() must reach fetched controllers,
+// and a pooled enemy reusing a dead one's address must not inherit its
+// controllers.
+
+namespace
+{
+template <typename T>
+bool FetchesOwnController(AttackManager &am, T *(AttackManager::*getter)(Entity *), Entity *owner,
+                          std::vector<AttackController *> &seen)
+{
+    T *controller = (am.*getter)(owner);
+    if (!CHECK(controller != nullptr))
+        return false;
+    bool ok = CHECK(typeid(*controller) == typeid(T)) &&
+              CHECK(controller->spawnedBy == owner) &&
+              CHECK((am.*getter)(owner) == controller) &&
+              CHECK(std::find(seen.begin(), seen.end(), controller) == seen.end());
+    if (!ok)
+        printf("    for %s\n", typeid(T).name());
+    seen.push_back(controller);
+    return ok;
+}
+
+bool FetchesEveryKind(AttackManager &am, Entity *owner, std::vector<AttackController *> &seen)
+{
+    size_t before = seen.size();
+    bool ok = FetchesOwnController(am, &AttackManager::getBasicTileAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getMeleePushAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getDashAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getBambooBombAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getBambooTripleAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getDragonClawAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getArcaneOrbAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getFanShotAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getSeismicSlamAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getGravityWellAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getChainLightningAttack, owner, seen) &&
+              FetchesOwnController(am, &AttackManager::getOrbitalShieldAttack, owner, seen);
+    return ok && CHECK(seen.size() - before == (size_t)AttackKind::Count);
+}
+}
+
+TEST_CASE(AttackRegistryKeepsOneControllerPerKindAndOwner)
+{
+    GameFixture game;
+    ChargingEnemy *enemy = game.SpawnEnemy<ChargingEnemy>(5.0f, 0.0f);
+
+    // Twelve distinct controllers for the player, and twelve more for the enemy
+    std::vector<AttackController *> seen;
+    if (!FetchesEveryKind(game.scene.am, &game.player, seen))
+        return;
+    FetchesEveryKind(game.scene.am, enemy, seen);
+}
+
+TEST_CASE(AttackRegistryUpdatesFetchedControllers)
+{
+    GameFixture game;
+    BambooBasicAttack *basic = game.scene.am.getBasicTileAttack(&game.player);
+    UpdateContext uc = game.Context();
+    basic->spawnProjectile(uc);
+    if (!CHECK(!basic->canShoot()))
+        return;
+
+    // The cooldown only runs down if update() reaches the controller
+    game.Step(60);
+    CHECK(basic->canShoot());
+    CHECK(game.scene.am.getBasicTileAttack(&game.player) == basic);
+}
+
+TEST_CASE(AttackRegistryReleasesDeadEnemyControllers)
+{
+    GameFixture game;
+    ChargingEnemy *dead = game.SpawnEnemy<ChargingEnemy>(5.0f, 0.0f);
+    UpdateContext uc = game.Context();
+    game.scene.am.getBasicTileAttack(dead)->spawnProjectile(uc);
+    if (!CHECK(!game.scene.am.getBasicTileAttack(dead)->canShoot()))
+        return;
+
+    game.scene.em.RemoveEnemy(dead);
+    ChargingEnemy *spawned = game.SpawnEnemy<ChargingEnemy>(5.0f, 0.0f);
+    if (!CHECK(spawned == dead))
+        return;
+
+    // The old controller is still cooling down; the new enemy must not see it,
+    // neither before update() has noticed the death nor after
+    CHECK(game.scene.am.getBasicTileAttack(spawned)->canShoot());
+    game.Step();
+    CHECK(game.scene.am.getBasicTileAttack(spawned)->canShoot());
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief Minimal self-registering benchmark runner for the run_bench executable.
+ *
+ * BENCHMARK(name) defines a benchmark and registers it before main() runs;
+ * each one prints its own table. Time() returns the best of several runs so
+ * a single scheduler hiccup does not skew the numbers.
+ */
+namespace bench
+{
+struct Benchmark
+{
+    const char *name;
+    void (*run)();
+};
+
+std::vector<Benchmark> &Registry();
+
+struct Registrar
+{
+    Registrar(const char *name, void (*run)()) { Registry().push_back({name, run}); }
+};
+
+inline volatile double sink = 0.0;
+
+/**
+ * @brief Store a checksum of the measured work so the optimizer cannot drop it.
+ */
+inline void Keep(double checksum)
+{
+    sink = checksum;
+}
+
+/**
+ * @brief Seconds taken by the fastest of `trials` calls to `run`.
+ */
+template <typename Fn>
+double Time(int trials, Fn &&run)
+{
+    double best = 1e30;
+    for (int i = 0; i < trials; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+}
+
+#define BENCHMARK(name)                                         \
+    static void name();                                         \
+    static bench::Registrar name##Registrar(#name, &name);      \
+    static void name()
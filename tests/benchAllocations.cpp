@@ -0,0 +1,159 @@
+#include "bench.hpp"
+#include "gameFixture.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Heap allocations per frame on the entity and object iteration paths, and
+// across whole simulation ticks and pooled spawn/kill cycles, once a fight
+// has warmed the pools. A counting global operator new covers the whole
+// run_bench process; the other benchmarks only pay one relaxed increment
+// per allocation.
+
+namespace
+{
+std::atomic<size_t> allocationCount{0};
+}
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+constexpr int WARMUP_TICKS = 600;
+constexpr int MEASURED_TICKS = 300;
+
+// Allocations made by `run` over `frames` calls, per call
+template <typename Fn>
+double AllocationsPerFrame(int frames, Fn &&run)
+{
+    size_t before = allocationCount.load(std::memory_order_relaxed);
+    for (int i = 0; i < frames; ++i)
+        run();
+    return (double)(allocationCount.load(std::memory_order_relaxed) - before) / frames;
+}
+
+// A room's worth of enemies around the player, with the pools warmed as room spawning does.
+// Summoners keep adding minions, so the fight only stays the same size without them.
+void SpawnFight(GameFixture &game, bool withSummoners)
+{
+    const size_t summoners = withSummoners ? 4 : 0;
+    const size_t minions = summoners * SummonerEnemy::MINION_GROUP_SIZE * 2;
+    game.scene.em.reserveEnemies<MinionEnemy>(minions);
+    game.scene.em.reserveHealthDialogs(20 + minions);
+
+    const float ring = 8.0f;
+    for (int i = 0; i < 4; ++i)
+    {
+        float angle = i * PI * 0.5f;
+        float x = cosf(angle) * ring;
+        float z = sinf(angle) * ring;
+        game.SpawnEnemy<ChargingEnemy>(x, z);
+        game.SpawnEnemy<ShooterEnemy>(x * 1.5f, z * 1.5f);
+        game.SpawnEnemy<SupportEnemy>(x * 1.2f, z * 1.2f + 2.0f);
+        game.SpawnEnemy<VanguardEnemy>(x * 0.8f + 2.0f, z * 0.8f - 2.0f);
+        if (withSummoners)
+            game.SpawnEnemy<SummonerEnemy>(x * 1.8f + 2.0f, z * 1.8f);
+    }
+}
+
+size_t CountEnemies(const GameFixture &game)
+{
+    size_t count = 0;
+    for (Enemy *e : game.scene.em.viewEnemies())
+    {
+        (void)e;
+        ++count;
+    }
+    return count;
+}
+}
+
+BENCHMARK(SteadyStateAllocations)
+{
+    GameFixture game;
+    SpawnFight(game, false);
+    game.Step(WARMUP_TICKS);
+    printf("%zu enemies and %zu projectiles after %d warm-up ticks\n", CountEnemies(game), game.scene.projectiles.size(), WARMUP_TICKS);
+    printf("  %-44s %12s\n", "", "allocs/frame");
+
+    double checksum = 0.0;
+    auto report = [](const char *name, double perFrame) { printf("  %-44s %12.3f\n", name, perFrame); };
+
+    report("EnemyManager::viewEnemies()", AllocationsPerFrame(MEASURED_TICKS, [&]
+    {
+        for (Enemy *e : game.scene.em.viewEnemies())
+            checksum += e->pos().x;
+    }));
+    report("Scene::visitEntities(ENTITY_ALL)", AllocationsPerFrame(MEASURED_TICKS, [&]
+    {
+        game.scene.visitEntities(ENTITY_ALL, [&](Entity *e) { checksum += e->pos().y; });
+    }));
+    report("EnemyManager::visitObjects()", AllocationsPerFrame(MEASURED_TICKS, [&]
+    {
+        game.scene.em.visitObjects([&](Object *o) { checksum += o->pos.z; });
+    }));
+    report("Scene::QueryCollisionCandidates() per enemy", AllocationsPerFrame(MEASURED_TICKS, [&]
+    {
+        for (Enemy *e : game.scene.em.viewEnemies())
+        {
+            const OBB &body = e->obj().obb;
+            game.scene.QueryCollisionCandidates(OBB_GetBoundingBox(&body), [&](Entity *other) { checksum += other->pos().x; });
+        }
+    }));
+    report("vector gathered per call (old getEntities())", AllocationsPerFrame(MEASURED_TICKS, [&]
+    {
+        std::vector<Entity *> gathered;
+        game.scene.visitEntities(ENTITY_ALL, [&](Entity *e) { gathered.push_back(e); });
+        checksum += (double)gathered.size();
+    }));
+    report("whole tick: player, enemies, attacks, projectiles", AllocationsPerFrame(MEASURED_TICKS, [&] { game.Step(); }));
+
+    // One of each pooled type spawned, bound to its Bullet proxy as its first contact query does, then killed
+    std::vector<CollisionResult> contacts;
+    auto spawnKillCycle = [&]
+    {
+        Enemy *spawned[] = {
+            game.SpawnEnemy<ChargingEnemy>(3.0f, 3.0f),
+            game.SpawnEnemy<ShooterEnemy>(-3.0f, 3.0f),
+            game.SpawnEnemy<SupportEnemy>(3.0f, -3.0f),
+            game.SpawnEnemy<VanguardEnemy>(-3.0f, -3.0f),
+            game.SpawnEnemy<SummonerEnemy>(0.0f, 4.0f),
+        };
+        for (Enemy *e : spawned)
+        {
+            contacts.clear();
+            game.scene.CollectDecorationCollisions(e->obj(), contacts);
+            game.scene.em.RemoveEnemy(e);
+        }
+    };
+    spawnKillCycle();
+    report("spawn/kill cycle of five pooled enemies", AllocationsPerFrame(MEASURED_TICKS, spawnKillCycle));
+    bench::Keep(checksum);
+
+    // Lists grow with the minion count, so this one never settles at zero
+    GameFixture growing;
+    SpawnFight(growing, true);
+    growing.Step(WARMUP_TICKS);
+    size_t before = CountEnemies(growing);
+    double perTick = AllocationsPerFrame(MEASURED_TICKS, [&] { growing.Step(); });
+    char name[64];
+    snprintf(name, sizeof(name), "whole tick with summoners (%zu -> %zu enemies)", before, CountEnemies(growing));
+    report(name, perTick);
+}
@@ -0,0 +1,28 @@
+#include "bench.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace bench
+{
+std::vector<Benchmark> &Registry()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+}
+
+// Runs every registered benchmark, or only those whose name contains argv[1]
+int main(int argc, char **argv)
+{
+    const char *filter = argc > 1 ? argv[1] : nullptr;
+    for (const bench::Benchmark &benchmark : bench::Registry())
+    {
+        if (filter && !strstr(benchmark.name, filter))
+            continue;
+
+        printf("== %s\n", benchmark.name);
+        benchmark.run();
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "bench.hpp"
+#include "obbBatch.hpp"
+#include <cstdio>
+#include <random>
+
+// OBB-vs-OBB SAT throughput: the original test that rebuilt the rotation
+// matrix for every projection, the cached-axes GetCollisionOBBvsOBB(), and
+// the batch kernel in its scalar and SSE forms. Each query box is tested
+// against a batch of targets, as enemies are against their grid candidates.
+
+namespace
+{
+constexpr int QUERY_COUNT = 256;
+constexpr int TARGET_COUNT = 64;
+
+// The projection before OBBs cached their axes: one QuaternionToMatrix() per call
+void ProjectUncached(const OBB *obb, Vector3 axis, float *outMin, float *outMax)
+{
+    Matrix rot = QuaternionToMatrix(obb->rotation);
+    Vector3 right = {rot.m0, rot.m1, rot.m2};
+    Vector3 up = {rot.m4, rot.m5, rot.m6};
+    Vector3 forward = {rot.m8, rot.m9, rot.m10};
+
+    float centerProj = Vector3DotProduct(obb->center, axis);
+    float r = fabsf(Vector3DotProduct(right, axis)) * obb->halfExtents.x +
+              fabsf(Vector3DotProduct(up, axis)) * obb->halfExtents.y +
+              fabsf(Vector3DotProduct(forward, axis)) * obb->halfExtents.z;
+    *outMin = centerProj - r;
+    *outMax = centerProj + r;
+}
+
+// GetCollisionOBBvsOBB() as it was before OBBs cached their axes
+CollisionResult GetCollisionUncached(const OBB *a, const OBB *b)
+{
+    CollisionResult result = {nullptr, true, INFINITY, {0, 0, 0}};
+
+    Vector3 axesA[3], axesB[3];
+    for (const OBB *box : {a, b})
+    {
+        Matrix rot = QuaternionToMatrix(box->rotation);
+        Vector3 *axes = (box == a) ? axesA : axesB;
+        axes[0] = {rot.m0, rot.m1, rot.m2};
+        axes[1] = {rot.m4, rot.m5, rot.m6};
+        axes[2] = {rot.m8, rot.m9, rot.m10};
+    }
+
+    Vector3 testAxes[15];
+    int axisCount = 0;
+    for (int i = 0; i < 3; ++i)
+        testAxes[axisCount++] = axesA[i];
+    for (int i = 0; i < 3; ++i)
+        testAxes[axisCount++] = axesB[i];
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            Vector3 cross = Vector3CrossProduct(axesA[i], axesB[j]);
+            if (Vector3LengthSqr(cross) > 0.0001f)
+                testAxes[axisCount++] = Vector3Normalize(cross);
+        }
+    }
+
+    for (int i = 0; i < axisCount; ++i)
+    {
+        float minA, maxA, minB, maxB;
+        ProjectUncached(a, testAxes[i], &minA, &maxA);
+        ProjectUncached(b, testAxes[i], &minB, &maxB);
+        if (maxA < minB || maxB < minA)
+        {
+            result.collided = false;
+            return result;
+        }
+        float overlap = fminf(maxA, maxB) - fmaxf(minA, minB);
+        if (overlap < result.penetration)
+        {
+            result.penetration = overlap;
+            result.normal = testAxes[i];
+        }
+    }
+
+    if (Vector3DotProduct(Vector3Subtract(b->center, a->center), result.normal) > 0)
+        result.normal = Vector3Negate(result.normal);
+    return result;
+}
+
+OBB RandomBox(std::mt19937 &rng, float spread)
+{
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> size(0.2f, 1.5f);
+    OBB box;
+    box.center = {unit(rng) * spread, unit(rng) * spread, unit(rng) * spread};
+    box.halfExtents = {size(rng), size(rng), size(rng)};
+    Vector3 axis = Vector3Normalize({unit(rng), unit(rng) + 1.5f, unit(rng)}); // Never zero
+    OBB_SetRotation(&box, QuaternionFromAxisAngle(axis, unit(rng) * PI));
+    return box;
+}
+
+void Run(const char *label, float spread)
+{
+    std::mt19937 rng(42u);
+    std::vector<OBB> queries;
+    std::vector<OBB> targets;
+    OBBBatch batch;
+    for (int i = 0; i < QUERY_COUNT; ++i)
+        queries.push_back(RandomBox(rng, spread));
+    for (int i = 0; i < TARGET_COUNT; ++i)
+    {
+        targets.push_back(RandomBox(rng, spread));
+        batch.Add(targets.back());
+    }
+
+    int hits = 0;
+    for (const OBB &q : queries)
+        for (const OBB &t : targets)
+            hits += GetCollisionOBBvsOBB(&q, &t).collided ? 1 : 0;
+
+    double checksum = 0.0;
+    std::vector<CollisionResult> results;
+    auto sum = [&checksum](const CollisionResult &r) { checksum += r.collided ? r.penetration : 0.0f; };
+
+    double uncached = bench::Time(20, [&]
+    {
+        for (const OBB &q : queries)
+            for (const OBB &t : targets)
+                sum(GetCollisionUncached(&q, &t));
+    });
+    double cached = bench::Time(20, [&]
+    {
+        for (const OBB &q : queries)
+            for (const OBB &t : targets)
+                sum(GetCollisionOBBvsOBB(&q, &t));
+    });
+    double batchScalar = bench::Time(20, [&]
+    {
+        for (const OBB &q : queries)
+        {
+            GetCollisionOBBvsOBBBatchScalar(&q, batch, results);
+            sum(results.back());
+        }
+    });
+    double batchSimd = bench::Time(20, [&]
+    {
+        for (const OBB &q : queries)
+        {
+            GetCollisionOBBvsOBBBatch(&q, batch, results);
+            sum(results.back());
+        }
+    });
+    bench::Keep(checksum);
+
+    const double pairs = (double)QUERY_COUNT * TARGET_COUNT;
+    printf("%s: %.0f%% of pairs collide\n", label, 100.0 * hits / pairs);
+    printf("  %-22s %8s %12s %9s\n", "", "ns/pair", "Mpairs/s", "speedup");
+    const struct
+    {
+        const char *name;
+        double seconds;
+    } rows[] = {{"uncached axes (before)", uncached},
+                {"cached axes", cached},
+                {"batch scalar", batchScalar},
+                {"batch SSE", batchSimd}};
+    for (const auto &row : rows)
+    {
+        printf("  %-22s %8.1f %12.1f %8.1fx\n", row.name, row.seconds * 1e9 / pairs, pairs / row.seconds * 1e-6, uncached / row.seconds);
+    }
+}
+}
+
+BENCHMARK(ObbPairThroughput)
+{
+    Run("crowded", 2.0f);
+    Run("sparse", 8.0f);
+}
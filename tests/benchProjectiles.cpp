@@ -0,0 +1,101 @@
+#include "bench.hpp"
+#include "gameFixture.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+// ProjectileWorld::Update() with 10,000 live bullets around the player and a
+// room's worth of enemies. Bullets that hit something or expire are topped
+// up between ticks, outside the timing, so every measured tick starts full.
+
+namespace
+{
+constexpr size_t BULLET_COUNT = 10000;
+constexpr int MEASURED_TICKS = 200;
+
+void TopUp(ProjectileWorld &world, ProjectileKindId kind, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<float> spread(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> height(0.5f, 3.0f);
+    std::uniform_real_distribution<float> angle(-PI, PI);
+    std::uniform_real_distribution<float> speed(8.0f, 20.0f);
+    while (world.size() < BULLET_COUNT)
+    {
+        ProjectileSpawn spawn;
+        spawn.position = {spread(rng), height(rng), spread(rng)};
+        float a = angle(rng);
+        float s = speed(rng);
+        spawn.velocity = {cosf(a) * s, 0.0f, sinf(a) * s};
+        spawn.damage = 1.0f;
+        world.Spawn(kind, spawn);
+    }
+}
+
+void Run(const char *label, const ProjectileKind &kind)
+{
+    GameFixture game;
+    for (int i = 0; i < 20; ++i)
+    {
+        float a = i * 2.0f * PI / 20.0f;
+        game.SpawnEnemy<ChargingEnemy>(cosf(a) * 12.0f, sinf(a) * 12.0f);
+    }
+    game.Step(); // Bins the enemies into the grid
+
+    ProjectileWorld &world = game.scene.projectiles;
+    ProjectileKindId id = world.RegisterKind(kind);
+    std::mt19937 rng(5u);
+    std::vector<double> ms;
+    size_t replaced = 0;
+    for (int tick = 0; tick < MEASURED_TICKS + 10; ++tick)
+    {
+        TopUp(world, id, rng);
+        UpdateContext uc = game.Context();
+        auto start = std::chrono::steady_clock::now();
+        world.Update(uc);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (tick >= 10) // The first ticks warm the caches and grow the columns
+        {
+            ms.push_back(elapsed.count());
+            replaced += BULLET_COUNT - world.size();
+        }
+    }
+
+    std::sort(ms.begin(), ms.end());
+    double mean = 0.0;
+    for (double t : ms)
+        mean += t;
+    mean /= ms.size();
+    printf("  %-24s %9.3f %9.3f %9.3f %9.1f %12.1f\n", label, mean, ms[ms.size() / 2], ms.back(),
+           mean * 1e6 / BULLET_COUNT, (double)replaced / ms.size());
+}
+}
+
+BENCHMARK(ProjectileWorldTenThousand)
+{
+    printf("%zu bullets, 20 enemies, %u job workers\n", BULLET_COUNT, JobSystem().workerCount());
+    printf("  %-24s %9s %9s %9s %9s %12s\n", "", "mean ms", "median ms", "max ms", "ns/bullet", "removed/tick");
+
+    ProjectileKind straight;
+    straight.radius = 0.1f;
+    straight.lifetime = 2.0f;
+    Run("straight", straight);
+
+    ProjectileKind homing = straight;
+    homing.homingBlend = 0.1f;
+    homing.homingRange = 20.0f;
+    homing.wiggleAmplitude = 2.0f;
+    homing.wiggleFrequency = 10.0f;
+    Run("homing and wiggling", homing);
+
+    ProjectileKind lobbed = straight;
+    lobbed.gravity = 9.8f;
+    lobbed.hitsGround = true;
+    lobbed.groundHeight = 0.2f;
+    Run("lobbed onto the ground", lobbed);
+
+    ProjectileKind hostile = straight;
+    hostile.collidesWith = COLLISION_MASK_STATIC | COLLISION_LAYER_PLAYER;
+    hostile.damages = COLLISION_LAYER_PLAYER;
+    Run("enemy fire at the player", hostile);
+}
@@ -0,0 +1,96 @@
+#include "bench.hpp"
+#include "gameFixture.hpp"
+#include "spatialGrid.hpp"
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+// Per-tick enemy collision cost with the SpatialGrid broadphase against the
+// all-pairs loop it replaced. Enemies stand on a jittered lattice at a fixed
+// density, so away from the lattice's edges each one has the same number of
+// neighbours: the grid's cost per enemy levels off as the edges stop
+// mattering, while all-pairs grows linearly with the count.
+
+namespace
+{
+constexpr float LATTICE_SPACING = 3.0f;
+constexpr float LATTICE_JITTER = 1.0f;
+
+// Every enemy queried against the grid, as Object::collided() does, then the narrowphase on the candidates
+double GridTick(SpatialGrid &grid, const std::vector<Enemy *> &enemies, size_t *outCandidates)
+{
+    size_t candidates = 0;
+    double checksum = 0.0;
+    grid.Rebuild(enemies);
+    for (Enemy *e : enemies)
+    {
+        const OBB &body = e->obj().obb;
+        grid.Query(OBB_GetBoundingBox(&body), [&](Entity *other)
+        {
+            if (other == e)
+                return;
+            ++candidates;
+            CollisionResult result = GetCollisionOBBvsOBB(&body, &other->obj().obb);
+            if (result.collided)
+                checksum += result.penetration;
+        });
+    }
+    *outCandidates = candidates;
+    return checksum;
+}
+
+// The narrowphase against every other enemy, as before the broadphase existed
+double AllPairsTick(const std::vector<Enemy *> &enemies)
+{
+    double checksum = 0.0;
+    for (Enemy *e : enemies)
+    {
+        const OBB &body = e->obj().obb;
+        for (Enemy *other : enemies)
+        {
+            if (other == e)
+                continue;
+            CollisionResult result = GetCollisionOBBvsOBB(&body, &other->obj().obb);
+            if (result.collided)
+                checksum += result.penetration;
+        }
+    }
+    return checksum;
+}
+}
+
+BENCHMARK(SpatialGridScaling)
+{
+    GameFixture game;
+    SpatialGrid grid;
+    std::vector<Enemy *> enemies;
+    std::mt19937 rng(1234u);
+    std::uniform_real_distribution<float> jitter(-LATTICE_JITTER, LATTICE_JITTER);
+
+    printf("%8s %13s %14s %11s %13s %19s\n", "enemies", "grid us/tick", "grid ns/enemy", "candidates", "ns/candidate", "all-pairs ns/enemy");
+    for (size_t count : {10, 50, 200, 500, 1000, 2000})
+    {
+        int side = (int)ceilf(sqrtf((float)count));
+        while (enemies.size() < count)
+        {
+            enemies.push_back(game.SpawnEnemy<ChargingEnemy>(0.0f, 0.0f));
+        }
+        // Lay the lattice out again for this side length so the density stays the same
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vector3 pos = enemies[i]->pos();
+            pos.x = 100.0f + (i % side) * LATTICE_SPACING + jitter(rng);
+            pos.z = 100.0f + (i / side) * LATTICE_SPACING + jitter(rng);
+            enemies[i]->setPosition(pos);
+        }
+
+        size_t candidates = 0;
+        double checksum = 0.0;
+        double gridSeconds = bench::Time(20, [&] { checksum += GridTick(grid, enemies, &candidates); });
+        double pairsSeconds = bench::Time(count > 500 ? 2 : 10, [&] { checksum += AllPairsTick(enemies); });
+        bench::Keep(checksum);
+
+        printf("%8zu %13.1f %14.1f %11.1f %13.1f %19.1f\n", count, gridSeconds * 1e6, gridSeconds * 1e9 / count,
+               (double)candidates / count, gridSeconds * 1e9 / (double)candidates, pairsSeconds * 1e9 / count);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+/**
+ * @brief Minimal self-registering test runner for the tests/ executable.
+ *
+ * TEST_CASE(name) defines a test function and registers it before main()
+ * runs. CHECK() records a failure with its location and returns whether it
+ * passed, so a test keeps going and one run reports every broken
+ * expectation; tests that cannot continue return on a failed CHECK().
+ */
+namespace check
+{
+struct TestCase
+{
+    const char *name;
+    void (*run)();
+};
+
+std::vector<TestCase> &Registry();
+
+/**
+ * @brief Print a failure for `expression` when `passed` is false; returns `passed`.
+ */
+bool Report(bool passed, const char *expression, const char *file, int line);
+
+/**
+ * @brief Failures reported since the last ResetFailures().
+ */
+int Failures();
+void ResetFailures();
+
+struct Registrar
+{
+    Registrar(const char *name, void (*run)()) { Registry().push_back({name, run}); }
+};
+
+inline bool Near(float a, float b, float tolerance)
+{
+    return fabsf(a - b) <= tolerance * fmaxf(1.0f, fmaxf(fabsf(a), fabsf(b)));
+}
+}
+
+#define TEST_CASE(name)                                         \
+    static void name();                                         \
+    static check::Registrar name##Registrar(#name, &name);      \
+    static void name()
+
+#define CHECK(expression) check::Report((expression), #expression, __FILE__, __LINE__)
+#define CHECK_NEAR(a, b, tolerance) check::Report(check::Near((a), (b), (tolerance)), #a " ~= " #b, __FILE__, __LINE__)
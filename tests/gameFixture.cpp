@@ -0,0 +1,52 @@
+#include "gameFixture.hpp"
+#include "constant.hpp"
+#include "resource_dir.hpp"
+
+GameFixture::Window::Window()
+{
+    static bool ready = false;
+    if (ready)
+        return;
+    ready = true;
+
+    SetTraceLogLevel(LOG_WARNING);
+    if (!IsWindowReady())
+    {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "tests");
+    }
+    SearchAndSetResourceDir("resources");
+    VanguardEnemy::LoadSharedResources();
+    SummonerEnemy::LoadSharedResources();
+}
+
+GameFixture::GameFixture()
+{
+    this->player.setSpawnPosition({0.0f, 0.0f, 0.0f});
+}
+
+UpdateContext GameFixture::Context(float dt)
+{
+    return UpdateContext(&this->scene, &this->player, PlayerInput(0, 0, false, false), nullptr, dt, &this->jobs);
+}
+
+void GameFixture::Step(int ticks)
+{
+    for (int i = 0; i < ticks; ++i)
+    {
+        UpdateContext uc = this->Context();
+        this->player.UpdateBody(uc);
+        this->scene.Update(uc);
+    }
+}
+
+void GameFixture::PlaceEnemy(Enemy *enemy, float x, float z)
+{
+    // Same size and footing as Scene::SpawnEnemiesForRoom()
+    const Vector3 tileSize = Vector3Scale({44.0f, 60.0f, 30.0f}, 0.06f);
+    Vector3 position = {x, this->scene.GetFloorTop() + tileSize.y * 0.5f, z};
+    enemy->obj().size = tileSize;
+    enemy->obj().pos = position;
+    enemy->setPosition(position);
+    this->scene.em.addEnemy(enemy);
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "jobSystem.hpp"
+#include "me.hpp"
+#include "scene.hpp"
+#include "updateContext.hpp"
+
+/**
+ * @brief Headless game for tests and benchmarks that need a Scene.
+ *
+ * Opens a hidden window and loads the shared enemy resources once per
+ * process, then builds the player and the level the way main() does. The
+ * player stands at the origin; nothing is spawned until a room wakes up.
+ */
+class GameFixture
+{
+public:
+    GameFixture();
+
+    /**
+     * @brief Context for one simulation tick of `dt` seconds with no input and no UI.
+     */
+    UpdateContext Context(float dt = 1.0f / 60.0f);
+
+    /**
+     * @brief Create an enemy of type `T` standing on the floor at `x`, `z`, as room spawning does.
+     *
+     * It belongs to no room, so it never sleeps.
+     */
+    template <typename T>
+    T *SpawnEnemy(float x, float z)
+    {
+        T *enemy = this->scene.em.createEnemy<T>();
+        this->PlaceEnemy(enemy, x, z);
+        return enemy;
+    }
+
+    /**
+     * @brief Step the player and the scene by `ticks` ticks.
+     */
+    void Step(int ticks = 1);
+
+private:
+    struct Window
+    {
+        Window();
+    };
+
+    void PlaceEnemy(Enemy *enemy, float x, float z);
+
+    Window window; // First, so the scene's models load into a live context
+
+public:
+    JobSystem jobs;
+    Me player;
+    Scene scene;
+};
@@ -0,0 +1,161 @@
+#include "check.hpp"
+#include "jobSystem.hpp"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+// With zero workers every job runs on the waiting thread in a fixed order,
+// so two runs of the same work must leave identical traces and bit-identical
+// float sums. The same work on a pool must reach the same set of results;
+// only ParallelFor chunk boundaries differ, as they scale with the thread count.
+
+namespace
+{
+struct Trace
+{
+    std::mutex mutex; // Only contended when the system has workers
+    std::vector<std::string> events;
+    std::vector<unsigned int> workers; // Thread index of every job, from the profile hooks
+    float sum = 0.0f;                  // Accumulated in execution order, so it depends on that order
+    std::vector<int> visits = std::vector<int>(1000, 0); // ParallelFor calls per index
+
+    void Record(const std::string &event, float value)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->events.push_back(event);
+        this->sum += value;
+    }
+};
+
+size_t IndexOf(const Trace &trace, const std::string &event)
+{
+    auto it = std::find(trace.events.begin(), trace.events.end(), event);
+    return (size_t)(it - trace.events.begin());
+}
+
+void RunWorkload(JobSystem &jobs, Trace &trace)
+{
+    JobSystem::ProfileHooks hooks;
+    hooks.onJobBegin = [](void *user, const char *, unsigned int worker)
+    {
+        Trace *t = static_cast<Trace *>(user);
+        std::lock_guard<std::mutex> lock(t->mutex);
+        t->workers.push_back(worker);
+    };
+    hooks.user = &trace;
+    jobs.SetProfileHooks(hooks);
+
+    // ParallelFor: one event per chunk, values summed in chunk order
+    jobs.ParallelFor("chunks", 1000, 16, [&trace](size_t first, size_t end)
+    {
+        float partial = 0.0f;
+        for (size_t i = first; i < end; ++i)
+        {
+            partial += 1.0f / (float)(i + 1);
+            ++trace.visits[i]; // Chunks never share an index
+        }
+        trace.Record("chunk " + std::to_string(first), partial);
+    });
+
+    // RunAfter: two stages held back until the three producers are done
+    JobCounter produced;
+    JobCounter consumed;
+    auto producerA = [&trace] { trace.Record("produce a", 0.1f); };
+    auto producerB = [&trace] { trace.Record("produce b", 0.2f); };
+    auto producerC = [&trace] { trace.Record("produce c", 0.3f); };
+    auto consumerA = [&trace] { trace.Record("consume a", 0.7f); };
+    auto consumerB = [&trace] { trace.Record("consume b", 1.1f); };
+    jobs.Run(produced, "produce", producerA);
+    jobs.Run(produced, "produce", producerB);
+    jobs.Run(produced, "produce", producerC);
+    jobs.RunAfter(produced, consumed, "consume", consumerA);
+    jobs.RunAfter(produced, consumed, "consume", consumerB);
+    jobs.WaitFor(consumed);
+
+    // Nested WaitFor: each parent starts children and waits for them inside its own job
+    JobCounter parents;
+    auto parent = [&jobs, &trace](const char *name)
+    {
+        JobCounter children;
+        auto child0 = [&trace, name] { trace.Record(std::string(name) + " child 0", 0.01f); };
+        auto child1 = [&trace, name] { trace.Record(std::string(name) + " child 1", 0.02f); };
+        jobs.Run(children, "child", child0);
+        jobs.Run(children, "child", child1);
+        jobs.WaitFor(children);
+        trace.Record(std::string(name) + " done", 0.05f);
+    };
+    auto parentX = [&parent] { parent("x"); };
+    auto parentY = [&parent] { parent("y"); };
+    jobs.Run(parents, "parent", parentX);
+    jobs.Run(parents, "parent", parentY);
+    jobs.WaitFor(parents);
+
+    jobs.SetProfileHooks(JobSystem::ProfileHooks());
+}
+
+// Order and completeness that hold with any number of workers
+void CheckDependencies(const Trace &trace)
+{
+    size_t lastProducer = std::max({IndexOf(trace, "produce a"), IndexOf(trace, "produce b"), IndexOf(trace, "produce c")});
+    CHECK(lastProducer < trace.events.size());
+    CHECK(IndexOf(trace, "consume a") > lastProducer && IndexOf(trace, "consume a") < trace.events.size());
+    CHECK(IndexOf(trace, "consume b") > lastProducer && IndexOf(trace, "consume b") < trace.events.size());
+    for (const char *name : {"x", "y"})
+    {
+        std::string prefix(name);
+        size_t done = IndexOf(trace, prefix + " done");
+        CHECK(done < trace.events.size());
+        CHECK(IndexOf(trace, prefix + " child 0") < done);
+        CHECK(IndexOf(trace, prefix + " child 1") < done);
+    }
+}
+}
+
+TEST_CASE(JobSystemSingleThreadIsDeterministic)
+{
+    Trace first;
+    Trace second;
+    {
+        JobSystem jobs(0);
+        CHECK(jobs.workerCount() == 0);
+        RunWorkload(jobs, first);
+    }
+    {
+        JobSystem jobs(0);
+        RunWorkload(jobs, second);
+    }
+
+    CHECK(!first.events.empty());
+    CHECK(first.events == second.events);
+    CHECK(memcmp(&first.sum, &second.sum, sizeof(float)) == 0);
+    CHECK(first.workers == second.workers);
+    CHECK(first.visits == std::vector<int>(1000, 1));
+    CHECK(std::all_of(first.workers.begin(), first.workers.end(), [](unsigned int w) { return w == 0; }));
+    CheckDependencies(first);
+}
+
+TEST_CASE(JobSystemWorkersReachTheSameResults)
+{
+    Trace serial;
+    Trace pooled;
+    {
+        JobSystem jobs(0);
+        RunWorkload(jobs, serial);
+    }
+    {
+        JobSystem jobs(3);
+        RunWorkload(jobs, pooled);
+    }
+
+    CheckDependencies(pooled);
+    CHECK(pooled.visits == serial.visits);
+
+    auto withoutChunks = [](std::vector<std::string> events)
+    {
+        events.erase(std::remove_if(events.begin(), events.end(), [](const std::string &e) { return e.compare(0, 6, "chunk ") == 0; }), events.end());
+        std::sort(events.begin(), events.end());
+        return events;
+    };
+    CHECK(withoutChunks(serial.events) == withoutChunks(pooled.events));
+}
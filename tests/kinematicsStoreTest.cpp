@@ -0,0 +1,106 @@
+#include "check.hpp"
+#include "gameFixture.hpp"
+#include "kinematicsStore.hpp"
+#include <vector>
+
+// KinematicsStore::Integrate() must leave every body where
+// Entity::ApplyPhysics() would, whether it lands in an SSE lane or in the
+// scalar tail, and whatever mix of grounded, airborne, stopping and
+// accelerating bodies shares a register. Minions move through the store.
+
+namespace
+{
+class ScalarBody : public Entity
+{
+public:
+    PhysicsParams params;
+
+    void UpdateBody(UpdateContext &uc) override { Entity::ApplyPhysics(this, uc, this->params); }
+    EntityCategory category() const override { return ENTITY_ENEMY; }
+    void setGrounded(bool onGround) { this->grounded = onGround; }
+    KinematicsStore::Body Body() const { return this->BodyFor(this->params); }
+};
+
+bool SameVector(const Vector3 &a, const Vector3 &b)
+{
+    return check::Near(a.x, b.x, 1e-5f) && check::Near(a.y, b.y, 1e-5f) && check::Near(a.z, b.z, 1e-5f);
+}
+}
+
+TEST_CASE(KinematicsStoreMatchesApplyPhysics)
+{
+    // Seven bodies: one full register plus a three-body scalar tail.
+    std::vector<ScalarBody> scalar(7);
+    scalar[0].setDirection({1.0f, 0.0f, 0.0f}); // Grounded, accelerating
+    scalar[1].setVelocity({4.0f, 0.0f, -3.0f}); // Grounded, sliding to a stop
+    scalar[2].setPosition({0.0f, 3.0f, 0.0f});  // Falling onto the floor
+    scalar[2].setVelocity({1.0f, 2.0f, 0.0f});
+    scalar[2].setGrounded(false);
+    scalar[3].setPosition({2.0f, 1.0f, 0.0f});  // Airborne without gravity
+    scalar[3].setVelocity({0.0f, 1.0f, 2.0f});
+    scalar[3].params.useGravity = false;
+    scalar[3].setGrounded(false);
+    scalar[4].setVelocity({0.05f, 0.0f, 0.02f}); // Under the cutoff at once
+    scalar[4].params.zeroThreshold = 0.5f;
+    scalar[5].setDirection({0.6f, 0.0f, 0.8f}); // Cannot accelerate
+    scalar[5].setVelocity({2.0f, 0.0f, 2.0f});
+    scalar[5].params.maxAccel = 0.0f;
+    scalar[6].setPosition({-1.0f, 0.5f, 4.0f}); // Launched from a raised floor
+    scalar[6].setVelocity({-6.0f, 8.0f, 0.0f});
+    scalar[6].setDirection({0.0f, 0.0f, -1.0f});
+    scalar[6].params.floorY = 0.5f;
+    scalar[6].params.decelAir = 0.9f;
+    scalar[6].setGrounded(false);
+
+    KinematicsStore store;
+    std::vector<EntityHandle> handles;
+    for (ScalarBody &body : scalar)
+    {
+        body.params.maxSpeed = 7.5f;
+        handles.push_back(store.Add(body.Body()));
+    }
+    if (!CHECK(store.size() % KinematicsStore::LANES != 0))
+        return;
+
+    // Changing the step length mid-run also exercises the cached drag factors.
+    const float steps[] = {1.0f / 60.0f, 1.0f / 60.0f, 1.0f / 30.0f, 1.0f / 60.0f, 1.0f / 120.0f};
+    for (int tick = 0; tick < 40; ++tick)
+    {
+        float dt = steps[tick % 5];
+        UpdateContext uc(nullptr, nullptr, PlayerInput(0, 0, false, false), nullptr, dt, nullptr);
+        for (ScalarBody &body : scalar)
+            body.UpdateBody(uc);
+        store.Integrate(dt);
+
+        for (size_t i = 0; i < scalar.size(); ++i)
+        {
+            if (!CHECK(SameVector(store.GetPosition(handles[i]), scalar[i].pos())) ||
+                !CHECK(SameVector(store.GetVelocity(handles[i]), scalar[i].vel())) ||
+                !CHECK(store.IsGrounded(handles[i]) == scalar[i].isGrounded()))
+            {
+                printf("    body %zu diverged at tick %d\n", i, tick);
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(MinionsMoveThroughKinematicsStore)
+{
+    GameFixture game;
+    std::vector<MinionEnemy *> minions;
+    for (int i = 0; i < 5; ++i)
+        minions.push_back(game.SpawnEnemy<MinionEnemy>(-6.0f + 3.0f * i, 10.0f));
+
+    std::vector<float> startDistance;
+    for (MinionEnemy *minion : minions)
+        startDistance.push_back(Vector3Distance(minion->pos(), game.player.pos()));
+
+    game.Step(30);
+    for (size_t i = 0; i < minions.size(); ++i)
+    {
+        CHECK(!minions[i]->getKinematicsBody().isNull());
+        CHECK(!minions[i]->isMovementStaged());
+        CHECK(Vector3Distance(minions[i]->pos(), game.player.pos()) < startDistance[i]);
+    }
+}
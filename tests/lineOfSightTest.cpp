@@ -0,0 +1,210 @@
+#include "check.hpp"
+#include "gameFixture.hpp"
+#include "lineOfSight.hpp"
+#include <vector>
+
+// LineOfSightCache must answer like the sweep it memoizes, and forget its
+// answers once SyncRevision() sees a door change. VisibilityField is only a
+// filter: it may rule a pair out only if the exact sweep is blocked, with the
+// doors open or closed.
+
+namespace
+{
+// A wall along x = 0 with a doorway at |z| < 1, and a pillar off to one side
+class Level
+{
+public:
+    bool doorClosed = true;
+
+    bool Blocked(const Vector3 &a, const Vector3 &b) const
+    {
+        const BoundingBox walls[] = {
+            {{-0.2f, 0.0f, -6.0f}, {0.2f, 4.0f, -1.0f}},
+            {{-0.2f, 0.0f, 1.0f}, {0.2f, 4.0f, 6.0f}},
+            {{2.0f, 0.0f, 2.0f}, {3.0f, 4.0f, 3.0f}}};
+        for (const BoundingBox &wall : walls)
+        {
+            if (Crosses(a, b, wall))
+                return true;
+        }
+        return this->doorClosed && Crosses(a, b, {{-0.2f, 0.0f, -1.0f}, {0.2f, 4.0f, 1.0f}});
+    }
+
+private:
+    // XZ slab test of the segment from `a` to `b`
+    static bool Crosses(const Vector3 &a, const Vector3 &b, const BoundingBox &box)
+    {
+        float enter = 0.0f, exit = 1.0f;
+        const float from[] = {a.x, a.z}, delta[] = {b.x - a.x, b.z - a.z};
+        const float lo[] = {box.min.x, box.min.z}, hi[] = {box.max.x, box.max.z};
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if (fabsf(delta[axis]) < 1e-9f)
+            {
+                if (from[axis] < lo[axis] || from[axis] > hi[axis])
+                    return false;
+                continue;
+            }
+            float t0 = (lo[axis] - from[axis]) / delta[axis];
+            float t1 = (hi[axis] - from[axis]) / delta[axis];
+            enter = fmaxf(enter, fminf(t0, t1));
+            exit = fminf(exit, fmaxf(t0, t1));
+        }
+        return enter <= exit;
+    }
+};
+
+// Centers of the unit cells over [-5, 5] x [-5, 5], so cached answers are exact
+std::vector<Vector3> CellCenters()
+{
+    std::vector<Vector3> points;
+    for (int z = -5; z < 5; ++z)
+    {
+        for (int x = -5; x < 5; ++x)
+            points.push_back({x + 0.5f, 0.5f, z + 0.5f});
+    }
+    return points;
+}
+}
+
+TEST_CASE(LineOfSightCacheFollowsDoorRevision)
+{
+    Level level;
+    LineOfSightCache cache(1.0f, 4096);
+    const std::vector<Vector3> points = CellCenters();
+    unsigned int revision = 0;
+
+    for (bool closed : {true, false, true})
+    {
+        if (level.doorClosed != closed)
+        {
+            level.doorClosed = closed;
+            ++revision;
+        }
+        cache.SyncRevision(revision);
+
+        // Twice, so the second pass answers from the table where it can
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (const Vector3 &a : points)
+            {
+                for (const Vector3 &b : points)
+                {
+                    bool cached = cache.IsBlocked(a, b, 0.1f, 0.0f, [&] { return level.Blocked(a, b); });
+                    if (!CHECK(cached == level.Blocked(a, b)))
+                    {
+                        printf("    (%.1f, %.1f) to (%.1f, %.1f) with the door %s\n", a.x, a.z, b.x, b.z, closed ? "closed" : "open");
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    // An unchanged revision keeps the answers
+    const Vector3 west = {-3.5f, 0.5f, 0.5f}, east = {3.5f, 0.5f, -0.5f};
+    int sweeps = 0;
+    auto sweep = [&] { ++sweeps; return level.Blocked(west, east); };
+    cache.IsBlocked(west, east, 0.1f, 0.0f, sweep);
+    cache.SyncRevision(revision);
+    CHECK(cache.IsBlocked(west, east, 0.1f, 0.0f, sweep));
+    CHECK(sweeps <= 1);
+}
+
+TEST_CASE(VisibilityFieldOnlyRulesOutBlockedLines)
+{
+    // Built with the door open, as Scene::BuildRoomVisibility() does
+    Level level;
+    level.doorClosed = false;
+    VisibilityField field;
+    field.Build({{-5.0f, 0.0f, -5.0f}, {5.0f, 4.0f, 5.0f}}, 1.0f, 0.5f,
+                [&](const Vector3 &a, const Vector3 &b) { return level.Blocked(a, b); });
+    if (!CHECK(field.CellCount() == 100))
+        return;
+
+    const std::vector<Vector3> points = CellCenters();
+    for (bool closed : {false, true})
+    {
+        level.doorClosed = closed;
+        int ruledOut = 0;
+        for (const Vector3 &a : points)
+        {
+            for (const Vector3 &b : points)
+            {
+                if (field.MayBeVisible(a, b))
+                    continue;
+                ++ruledOut;
+                if (!CHECK(level.Blocked(a, b)))
+                {
+                    printf("    (%.1f, %.1f) to (%.1f, %.1f) ruled out with the door %s\n", a.x, a.z, b.x, b.z, closed ? "closed" : "open");
+                    return;
+                }
+            }
+        }
+        CHECK(ruledOut > 0);
+    }
+
+    // Through the doorway, and from outside the field
+    CHECK(field.MayBeVisible({-3.5f, 0.5f, 0.5f}, {3.5f, 0.5f, -0.5f}));
+    CHECK(field.MayBeVisible({-20.0f, 0.5f, 0.5f}, {3.5f, 0.5f, -4.5f}));
+}
+
+TEST_CASE(SceneSightLinesMatchUncachedSweepAcrossDoorToggles)
+{
+    GameFixture game;
+    Room *room = game.scene.GetRoomContainingPosition(game.player.pos());
+    if (!CHECK(room != nullptr))
+        return;
+
+    // A grid over the room, reaching a little past its walls and doorways
+    const BoundingBox &bounds = room->GetBounds();
+    std::vector<Vector3> points;
+    for (int i = 0; i <= 6; ++i)
+    {
+        for (int j = 0; j <= 6; ++j)
+        {
+            float x = bounds.min.x - 2.0f + (bounds.max.x - bounds.min.x + 4.0f) * i / 6.0f;
+            float z = bounds.min.z - 2.0f + (bounds.max.z - bounds.min.z + 4.0f) * j / 6.0f;
+            points.push_back({x, 3.0f, z});
+        }
+    }
+
+    auto matches = [&](const char *doors)
+    {
+        for (const Vector3 &a : points)
+        {
+            for (const Vector3 &b : points)
+            {
+                if (!CHECK(game.scene.CheckStaticSweepCached(a, b, 0.1f) == game.scene.CheckStaticSweep(a, b, 0.1f)))
+                {
+                    printf("    (%.1f, %.1f) to (%.1f, %.1f) with the doors %s\n", a.x, a.z, b.x, b.z, doors);
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    for (Door *door : room->GetDoors())
+        door->Close();
+    game.Step();
+    if (!matches("closed"))
+        return;
+
+    // Doors are built from their model; without the resources there are none to toggle
+    if (room->GetDoors().empty())
+        return;
+
+    for (Door *door : room->GetDoors())
+        door->Open();
+    game.Step(120);
+    for (Door *door : room->GetDoors())
+        CHECK(door->IsOpen());
+    if (!matches("open"))
+        return;
+
+    for (Door *door : room->GetDoors())
+        door->Close();
+    game.Step();
+    matches("closed again");
+}
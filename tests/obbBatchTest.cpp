@@ -0,0 +1,209 @@
+#include "check.hpp"
+#include "obbBatch.hpp"
+#include <random>
+
+// GetCollisionOBBvsOBBBatch() (SSE where available) and its scalar twin
+// against the reference GetCollisionOBBvsOBB(), box by box.
+
+namespace
+{
+constexpr float PENETRATION_TOLERANCE = 1e-4f;
+
+class BoxGenerator
+{
+public:
+    explicit BoxGenerator(unsigned int seed) : rng(seed) {}
+
+    float Range(float lo, float hi) { return std::uniform_real_distribution<float>(lo, hi)(this->rng); }
+
+    Quaternion Rotation()
+    {
+        Vector3 axis = {this->Range(-1.0f, 1.0f), this->Range(-1.0f, 1.0f), this->Range(-1.0f, 1.0f)};
+        if (Vector3LengthSqr(axis) < 1e-4f)
+            axis = {0.0f, 1.0f, 0.0f};
+        return QuaternionFromAxisAngle(Vector3Normalize(axis), this->Range(-PI, PI));
+    }
+
+    OBB Box(Quaternion rotation, float spread)
+    {
+        OBB box;
+        box.center = {this->Range(-spread, spread), this->Range(-spread, spread), this->Range(-spread, spread)};
+        box.halfExtents = {this->Range(0.1f, 2.0f), this->Range(0.1f, 2.0f), this->Range(0.1f, 2.0f)};
+        box.rotation = {1.0f, 0.0f, 0.0f, 0.0f}; // Anything else, so OBB_SetRotation() refreshes the axes
+        OBB_SetRotation(&box, rotation);
+        return box;
+    }
+
+    // Shares every axis with `base`, or one axis after a twist about it; both zero some cross products
+    Quaternion ParallelTo(Quaternion base)
+    {
+        int pick = (int)this->Range(0.0f, 4.0f);
+        if (pick >= 3)
+            return base;
+        Vector3 localAxis = {pick == 0 ? 1.0f : 0.0f, pick == 1 ? 1.0f : 0.0f, pick == 2 ? 1.0f : 0.0f};
+        return QuaternionMultiply(base, QuaternionFromAxisAngle(localAxis, this->Range(-PI, PI)));
+    }
+
+private:
+    std::mt19937 rng;
+};
+
+float OverlapAlong(const OBB &a, const OBB &b, Vector3 axis)
+{
+    float minA, maxA, minB, maxB;
+    ProjectOBBOntoAxis(&a, axis, &minA, &maxA);
+    ProjectOBBOntoAxis(&b, axis, &minB, &maxB);
+    return fminf(maxA, maxB) - fmaxf(minA, minB);
+}
+
+// Same verdict as the reference; for hits, the same minimum overlap along a normal that points from b to a
+bool MatchesReference(const OBB &a, const OBB &b, const CollisionResult &got)
+{
+    CollisionResult want = GetCollisionOBBvsOBB(&a, &b);
+    if (want.collided && want.penetration < PENETRATION_TOLERANCE)
+        return true; // Touching: either verdict is fine
+
+    if (got.collided != want.collided)
+        return false;
+    if (!want.collided)
+        return got.penetration == 0.0f && Vector3LengthSqr(got.normal) == 0.0f;
+
+    if (!check::Near(got.penetration, want.penetration, PENETRATION_TOLERANCE))
+        return false;
+    if (fabsf(Vector3Length(got.normal) - 1.0f) > 1e-3f)
+        return false;
+    if (Vector3DotProduct(Vector3Subtract(a.center, b.center), got.normal) < -1e-4f)
+        return false;
+    // Ties may settle on another axis; it must still carry the minimum overlap
+    return check::Near(OverlapAlong(a, b, got.normal), want.penetration, 1e-3f);
+}
+
+// Runs both batch paths for `query` and counts entries that disagree with the reference
+int CountMismatches(const OBB &query, const OBBBatch &batch)
+{
+    std::vector<CollisionResult> simd;
+    std::vector<CollisionResult> scalar;
+    GetCollisionOBBvsOBBBatch(&query, batch, simd);
+    GetCollisionOBBvsOBBBatchScalar(&query, batch, scalar);
+    if (simd.size() != batch.size() || scalar.size() != batch.size())
+        return (int)batch.size() + 1;
+
+    int mismatches = 0;
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        OBB b = batch.Get(i);
+        if (!MatchesReference(query, b, simd[i]))
+            ++mismatches;
+        if (!MatchesReference(query, b, scalar[i]))
+            ++mismatches;
+    }
+    return mismatches;
+}
+}
+
+TEST_CASE(ObbBatchMatchesReferenceOnRandomBoxes)
+{
+    BoxGenerator gen(20240601u);
+    int mismatches = 0;
+    int hits = 0;
+    for (int round = 0; round < 400; ++round)
+    {
+        OBB query = gen.Box(gen.Rotation(), 3.0f);
+        OBBBatch batch;
+        int count = 1 + round % 23; // Most sizes leave padded lanes in the last group
+        for (int i = 0; i < count; ++i)
+        {
+            OBB box = gen.Box(gen.Rotation(), 3.0f);
+            hits += GetCollisionOBBvsOBB(&query, &box).collided ? 1 : 0;
+            batch.Add(box);
+        }
+        mismatches += CountMismatches(query, batch);
+    }
+    CHECK(hits > 500); // The boxes must actually overlap often enough to exercise the penetration path
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE(ObbBatchMatchesReferenceOnParallelEdges)
+{
+    BoxGenerator gen(7u);
+    int mismatches = 0;
+    for (int round = 0; round < 400; ++round)
+    {
+        Quaternion base = (round % 4 == 0) ? QuaternionIdentity() : gen.Rotation();
+        OBB query = gen.Box(base, 2.0f);
+        OBBBatch batch;
+        for (int i = 0; i < 9; ++i)
+        {
+            batch.Add(gen.Box(gen.ParallelTo(base), 2.0f));
+        }
+        mismatches += CountMismatches(query, batch);
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE(ObbBatchSeparatedLanesReportZeroPenetration)
+{
+    BoxGenerator gen(99u);
+    OBB query = gen.Box(gen.Rotation(), 0.0f);
+    OBBBatch batch;
+    for (int i = 0; i < 6; ++i)
+    {
+        OBB far = gen.Box(gen.Rotation(), 1.0f);
+        far.center.x += 50.0f + 10.0f * i;
+        batch.Add(far);
+    }
+
+    std::vector<CollisionResult> simd;
+    std::vector<CollisionResult> scalar;
+    GetCollisionOBBvsOBBBatch(&query, batch, simd);
+    GetCollisionOBBvsOBBBatchScalar(&query, batch, scalar);
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        OBB b = batch.Get(i);
+        CollisionResult reference = GetCollisionOBBvsOBB(&query, &b);
+        // The reference leaves the INFINITY it started from; the batch paths zero it
+        CHECK(!reference.collided && reference.penetration == INFINITY);
+        CHECK(!simd[i].collided && simd[i].penetration == 0.0f && Vector3LengthSqr(simd[i].normal) == 0.0f);
+        CHECK(!scalar[i].collided && scalar[i].penetration == 0.0f && Vector3LengthSqr(scalar[i].normal) == 0.0f);
+    }
+}
+
+TEST_CASE(ObbBatchPaddedLanesNeverCollide)
+{
+    BoxGenerator gen(3u);
+    OBB query;
+    query.halfExtents = {1000.0f, 1000.0f, 1000.0f}; // Overlaps every real box
+
+    OBBBatch batch;
+    for (int i = 0; i < 5; ++i)
+    {
+        batch.Add(gen.Box(gen.Rotation(), 3.0f));
+    }
+    CHECK(batch.size() == 5);
+
+    std::vector<CollisionResult> results;
+    GetCollisionOBBvsOBBBatch(&query, batch, results);
+    CHECK(results.size() == 5);
+    for (const CollisionResult &result : results)
+    {
+        CHECK(result.collided);
+    }
+
+    // AlignToLanes() turns the padding of the second group into real, never-colliding entries
+    batch.AlignToLanes();
+    CHECK(batch.size() == 8);
+    GetCollisionOBBvsOBBBatch(&query, batch, results);
+    for (size_t i = 5; i < 8; ++i)
+    {
+        CHECK(!results[i].collided && results[i].penetration == 0.0f);
+    }
+
+    // A range ending mid-group writes only its own entries
+    CollisionResult out[4 + 1] = {};
+    out[1].penetration = -1.0f;
+    out[4].penetration = -1.0f;
+    GetCollisionOBBvsOBBBatch(&query, batch, 4, 1, out);
+    CHECK(out[0].collided);
+    CHECK(out[1].penetration == -1.0f);
+    CHECK(out[4].penetration == -1.0f);
+}
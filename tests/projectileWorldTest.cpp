@@ -0,0 +1,178 @@
+#include "check.hpp"
+#include "gameFixture.hpp"
+#include "staticWorldBVH.hpp"
+#include <vector>
+
+// Projectiles must hit whatever they already overlap when a tick starts:
+// spawned inside an enemy, the player or a wall, or standing still while an
+// enemy walks onto them. Swept tests alone only see surfaces crossed from
+// outside, so these used to pass straight through. The collision pass also
+// skips projectiles that start far from anything solid; fast ones must still
+// be swept against what they reach within the tick.
+
+namespace
+{
+std::vector<ProjectileImpact> impacts;
+
+void RecordImpact(void *, const ProjectileImpact &impact, UpdateContext &)
+{
+    impacts.push_back(impact);
+}
+
+ProjectileKindId RegisterTestKind(ProjectileWorld &world, unsigned int collidesWith, unsigned int damages)
+{
+    ProjectileKind kind;
+    kind.radius = 0.1f;
+    kind.lifetime = 10.0f;
+    kind.collidesWith = collidesWith;
+    kind.damages = damages;
+    kind.onImpact = &RecordImpact;
+    return world.RegisterKind(kind);
+}
+
+void Tick(GameFixture &game)
+{
+    UpdateContext uc = game.Context();
+    game.scene.projectiles.Update(uc);
+}
+}
+
+TEST_CASE(ProjectileSpawnedInsideEnemyHitsIt)
+{
+    GameFixture game;
+    ChargingEnemy *enemy = game.SpawnEnemy<ChargingEnemy>(6.0f, 0.0f);
+    ProjectileKindId kind = RegisterTestKind(game.scene.projectiles, COLLISION_MASK_STATIC | COLLISION_LAYER_ENEMY, COLLISION_LAYER_ENEMY);
+
+    impacts.clear();
+    ProjectileSpawn spawn;
+    spawn.position = enemy->pos();
+    spawn.velocity = {0.0f, 0.0f, 10.0f}; // Moving out of the body
+    game.scene.projectiles.Spawn(kind, spawn);
+    Tick(game);
+
+    CHECK(game.scene.projectiles.size() == 0);
+    if (!CHECK(impacts.size() == 1))
+        return;
+    CHECK(impacts[0].reason == ProjectileImpact::Reason::Hit);
+    CHECK(impacts[0].hit == enemy);
+    CHECK(Vector3Distance(impacts[0].position, spawn.position) < 1e-4f); // At fraction 0
+}
+
+TEST_CASE(EnemyWalkingOntoProjectileIsHit)
+{
+    GameFixture game;
+    ChargingEnemy *enemy = game.SpawnEnemy<ChargingEnemy>(6.0f, 0.0f);
+    ProjectileKindId kind = RegisterTestKind(game.scene.projectiles, COLLISION_MASK_STATIC | COLLISION_LAYER_ENEMY, COLLISION_LAYER_ENEMY);
+
+    impacts.clear();
+    ProjectileSpawn spawn;
+    spawn.position = Vector3Add(enemy->pos(), {0.0f, 0.0f, 3.0f});
+    game.scene.projectiles.Spawn(kind, spawn); // Standing still
+    Tick(game);
+    CHECK(impacts.empty());
+    CHECK(game.scene.projectiles.size() == 1);
+
+    enemy->setPosition(spawn.position);
+    Tick(game);
+    if (!CHECK(impacts.size() == 1))
+        return;
+    CHECK(impacts[0].reason == ProjectileImpact::Reason::Hit);
+    CHECK(impacts[0].hit == enemy);
+}
+
+TEST_CASE(FastProjectileFromOpenFloorHitsEnemy)
+{
+    GameFixture game;
+    ChargingEnemy *enemy = game.SpawnEnemy<ChargingEnemy>(6.0f, 0.0f);
+    ProjectileKindId kind = RegisterTestKind(game.scene.projectiles, COLLISION_MASK_STATIC | COLLISION_LAYER_ENEMY, COLLISION_LAYER_ENEMY);
+
+    impacts.clear();
+    ProjectileSpawn idle;
+    idle.position = Vector3Add(enemy->pos(), {-20.0f, 0.0f, -20.0f}); // Spreads the cells out
+    game.scene.projectiles.Spawn(kind, idle);
+    ProjectileSpawn fast;
+    fast.position = Vector3Add(enemy->pos(), {-9.0f, 0.0f, 0.0f}); // Many cells away from the enemy
+    fast.velocity = {900.0f, 0.0f, 0.0f};                          // Crosses it within one tick
+    game.scene.projectiles.Spawn(kind, fast);
+    Tick(game);
+
+    CHECK(game.scene.projectiles.size() == 1);
+    if (!CHECK(impacts.size() == 1))
+        return;
+    CHECK(impacts[0].reason == ProjectileImpact::Reason::Hit);
+    CHECK(impacts[0].hit == enemy);
+}
+
+TEST_CASE(ProjectileSpawnedInsidePlayerHitsIt)
+{
+    GameFixture game;
+    ProjectileKindId kind = RegisterTestKind(game.scene.projectiles, COLLISION_MASK_STATIC | COLLISION_LAYER_PLAYER, COLLISION_LAYER_PLAYER);
+
+    impacts.clear();
+    ProjectileSpawn spawn;
+    spawn.position = game.player.obj().obb.center;
+    spawn.velocity = {10.0f, 0.0f, 0.0f};
+    game.scene.projectiles.Spawn(kind, spawn);
+    Tick(game);
+
+    if (!CHECK(impacts.size() == 1))
+        return;
+    CHECK(impacts[0].reason == ProjectileImpact::Reason::Hit);
+    CHECK(impacts[0].hit == &game.player);
+}
+
+TEST_CASE(ProjectileSpawnedInsideWallIsBlocked)
+{
+    GameFixture game;
+    ProjectileKindId kind = RegisterTestKind(game.scene.projectiles, COLLISION_MASK_STATIC | COLLISION_LAYER_ENEMY, COLLISION_LAYER_ENEMY);
+
+    // The first wall straight ahead of the player at chest height
+    Vector3 eye = Vector3Add(game.player.obj().obb.center, {0.0f, 0.2f, 0.0f});
+    Ray ray = {eye, {1.0f, 0.0f, 0.0f}};
+    RayCollision wall = game.scene.GetStaticWorld().Raycast(ray, 1000.0f);
+    if (!CHECK(wall.hit))
+        return;
+
+    impacts.clear();
+    ProjectileSpawn spawn;
+    spawn.position = Vector3Add(wall.point, {0.05f, 0.0f, 0.0f}); // Just past the surface
+    spawn.velocity = {10.0f, 0.0f, 0.0f};
+    game.scene.projectiles.Spawn(kind, spawn);
+    Tick(game);
+
+    if (!CHECK(impacts.size() == 1))
+        return;
+    CHECK(impacts[0].reason == ProjectileImpact::Reason::Blocked);
+    CHECK(impacts[0].hit == nullptr);
+}
+
+TEST_CASE(StaticWorldCastStartingInsideWall)
+{
+    Object wall({2.0f, 2.0f, 2.0f}, {0.0f, 0.0f, 0.0f});
+    wall.UpdateOBB();
+    StaticWorldBVH world;
+    world.Build({&wall}, {});
+
+    // Spheres hit at fraction 0 whichever way they move, with the nearest face's normal
+    SweepHit inside = world.CastSphere({0.8f, 0.0f, 0.0f}, {5.0f, 0.0f, 0.0f}, 0.1f);
+    CHECK(inside.hit && inside.fraction == 0.0f);
+    CHECK(Vector3Distance(inside.normal, {1.0f, 0.0f, 0.0f}) < 1e-5f);
+    SweepHit still = world.CastSphere({0.0f, 0.95f, 0.2f}, {0.0f, 0.0f, 0.0f}, 0.1f);
+    CHECK(still.hit && still.fraction == 0.0f);
+    CHECK(Vector3Distance(still.normal, {0.0f, 1.0f, 0.0f}) < 1e-5f);
+
+    // Boxes overlapping the wall stop only when moving further in
+    OBB box;
+    box.center = {1.2f, 0.0f, 0.0f};
+    box.halfExtents = {0.5f, 0.5f, 0.5f};
+    SweepHit deeper = world.CastOBB(box, {-1.0f, 0.0f, 0.0f});
+    CHECK(deeper.hit && deeper.fraction == 0.0f);
+    CHECK(Vector3Distance(deeper.normal, {1.0f, 0.0f, 0.0f}) < 1e-5f);
+    CHECK(!world.CastOBB(box, {1.0f, 0.0f, 0.0f}).hit);
+    CHECK(!world.CastOBB(box, {0.0f, 0.0f, 1.0f}).hit);
+
+    // Starting outside is unchanged
+    SweepHit outside = world.CastSphere({-3.0f, 0.0f, 0.0f}, {4.0f, 0.0f, 0.0f}, 0.1f);
+    CHECK(outside.hit);
+    CHECK_NEAR(outside.fraction, (3.0f - 1.1f) / 4.0f, 1e-4f);
+}
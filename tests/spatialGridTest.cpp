@@ -0,0 +1,62 @@
+#include "check.hpp"
+#include "gameFixture.hpp"
+#include <algorithm>
+
+// Killed enemies stay binned in the SpatialGrid until the next rebuild, and
+// pooled enemies reuse the addresses of dead ones. A spawn at a recycled
+// address must neither revive the dead entry nor be reported twice, or one
+// attack would damage it twice.
+
+namespace
+{
+int CountCandidates(const GameFixture &game, const Entity *target)
+{
+    const Vector3 &c = target->pos();
+    BoundingBox bounds = {{c.x - 1.0f, c.y - 1.0f, c.z - 1.0f}, {c.x + 1.0f, c.y + 1.0f, c.z + 1.0f}};
+    int count = 0;
+    game.scene.em.QueryCandidates(bounds, [&](Entity *e)
+    {
+        if (e == target)
+            ++count;
+    });
+    return count;
+}
+}
+
+TEST_CASE(SpatialGridForgetsKilledEnemy)
+{
+    GameFixture game;
+    ChargingEnemy *enemy = game.SpawnEnemy<ChargingEnemy>(5.0f, 0.0f);
+    game.Step();
+    CHECK(CountCandidates(game, enemy) == 1);
+
+    game.scene.em.RemoveEnemy(enemy);
+    int count = 0;
+    game.scene.em.QueryCandidates({{-100.0f, -100.0f, -100.0f}, {100.0f, 100.0f, 100.0f}}, [&](Entity *e)
+    {
+        if (e == enemy)
+            ++count;
+    });
+    CHECK(count == 0);
+}
+
+TEST_CASE(SpatialGridReportsRespawnAtSameAddressOnce)
+{
+    GameFixture game;
+    ChargingEnemy *dead = game.SpawnEnemy<ChargingEnemy>(5.0f, 0.0f);
+    game.Step();
+    game.scene.em.RemoveEnemy(dead);
+
+    // The pool hands the freed block straight back.
+    ChargingEnemy *spawned = game.SpawnEnemy<ChargingEnemy>(5.0f, 0.0f);
+    if (!CHECK(spawned == dead))
+        return;
+    CHECK(CountCandidates(game, spawned) == 1);
+
+    std::vector<Enemy *> hits;
+    game.scene.em.QuerySphere(spawned->pos(), 2.0f, hits);
+    CHECK(std::count(hits.begin(), hits.end(), spawned) == 1);
+
+    game.Step();
+    CHECK(CountCandidates(game, spawned) == 1);
+}
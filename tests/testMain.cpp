@@ -0,0 +1,67 @@
+#include "check.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+int failures = 0;
+}
+
+namespace check
+{
+std::vector<TestCase> &Registry()
+{
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+bool Report(bool passed, const char *expression, const char *file, int line)
+{
+    if (!passed)
+    {
+        ++failures;
+        printf("    %s:%d: CHECK(%s) failed\n", file, line, expression);
+    }
+    return passed;
+}
+
+int Failures()
+{
+    return failures;
+}
+
+void ResetFailures()
+{
+    failures = 0;
+}
+}
+
+// Runs every registered test, or only those whose name contains argv[1]
+int main(int argc, char **argv)
+{
+    const char *filter = argc > 1 ? argv[1] : nullptr;
+    int ran = 0;
+    int failed = 0;
+
+    for (const check::TestCase &test : check::Registry())
+    {
+        if (filter && !strstr(test.name, filter))
+            continue;
+
+        check::ResetFailures();
+        test.run();
+        ++ran;
+        if (check::Failures() > 0)
+        {
+            ++failed;
+            printf("[FAIL] %s (%d failed checks)\n", test.name, check::Failures());
+        }
+        else
+        {
+            printf("[ OK ] %s\n", test.name);
+        }
+    }
+
+    printf("%d of %d tests passed\n", ran - failed, ran);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include "check.hpp"
+#include "tileCombo.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+// ClassifyTileCombo() looks combos up in a table generated at compile time.
+// It must agree with the branching classifier that AttackManager used
+// before, kept here as the reference, for every slot of one to four tiles.
+
+namespace
+{
+bool IsDot(TileType tile) { return tile >= TileType::DOT_1 && tile <= TileType::DOT_9; }
+bool IsBamboo(TileType tile) { return tile >= TileType::BAMBOO_1 && tile <= TileType::BAMBOO_9; }
+bool IsCharacter(TileType tile) { return tile >= TileType::CHARACTER_1 && tile <= TileType::CHARACTER_9; }
+int BambooValue(TileType tile) { return static_cast<int>(tile) - static_cast<int>(TileType::BAMBOO_1) + 1; }
+int CharacterValue(TileType tile) { return static_cast<int>(tile) - static_cast<int>(TileType::CHARACTER_1) + 1; }
+
+// The former AttackManager::classifyAttackType(), returning TileCombo instead of its name
+TileCombo LegacyClassify(const std::vector<SlotTileEntry> &tiles)
+{
+    if (tiles.empty())
+        return TileCombo::None;
+
+    if (tiles.size() >= 3 && tiles[0].isValid() && tiles[1].isValid() && tiles[2].isValid())
+    {
+        TileType a = tiles[0].tile, b = tiles[1].tile, c = tiles[2].tile;
+        bool sameTile = a == b && b == c;
+
+        if (IsDot(a) && IsDot(b) && IsDot(c))
+        {
+            if (sameTile && a == TileType::DOT_1)
+                return TileCombo::GravityWell;
+            if (sameTile && a == TileType::DOT_2)
+                return TileCombo::OrbitalShield;
+            std::array<TileType, 3> dots = {a, b, c};
+            std::sort(dots.begin(), dots.end());
+            if (dots[0] == TileType::DOT_1 && dots[1] == TileType::DOT_2 && dots[2] == TileType::DOT_3)
+                return TileCombo::ChainLightning;
+        }
+
+        if (IsBamboo(a) && IsBamboo(b) && IsBamboo(c))
+        {
+            if (sameTile && BambooValue(a) == 1)
+                return TileCombo::BambooTriple;
+            if (sameTile && BambooValue(a) == 2)
+                return TileCombo::BambooBomb;
+            std::array<int, 3> values = {BambooValue(a), BambooValue(b), BambooValue(c)};
+            std::sort(values.begin(), values.end());
+            if (values[0] == 1 && values[1] == 2 && values[2] == 3)
+                return TileCombo::FanShot;
+        }
+
+        if (IsCharacter(a) && IsCharacter(b) && IsCharacter(c))
+        {
+            std::array<int, 3> values = {CharacterValue(a), CharacterValue(b), CharacterValue(c)};
+            if (values[0] == 2 && values[1] == 2 && values[2] == 2)
+                return TileCombo::SeismicSlam;
+            if (values[0] == values[1] && values[1] == values[2])
+                return TileCombo::Melee;
+            std::sort(values.begin(), values.end());
+            if (values[0] + 1 == values[1] && values[1] + 1 == values[2])
+                return TileCombo::Dash;
+        }
+    }
+
+    return tiles.front().isValid() ? TileCombo::DefaultThrow : TileCombo::None;
+}
+
+SlotTileEntry Entry(int tile, bool valid)
+{
+    SlotTileEntry entry;
+    entry.tile = static_cast<TileType>(tile);
+    entry.handIndex = valid ? 0 : -1;
+    return entry;
+}
+
+bool Agrees(const std::vector<SlotTileEntry> &tiles)
+{
+    TileCombo expected = LegacyClassify(tiles);
+    TileCombo actual = ClassifyTileCombo(tiles);
+    if (actual == expected)
+        return true;
+
+    printf("    tiles");
+    for (const SlotTileEntry &entry : tiles)
+        printf(" %d%s", static_cast<int>(entry.tile), entry.isValid() ? "" : "(invalid)");
+    printf(": table says %s, branches say %s\n", TileComboName(actual), TileComboName(expected));
+    return false;
+}
+}
+
+TEST_CASE(TileComboTableMatchesBranchingClassifier)
+{
+    const int tileTypes = static_cast<int>(TileType::TILE_COUNT);
+    int combos = 0;
+
+    // Every ordered triple of tile types, including non-playable ones, with every validity pattern
+    for (int a = 0; a < tileTypes; ++a)
+    {
+        for (int b = 0; b < tileTypes; ++b)
+        {
+            for (int c = 0; c < tileTypes; ++c)
+            {
+                for (int valid = 0; valid < 8; ++valid)
+                {
+                    std::vector<SlotTileEntry> tiles = {Entry(a, valid & 1), Entry(b, valid & 2), Entry(c, valid & 4)};
+                    if (!CHECK(Agrees(tiles)))
+                        return;
+                    combos += IsSkillCombo(ClassifyTileCombo(tiles));
+                }
+            }
+        }
+    }
+    CHECK(combos > 0);
+
+    // Slots shorter than a combo, and a fourth tile that must not matter
+    for (int a = 0; a < tileTypes; ++a)
+    {
+        for (int b = 0; b < tileTypes; ++b)
+        {
+            if (!CHECK(Agrees({Entry(a, true)})) || !CHECK(Agrees({Entry(a, false)})) ||
+                !CHECK(Agrees({Entry(a, true), Entry(b, true)})) ||
+                !CHECK(Agrees({Entry(a, true), Entry(b, true), Entry(a, true), Entry(b, false)})))
+                return;
+        }
+    }
+    CHECK(Agrees({}));
+}